@@ -0,0 +1,1533 @@
+/**
+ * @file s21_bench.c
+ * @brief Benchmark suite comparing the s21_string library with the C library.
+ *
+ * Every benchmark runs the same operation through the s21_ function and its
+ * C library counterpart. An operation works on 'size' bytes:
+ * - string functions scan, copy or compare a buffer of that size;
+ * - s21_sprintf families write conversions until 'size' bytes are produced;
+ * - s21_sscanf conversions read tokens until 'size' bytes are consumed, the
+ * input is split into lines of BENCH_LINE bytes like a file read line by line;
+ * the batch benchmark reads newline-separated records instead.
+ * Sizes grow from 8 B to 1 MB, see bench_sizes.
+ *
+ * The iteration count is calibrated like Google Benchmark does: the operation
+ * is repeated until a run lasts at least --min-time seconds. That run and
+ * --repetitions - 1 more of the same length are timed, alternating with the
+ * runs of the libc counterpart, and the fastest one is reported as ns/op,
+ * bytes/op and allocations/op: preemption and cache misses only ever slow a
+ * run down, and both implementations are sampled over the same stretch of
+ * time.
+ *
+ * Usage:
+ *   s21_bench [--json=FILE] [--csv=FILE] [--min-time=SECONDS]
+ *             [--repetitions=N] [--passes=N] [--filter=TEXT]
+ *             [--baseline=FILE] [--threshold=PERCENT] [--relative]
+ * With --passes, the whole suite is run that many times, at most
+ * BENCH_MAX_PASSES, and every benchmark reports the median of its passes,
+ * which keeps a stretch of noise from skewing a baseline.
+ * A human-readable table goes to stdout, the JSON and CSV files hold every
+ * measurement for tracking over time.
+ *
+ * With --baseline, the s21 measurements are compared with the ones of a JSON
+ * file written by an earlier --json run. A benchmark slower than its baseline
+ * by more than --threshold percent (BENCH_THRESHOLD by default, twice that
+ * below BENCH_NOISE_FLOOR ns/op) is measured again, twice as long, in up to
+ * BENCH_RETRIES rounds after the run to rule out noise; the run exits with
+ * status 2 if it stays slower. Benchmarks missing from the baseline are not
+ * checked. With --relative, a benchmark with a libc counterpart is compared by
+ * its s21/libc ratio instead, which keeps a baseline valid on another machine
+ * and cancels most of the noise of a shared one.
+ *
+ * @note Allocations are counted when the binary is linked with
+ * -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc and built with
+ * -DS21_BENCH_ALLOCS, as `make bench` does on Linux. Otherwise they are
+ * reported as -1.
+ */
+#define _GNU_SOURCE
+
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "s21_simd.h"
+#include "s21_sprintf.h"
+#include "s21_sscanf.h"
+
+#define BENCH_MAX_SIZE (1 << 20)
+#define BENCH_SLACK 4096  // room for the last conversion past 'size'
+#define BENCH_MAX_RESULTS 2048
+#define BENCH_MIN_TIME 0.05
+#define BENCH_MAX_ITERATIONS 1000000000LL
+#define BENCH_LINE 128
+#define BENCH_BATCH_ROWS 128  // rows per batch call, within BENCH_SLACK
+#define BENCH_REPETITIONS 5      // timed runs per measurement, the fastest wins
+#define BENCH_THRESHOLD 25.0     // percent of slowdown the gate accepts
+#define BENCH_NOISE_FLOOR 100.0  // ns/op below which the threshold doubles
+#define BENCH_RETRIES 3          // rounds of measurements of the suspects
+#define BENCH_NAME_SIZE 96
+#define BENCH_MAX_PASSES 9
+
+typedef enum bench_arg {
+  BENCH_NONE,
+  BENCH_INT,
+  BENCH_UNSIGNED,
+  BENCH_LONG,
+  BENCH_DOUBLE,
+  BENCH_FLOAT,
+  BENCH_STRING,
+  BENCH_CHAR,
+  BENCH_POINTER
+} bench_arg_type;
+
+typedef struct bench_state {
+  s21_size_t size;       // bytes one operation works on
+  long long iterations;  // operations to run
+  int libc;              // 1 to run the C library counterpart
+  const char *format;    // format of the sprintf and sscanf families
+  const char *token;     // one input token of the sscanf families
+  bench_arg_type arg;    // argument type of the format
+  s21_size_t bytes;      // bytes processed by the last operation
+} bench_state_type;
+
+typedef struct bench_case {
+  const char *name;
+  const char *family;  // "string", "sprintf" or "sscanf"
+  void (*setup)(bench_state_type *state);
+  void (*run)(bench_state_type *state);
+  int sized;  // 1 to run for every size, 0 for one fixed-size operation
+  int libc;   // 1 if the C library has a counterpart
+  const char *format;
+  const char *token;
+  bench_arg_type arg;
+} bench_case_type;
+
+typedef struct bench_baseline {
+  char name[BENCH_NAME_SIZE];  // "impl/family/function/size" as in the JSON
+  double ns_per_op;
+} bench_baseline_type;
+
+typedef struct bench_result {
+  const bench_case_type *bench;
+  const char *name;
+  const char *family;
+  const char *impl;
+  s21_size_t size;      // 0 for a fixed-size benchmark
+  s21_size_t run_size;  // size passed to the run
+  long long iterations;
+  double ns_per_op;
+  double bytes_per_op;
+  double allocs_per_op;
+  double samples[BENCH_MAX_PASSES];  // ns/op of every pass
+} bench_result_type;
+
+typedef struct bench_check {
+  const bench_result_type *result;  // the s21 measurement
+  const bench_result_type *libc;    // its counterpart with --relative
+  double baseline;                  // ns/op, or s21/libc with a counterpart
+  double limit;                     // the slowest accepted 'current'
+  double current;                   // the best ns/op or ratio measured
+} bench_check_type;
+
+static char *bench_input;
+static char *bench_other;
+static char *bench_output;
+static const s21_size_t bench_sizes[] = {8,     64,     512,    4096,
+                                         32768, 262144, 1 << 20};
+static volatile uintptr_t bench_sink;  // keeps results alive
+static long long bench_allocs;
+static int bench_repetitions = BENCH_REPETITIONS;
+static bench_result_type bench_results[BENCH_MAX_RESULTS];
+static int bench_results_count;
+static int bench_passes = 1;
+static int bench_pass;    // the pass being run
+static int bench_cursor;  // the next result of a pass after the first
+static bench_baseline_type bench_baselines[BENCH_MAX_RESULTS];
+static int bench_baselines_count;
+static bench_check_type bench_checks[BENCH_MAX_RESULTS];
+
+#ifdef S21_BENCH_ALLOCS
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+/**
+ * @brief Counting wrapper of malloc.
+ *
+ * @param size Requested size.
+ * @return The allocated block.
+ */
+void *__wrap_malloc(size_t size) {
+  bench_allocs++;
+  return __real_malloc(size);
+}
+/**
+ * @brief Counting wrapper of calloc.
+ *
+ * @param count Number of elements.
+ * @param size Size of an element.
+ * @return The allocated block.
+ */
+void *__wrap_calloc(size_t count, size_t size) {
+  bench_allocs++;
+  return __real_calloc(count, size);
+}
+/**
+ * @brief Counting wrapper of realloc.
+ *
+ * @param ptr Block to resize.
+ * @param size Requested size.
+ * @return The resized block.
+ */
+void *__wrap_realloc(void *ptr, size_t size) {
+  bench_allocs++;
+  return __real_realloc(ptr, size);
+}
+#endif
+
+// __Setup__
+/**
+ * @brief Fills the input with 'size' lowercase letters and copies it.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void setup_text(bench_state_type *state) {
+  for (s21_size_t i = 0; i < state->size; i++) {
+    bench_input[i] = (char)('a' + i % 26);
+  }
+  bench_input[state->size] = '\0';
+  memcpy(bench_other, bench_input, state->size + 1);
+  bench_output[0] = '\0';
+}
+/**
+ * @brief Fills the input with short words separated by spaces and commas.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void setup_words(bench_state_type *state) {
+  static const char words[] = "lorem ipsum,dolor sit,amet ";
+  for (s21_size_t i = 0; i < state->size; i++) {
+    bench_input[i] = words[i % (sizeof(words) - 1)];
+  }
+  bench_input[state->size] = '\0';
+}
+/**
+ * @brief Fills the input with lines of sscanf tokens up to 'size' bytes.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void setup_tokens(bench_state_type *state) {
+  s21_size_t len = strlen(state->token);
+  s21_size_t pos = 0;
+  s21_size_t line = 0;
+  while (pos < state->size) {
+    if (line + len >= BENCH_LINE) {
+      bench_input[pos++] = '\0';
+      line = 0;
+    }
+    memcpy(bench_input + pos, state->token, len);
+    pos += len;
+    line += len;
+  }
+  bench_input[pos] = '\0';
+}
+/**
+ * @brief Fills the input with newline-separated records up to 'size' bytes.
+ *
+ * @param state Pointer to the benchmark state, 'token' is one record.
+ */
+static void setup_records(bench_state_type *state) {
+  s21_size_t len = strlen(state->token);
+  s21_size_t pos = 0;
+  while (pos < state->size) {
+    memcpy(bench_input + pos, state->token, len);
+    pos += len;
+  }
+  bench_input[pos] = '\0';
+}
+// __String functions__
+/**
+ * @brief Benchmarks memcpy.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_memcpy(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    bench_sink += (uintptr_t)(
+        state->libc ? memcpy(bench_output, bench_input, state->size)
+                    : s21_memcpy(bench_output, bench_input, state->size));
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks memmove of the output onto itself, one byte higher.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_memmove(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    bench_sink += (uintptr_t)(
+        state->libc ? memmove(bench_output + 1, bench_output, state->size)
+                    : s21_memmove(bench_output + 1, bench_output, state->size));
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks memset.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_memset(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    bench_sink += (uintptr_t)(state->libc
+                                  ? memset(bench_output, 'x', state->size)
+                                  : s21_memset(bench_output, 'x', state->size));
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks strcpy.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_strcpy(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    bench_sink += (uintptr_t)(state->libc
+                                  ? strcpy(bench_output, bench_input)
+                                  : s21_strcpy(bench_output, bench_input));
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks strncpy.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_strncpy(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    bench_sink += (uintptr_t)(
+        state->libc ? strncpy(bench_output, bench_input, state->size)
+                    : s21_strncpy(bench_output, bench_input, state->size));
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks memchr for a byte that is not in the buffer.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_memchr(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    bench_sink += (uintptr_t)(state->libc
+                                  ? memchr(bench_input, '#', state->size)
+                                  : s21_memchr(bench_input, '#', state->size));
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks strchr for a character that is not in the string.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_strchr(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    bench_sink += (uintptr_t)(state->libc ? strchr(bench_input, '#')
+                                          : s21_strchr(bench_input, '#'));
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks strrchr for a character that is not in the string.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_strrchr(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    bench_sink += (uintptr_t)(state->libc ? strrchr(bench_input, '#')
+                                          : s21_strrchr(bench_input, '#'));
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks strpbrk for characters that are not in the string.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_strpbrk(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    bench_sink += (uintptr_t)(state->libc ? strpbrk(bench_input, "#$%")
+                                          : s21_strpbrk(bench_input, "#$%"));
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks strstr with a short needle that is not in the string.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_strstr(bench_state_type *state) {
+  const char *needle = "mnopq#";
+  for (long long i = 0; i < state->iterations; i++) {
+    bench_sink += (uintptr_t)(state->libc ? strstr(bench_input, needle)
+                                          : s21_strstr(bench_input, needle));
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks strstr with a long needle that is not in the string.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_strstr_long(bench_state_type *state) {
+  const char *needle = "abcdefghijklmnopqrstuvwxyzabcdefghijklm#";
+  for (long long i = 0; i < state->iterations; i++) {
+    bench_sink += (uintptr_t)(state->libc ? strstr(bench_input, needle)
+                                          : s21_strstr(bench_input, needle));
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks memmem with a short needle that is not in the buffer.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_memmem(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    bench_sink += (uintptr_t)(
+        state->libc ? memmem(bench_input, state->size, "mnopq#", 6)
+                    : s21_memmem(bench_input, state->size, "mnopq#", 6));
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks s21_to_upper against a toupper loop into a new buffer.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_to_upper(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    char *result = s21_NULL;
+    if (state->libc) {
+      result = malloc(state->size + 1);
+      for (s21_size_t j = 0; j <= state->size; j++) {
+        char c = bench_input[j];
+        result[j] = (char)(c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c);
+      }
+    } else {
+      result = s21_to_upper(bench_input);
+    }
+    bench_sink += (uintptr_t)result[0];
+    free(result);
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks s21_to_lower against a tolower loop into a new buffer.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_to_lower(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    char *result = s21_NULL;
+    if (state->libc) {
+      result = malloc(state->size + 1);
+      for (s21_size_t j = 0; j <= state->size; j++) {
+        char c = bench_input[j];
+        result[j] = (char)(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+      }
+    } else {
+      result = s21_to_lower(bench_input);
+    }
+    bench_sink += (uintptr_t)result[0];
+    free(result);
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks s21_to_upper_into against a toupper loop into a caller
+ * buffer, the allocation-free variant.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_to_upper_into(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    if (state->libc) {
+      for (s21_size_t j = 0; j < state->size; j++) {
+        char c = bench_input[j];
+        bench_output[j] = (char)(c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c);
+      }
+    } else {
+      s21_to_upper_into(bench_output, bench_input, state->size);
+    }
+    bench_sink += (uintptr_t)bench_output[0];
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks s21_insert against two memcpy calls into a new buffer.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_insert(bench_state_type *state) {
+  s21_size_t start = state->size / 2;
+  for (long long i = 0; i < state->iterations; i++) {
+    char *result = s21_NULL;
+    if (state->libc) {
+      result = malloc(state->size + 7);
+      memcpy(result, bench_input, start);
+      memcpy(result + start, "insert", 6);
+      memcpy(result + start + 6, bench_input + start, state->size - start + 1);
+    } else {
+      result = s21_insert(bench_input, "insert", start);
+    }
+    bench_sink += (uintptr_t)result;
+    free(result);
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks s21_trim of a string with a trimmed border.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_trim(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    char *result = s21_trim(bench_input, "abcxyz");
+    bench_sink += (uintptr_t)result;
+    free(result);
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks a trim, lowercase and insert chain in a s21_strbuf against
+ * the same chain with a new C library buffer per step.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_strbuf_chain(bench_state_type *state) {
+  s21_size_t start = state->size / 2;
+  for (long long i = 0; i < state->iterations; i++) {
+    if (state->libc) {
+      s21_size_t length = strlen(bench_input);
+      char *trimmed = malloc(length + 1);
+      memcpy(trimmed, bench_input, length + 1);
+      char *lower = malloc(length + 1);
+      for (s21_size_t j = 0; j <= length; j++) {
+        char c = trimmed[j];
+        lower[j] = (char)(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+      }
+      char *result = malloc(length + 7);
+      memcpy(result, lower, start);
+      memcpy(result + start, "insert", 6);
+      memcpy(result + start + 6, lower + start, length - start + 1);
+      bench_sink += (uintptr_t)result[0];
+      free(trimmed);
+      free(lower);
+      free(result);
+    } else {
+      strbuf_type buf;
+      s21_strbuf_init(&buf);
+      s21_strbuf_append(&buf, bench_input, state->size);
+      s21_strbuf_trim(&buf, "\t ");
+      s21_strbuf_to_lower(&buf);
+      s21_strbuf_insert(&buf, start < buf.length ? start : buf.length,
+                        "insert", 6);
+      bench_sink += (uintptr_t)s21_strbuf_data(&buf)[0];
+      s21_strbuf_free(&buf);
+    }
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks strcat onto an empty string.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_strcat(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    bench_output[0] = '\0';
+    bench_sink += (uintptr_t)(state->libc
+                                  ? strcat(bench_output, bench_input)
+                                  : s21_strcat(bench_output, bench_input));
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks strncat onto an empty string.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_strncat(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    bench_output[0] = '\0';
+    bench_sink += (uintptr_t)(
+        state->libc ? strncat(bench_output, bench_input, state->size)
+                    : s21_strncat(bench_output, bench_input, state->size));
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks strtok over a copy of a string of words.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_strtok(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    memcpy(bench_other, bench_input, state->size + 1);
+    char *token = state->libc ? strtok(bench_other, " ,")
+                              : s21_strtok(bench_other, " ,");
+    while (token) {
+      bench_sink += (uintptr_t)token;
+      token = state->libc ? strtok(s21_NULL, " ,") : s21_strtok(s21_NULL, " ,");
+    }
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks strtok_r over a copy of a string of words.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_strtok_r(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    char *save = s21_NULL;
+    memcpy(bench_other, bench_input, state->size + 1);
+    char *token = state->libc ? strtok_r(bench_other, " ,", &save)
+                              : s21_strtok_r(bench_other, " ,", &save);
+    while (token) {
+      bench_sink += (uintptr_t)token;
+      token = state->libc ? strtok_r(s21_NULL, " ,", &save)
+                          : s21_strtok_r(s21_NULL, " ,", &save);
+    }
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks strerror for a known and an unknown error number.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_strerror(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    int errnum = i % 2 ? EINVAL : -1;
+    bench_sink += (uintptr_t)(state->libc ? strerror(errnum)
+                                          : s21_strerror(errnum));
+  }
+  state->bytes = 0;
+}
+/**
+ * @brief Benchmarks strerror_r into a caller buffer.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_strerror_r(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    int errnum = i % 2 ? EINVAL : -1;
+    if (state->libc) {
+      bench_sink += (uintptr_t)strerror_r(errnum, bench_output, 64);
+    } else {
+      bench_sink += (uintptr_t)s21_strerror_r(errnum, bench_output, 64);
+    }
+  }
+  state->bytes = 0;
+}
+/**
+ * @brief Benchmarks memcmp of two equal buffers.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_memcmp(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    bench_sink += (uintptr_t)(
+        state->libc ? memcmp(bench_input, bench_other, state->size)
+                    : s21_memcmp(bench_input, bench_other, state->size));
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks strcmp of two equal strings.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_strcmp(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    bench_sink += (uintptr_t)(state->libc
+                                  ? strcmp(bench_input, bench_other)
+                                  : s21_strcmp(bench_input, bench_other));
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks strncmp of two equal strings.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_strncmp(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    bench_sink += (uintptr_t)(
+        state->libc ? strncmp(bench_input, bench_other, state->size)
+                    : s21_strncmp(bench_input, bench_other, state->size));
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks strlen.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_strlen(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    bench_sink += state->libc ? strlen(bench_input) : s21_strlen(bench_input);
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks strnlen with a limit past the end of the string.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_strnlen(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    bench_sink += state->libc ? strnlen(bench_input, state->size + 1)
+                              : s21_strnlen(bench_input, state->size + 1);
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks strspn with a set that accepts the whole string.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_strspn(bench_state_type *state) {
+  const char *set = "abcdefghijklmnopqrstuvwxyz";
+  for (long long i = 0; i < state->iterations; i++) {
+    bench_sink += state->libc ? strspn(bench_input, set)
+                              : s21_strspn(bench_input, set);
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks strcspn with a set that rejects nothing in the string.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_strcspn(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    bench_sink += state->libc ? strcspn(bench_input, "#$%&")
+                              : s21_strcspn(bench_input, "#$%&");
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks s21_dtoa against the round trip "%.17g" of snprintf.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_dtoa(bench_state_type *state) {
+  double value = 0.1;
+  for (long long i = 0; i < state->iterations; i++) {
+    value = value * 1.0001 + 1e-9;
+    bench_sink += (uintptr_t)(state->libc
+                                  ? snprintf(bench_output, 32, "%.17g", value)
+                                  : s21_dtoa(bench_output, value));
+  }
+  state->bytes = strlen(bench_output);
+}
+// __Formatting__
+/**
+ * @brief Runs one sprintf conversion of the benchmarked family.
+ *
+ * @param state Pointer to the benchmark state.
+ * @param out Destination buffer.
+ * @param i Index of the conversion, varies the argument.
+ * @return Number of characters written.
+ */
+static int format_one(const bench_state_type *state, char *out, long long i) {
+  int n = 0;
+  int (*print)(char *, const char *, ...) = state->libc ? sprintf : s21_sprintf;
+  if (state->arg == BENCH_INT) {
+    n = print(out, state->format, (int)(i * 7919 - 500000));
+  } else if (state->arg == BENCH_UNSIGNED) {
+    n = print(out, state->format, (unsigned)(i * 2654435761U));
+  } else if (state->arg == BENCH_LONG) {
+    n = print(out, state->format, (long)(i * 1000000007LL));
+  } else if (state->arg == BENCH_DOUBLE) {
+    n = print(out, state->format, (double)i * 1.37 + 0.001);
+  } else if (state->arg == BENCH_CHAR) {
+    n = print(out, state->format, 'a' + (int)(i % 26));
+  } else if (state->arg == BENCH_POINTER) {
+    n = print(out, state->format, (void *)(uintptr_t)(i * 4096 + 0x7ff000));
+  } else if (state->arg == BENCH_STRING) {
+    n = print(out, state->format, "word");
+  } else {
+    n = print(out, state->format);
+  }
+  return n;
+}
+/**
+ * @brief Benchmarks an sprintf family: conversions until 'size' bytes.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_sprintf(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    s21_size_t pos = 0;
+    for (long long j = 0; pos < state->size; j++) {
+      pos += (s21_size_t)format_one(state, bench_output + pos, i + j);
+    }
+    state->bytes = pos;
+  }
+  bench_sink += (uintptr_t)bench_output[0];
+}
+/**
+ * @brief Benchmarks one "%s" conversion of the whole input.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_sprintf_string(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    bench_sink += (uintptr_t)(
+        state->libc ? sprintf(bench_output, "%s", bench_input)
+                    : s21_sprintf(bench_output, "%s", bench_input));
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks a compiled plan against sprintf with the same format.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_sprintf_plan(bench_state_type *state) {
+  plan_type plan;
+  s21_compile_format(&plan, state->format);
+  for (long long i = 0; i < state->iterations; i++) {
+    s21_size_t pos = 0;
+    for (long long j = 0; pos < state->size; j++) {
+      int value = (int)((i + j) * 7919 - 500000);
+      pos += (s21_size_t)(
+          state->libc ? sprintf(bench_output + pos, state->format, value, value)
+                      : s21_sprintf_plan(bench_output + pos, &plan, value,
+                                         value));
+    }
+    state->bytes = pos;
+  }
+  bench_sink += (uintptr_t)bench_output[0];
+}
+/**
+ * @brief Benchmarks s21_sprintf_batch against sprintf called once per row.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_sprintf_batch(bench_state_type *state) {
+  int ids[BENCH_BATCH_ROWS];
+  double values[BENCH_BATCH_ROWS];
+  s21_size_t offsets[BENCH_BATCH_ROWS + 1];
+  for (int j = 0; j < BENCH_BATCH_ROWS; j++) {
+    ids[j] = j * 7919 - 500000;
+    values[j] = j / 8.0;
+  }
+  for (long long i = 0; i < state->iterations; i++) {
+    s21_size_t pos = 0;
+    while (pos < state->size) {
+      if (state->libc) {
+        for (int j = 0; j < BENCH_BATCH_ROWS; j++) {
+          pos += (s21_size_t)sprintf(bench_output + pos, state->format,
+                                     ids[j], values[j]);
+        }
+      } else {
+        pos += (s21_size_t)s21_sprintf_batch(
+            bench_output + pos, (s21_size_t)-1, state->format,
+            BENCH_BATCH_ROWS, offsets, ids, values);
+      }
+    }
+    state->bytes = pos;
+  }
+  bench_sink += (uintptr_t)bench_output[0];
+}
+/**
+ * @brief Benchmarks snprintf with a buffer smaller than the output.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_snprintf(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    bench_sink += (uintptr_t)(
+        state->libc
+            ? snprintf(bench_output, state->size / 2 + 1, "%s", bench_input)
+            : s21_snprintf(bench_output, state->size / 2 + 1, "%s",
+                           bench_input));
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks asprintf of the whole input.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_asprintf(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    char *out = s21_NULL;
+    if (state->libc) {
+      bench_sink += (uintptr_t)asprintf(&out, "%s|%d", bench_input, (int)i);
+    } else {
+      bench_sink += (uintptr_t)s21_asprintf(&out, "%s|%d", bench_input, (int)i);
+    }
+    free(out);
+  }
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks fprintf of the whole input to /dev/null.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_fprintf(bench_state_type *state) {
+  FILE *stream = fopen("/dev/null", "w");
+  for (long long i = 0; stream && i < state->iterations; i++) {
+    bench_sink += (uintptr_t)(
+        state->libc ? fprintf(stream, "%s|%d", bench_input, (int)i)
+                    : s21_fprintf(stream, "%s|%d", bench_input, (int)i));
+  }
+  if (stream) fclose(stream);
+  state->bytes = state->size;
+}
+/**
+ * @brief Benchmarks dprintf of the whole input to /dev/null.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_dprintf(bench_state_type *state) {
+  FILE *stream = fopen("/dev/null", "w");
+  int fd = stream ? fileno(stream) : -1;
+  for (long long i = 0; stream && i < state->iterations; i++) {
+    bench_sink += (uintptr_t)(
+        state->libc ? dprintf(fd, "%s|%d", bench_input, (int)i)
+                    : s21_dprintf(fd, "%s|%d", bench_input, (int)i));
+  }
+  if (stream) fclose(stream);
+  state->bytes = state->size;
+}
+// __Scanning__
+/**
+ * @brief Runs one sscanf conversion of the benchmarked family.
+ *
+ * @param state Pointer to the benchmark state.
+ * @param in Input position.
+ * @param consumed Receives the characters consumed through %n.
+ * @return The sscanf result.
+ */
+static int scan_one(const bench_state_type *state, const char *in,
+                    int *consumed) {
+  int (*scan)(const char *, const char *, ...) =
+      state->libc ? sscanf : s21_sscanf;
+  int n = 0;
+  int int_value = 0;
+  unsigned unsigned_value = 0;
+  long long_value = 0;
+  float float_value = 0;
+  char char_value = 0;
+  char string_value[64];
+  void *pointer_value = s21_NULL;
+  if (state->arg == BENCH_INT) {
+    n = scan(in, state->format, &int_value, consumed);
+  } else if (state->arg == BENCH_UNSIGNED) {
+    n = scan(in, state->format, &unsigned_value, consumed);
+  } else if (state->arg == BENCH_LONG) {
+    n = scan(in, state->format, &long_value, consumed);
+  } else if (state->arg == BENCH_FLOAT) {
+    n = scan(in, state->format, &float_value, consumed);
+  } else if (state->arg == BENCH_CHAR) {
+    n = scan(in, state->format, &char_value, consumed);
+  } else if (state->arg == BENCH_POINTER) {
+    n = scan(in, state->format, &pointer_value, consumed);
+  } else {
+    n = scan(in, state->format, string_value, consumed);
+  }
+  bench_sink += (uintptr_t)(int_value + unsigned_value + long_value +
+                            (long)float_value + char_value) +
+                (uintptr_t)pointer_value;
+  return n;
+}
+/**
+ * @brief Benchmarks an sscanf family: conversions until 'size' bytes are
+ * consumed, moving to the next line when a line is exhausted.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_sscanf(bench_state_type *state) {
+  for (long long i = 0; i < state->iterations; i++) {
+    s21_size_t pos = 0;
+    while (pos < state->size) {
+      int consumed = 0;
+      scan_one(state, bench_input + pos, &consumed);
+      if (consumed > 0) {
+        pos += (s21_size_t)consumed;
+      } else {
+        pos += strlen(bench_input + pos) + 1;
+      }
+    }
+    state->bytes = pos;
+  }
+}
+/**
+ * @brief Benchmarks a compiled scan plan against sscanf with the same format.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_sscanf_plan(bench_state_type *state) {
+  scan_plan_type plan;
+  s21_compile_scan_format(&plan, state->format);
+  for (long long i = 0; i < state->iterations; i++) {
+    s21_size_t pos = 0;
+    while (pos < state->size) {
+      int value = 0;
+      int consumed = 0;
+      if (state->libc) {
+        sscanf(bench_input + pos, state->format, &value, &consumed);
+      } else {
+        s21_sscanf_plan(bench_input + pos, &plan, &value, &consumed);
+      }
+      bench_sink += (uintptr_t)value;
+      if (consumed > 0) {
+        pos += (s21_size_t)consumed;
+      } else {
+        pos += strlen(bench_input + pos) + 1;
+      }
+    }
+    state->bytes = pos;
+  }
+}
+/**
+ * @brief Benchmarks s21_sscanf_batch against sscanf called once per record.
+ *
+ * @param state Pointer to the benchmark state.
+ */
+static void run_sscanf_batch(bench_state_type *state) {
+  int ids[BENCH_BATCH_ROWS];
+  double values[BENCH_BATCH_ROWS];
+  char names[BENCH_BATCH_ROWS][16];
+  int status[BENCH_BATCH_ROWS];
+  scan_column_type columns[] = {
+      {ids, 0}, {values, 0}, {names, sizeof(names[0])}};
+  for (long long i = 0; i < state->iterations; i++) {
+    const char *in = bench_input;
+    while (*in) {
+      if (state->libc) {
+        sscanf(in, state->format, &ids[0], &values[0], names[0]);
+        in = strchr(in, '\n') + 1;
+      } else {
+        s21_sscanf_batch(in, state->format, columns, status, BENCH_BATCH_ROWS,
+                         &in);
+      }
+      bench_sink += (uintptr_t)ids[0];
+    }
+    state->bytes = (s21_size_t)(in - bench_input);
+  }
+}
+
+static const bench_case_type bench_cases[] = {
+    {"memcpy", "string", setup_text, run_memcpy, 1, 1, 0, 0, BENCH_NONE},
+    {"memmove", "string", setup_text, run_memmove, 1, 1, 0, 0, BENCH_NONE},
+    {"memset", "string", setup_text, run_memset, 1, 1, 0, 0, BENCH_NONE},
+    {"strcpy", "string", setup_text, run_strcpy, 1, 1, 0, 0, BENCH_NONE},
+    {"strncpy", "string", setup_text, run_strncpy, 1, 1, 0, 0, BENCH_NONE},
+    {"memchr", "string", setup_text, run_memchr, 1, 1, 0, 0, BENCH_NONE},
+    {"strchr", "string", setup_text, run_strchr, 1, 1, 0, 0, BENCH_NONE},
+    {"strrchr", "string", setup_text, run_strrchr, 1, 1, 0, 0, BENCH_NONE},
+    {"strpbrk", "string", setup_text, run_strpbrk, 1, 1, 0, 0, BENCH_NONE},
+    {"strstr", "string", setup_text, run_strstr, 1, 1, 0, 0, BENCH_NONE},
+    {"strstr_long", "string", setup_text, run_strstr_long, 1, 1, 0, 0,
+     BENCH_NONE},
+    {"memmem", "string", setup_text, run_memmem, 1, 1, 0, 0, BENCH_NONE},
+    {"to_upper", "string", setup_text, run_to_upper, 1, 1, 0, 0, BENCH_NONE},
+    {"to_lower", "string", setup_text, run_to_lower, 1, 1, 0, 0, BENCH_NONE},
+    {"to_upper_into", "string", setup_text, run_to_upper_into, 1, 1, 0, 0,
+     BENCH_NONE},
+    {"insert", "string", setup_text, run_insert, 1, 1, 0, 0, BENCH_NONE},
+    {"trim", "string", setup_text, run_trim, 1, 0, 0, 0, BENCH_NONE},
+    {"strbuf_chain", "string", setup_text, run_strbuf_chain, 1, 1, 0, 0,
+     BENCH_NONE},
+    {"strcat", "string", setup_text, run_strcat, 1, 1, 0, 0, BENCH_NONE},
+    {"strncat", "string", setup_text, run_strncat, 1, 1, 0, 0, BENCH_NONE},
+    {"strtok", "string", setup_words, run_strtok, 1, 1, 0, 0, BENCH_NONE},
+    {"strtok_r", "string", setup_words, run_strtok_r, 1, 1, 0, 0, BENCH_NONE},
+    {"strerror", "string", setup_text, run_strerror, 0, 1, 0, 0, BENCH_NONE},
+    {"strerror_r", "string", setup_text, run_strerror_r, 0, 1, 0, 0,
+     BENCH_NONE},
+    {"memcmp", "string", setup_text, run_memcmp, 1, 1, 0, 0, BENCH_NONE},
+    {"strcmp", "string", setup_text, run_strcmp, 1, 1, 0, 0, BENCH_NONE},
+    {"strncmp", "string", setup_text, run_strncmp, 1, 1, 0, 0, BENCH_NONE},
+    {"strlen", "string", setup_text, run_strlen, 1, 1, 0, 0, BENCH_NONE},
+    {"strnlen", "string", setup_text, run_strnlen, 1, 1, 0, 0, BENCH_NONE},
+    {"strspn", "string", setup_text, run_strspn, 1, 1, 0, 0, BENCH_NONE},
+    {"strcspn", "string", setup_text, run_strcspn, 1, 1, 0, 0, BENCH_NONE},
+    {"dtoa", "string", setup_text, run_dtoa, 0, 1, 0, 0, BENCH_NONE},
+    {"%d", "sprintf", setup_text, run_sprintf, 1, 1, "%d ", 0, BENCH_INT},
+    {"%+08d", "sprintf", setup_text, run_sprintf, 1, 1, "%+08d ", 0,
+     BENCH_INT},
+    {"%u", "sprintf", setup_text, run_sprintf, 1, 1, "%u ", 0,
+     BENCH_UNSIGNED},
+    {"%ld", "sprintf", setup_text, run_sprintf, 1, 1, "%ld ", 0, BENCH_LONG},
+    {"%x", "sprintf", setup_text, run_sprintf, 1, 1, "%#x ", 0,
+     BENCH_UNSIGNED},
+    {"%o", "sprintf", setup_text, run_sprintf, 1, 1, "%o ", 0,
+     BENCH_UNSIGNED},
+    {"%f", "sprintf", setup_text, run_sprintf, 1, 1, "%.6f ", 0,
+     BENCH_DOUBLE},
+    {"%e", "sprintf", setup_text, run_sprintf, 1, 1, "%e ", 0, BENCH_DOUBLE},
+    {"%g", "sprintf", setup_text, run_sprintf, 1, 1, "%g ", 0, BENCH_DOUBLE},
+    {"%c", "sprintf", setup_text, run_sprintf, 1, 1, "%c", 0, BENCH_CHAR},
+    {"%p", "sprintf", setup_text, run_sprintf, 1, 1, "%p ", 0,
+     BENCH_POINTER},
+    {"%-10s", "sprintf", setup_text, run_sprintf, 1, 1, "%-10s", 0,
+     BENCH_STRING},
+    {"%%", "sprintf", setup_text, run_sprintf, 1, 1, "%%", 0, BENCH_NONE},
+    {"%s", "sprintf", setup_text, run_sprintf_string, 1, 1, 0, 0,
+     BENCH_STRING},
+    {"plan", "sprintf", setup_text, run_sprintf_plan, 1, 1, "id=%d v=%5d ",
+     0, BENCH_INT},
+    {"batch", "sprintf", setup_text, run_sprintf_batch, 1, 1,
+     "id=%d v=%.3f\n", 0, BENCH_NONE},
+    {"snprintf", "sprintf", setup_text, run_snprintf, 1, 1, 0, 0, BENCH_NONE},
+    {"asprintf", "sprintf", setup_text, run_asprintf, 1, 1, 0, 0,
+     BENCH_NONE},
+    {"fprintf", "sprintf", setup_text, run_fprintf, 1, 1, 0, 0, BENCH_NONE},
+    {"dprintf", "sprintf", setup_text, run_dprintf, 1, 1, 0, 0, BENCH_NONE},
+    {"%d", "sscanf", setup_tokens, run_sscanf, 1, 1, "%d%n", "-12345 ",
+     BENCH_INT},
+    {"%i", "sscanf", setup_tokens, run_sscanf, 1, 1, "%i%n", "0x1f ",
+     BENCH_INT},
+    {"%u", "sscanf", setup_tokens, run_sscanf, 1, 1, "%u%n", "4000000000 ",
+     BENCH_UNSIGNED},
+    {"%ld", "sscanf", setup_tokens, run_sscanf, 1, 1, "%ld%n",
+     "-1234567890123 ", BENCH_LONG},
+    {"%x", "sscanf", setup_tokens, run_sscanf, 1, 1, "%x%n", "7fa3c ",
+     BENCH_UNSIGNED},
+    {"%o", "sscanf", setup_tokens, run_sscanf, 1, 1, "%o%n", "17777 ",
+     BENCH_UNSIGNED},
+    {"%f", "sscanf", setup_tokens, run_sscanf, 1, 1, "%f%n", "3.14159 ",
+     BENCH_FLOAT},
+    {"%e", "sscanf", setup_tokens, run_sscanf, 1, 1, "%e%n", "-1.5e+10 ",
+     BENCH_FLOAT},
+    {"%g", "sscanf", setup_tokens, run_sscanf, 1, 1, "%g%n", "2.5e-3 ",
+     BENCH_FLOAT},
+    {"%s", "sscanf", setup_tokens, run_sscanf, 1, 1, "%63s%n", "token ",
+     BENCH_STRING},
+    {"%c", "sscanf", setup_tokens, run_sscanf, 1, 1, "%c%n", "x",
+     BENCH_CHAR},
+    {"%p", "sscanf", setup_tokens, run_sscanf, 1, 1, "%p%n", "0x7ffd1234 ",
+     BENCH_POINTER},
+    {"plan", "sscanf", setup_tokens, run_sscanf_plan, 1, 1, "%d%n", "-12345 ",
+     BENCH_INT},
+    {"batch", "sscanf", setup_records, run_sscanf_batch, 1, 1, "%d,%lf,%15s",
+     "1042,3.25,sensor\n", BENCH_NONE},
+};
+
+// __Driver__
+/**
+ * @brief Returns a monotonic time in seconds.
+ *
+ * @return The current time.
+ */
+static double bench_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+/**
+ * @brief Calibrates and times one benchmark for one implementation.
+ *
+ * @param bench Pointer to the benchmark case.
+ * @param state Pointer to the state, size and libc set; receives the
+ * iteration count and the bytes of the last operation.
+ * @param min_time Shortest accepted measurement in seconds.
+ * @param allocs Receives the allocations of the accepted run.
+ * @return The duration of the accepted run in seconds.
+ */
+static double bench_time(const bench_case_type *bench, bench_state_type *state,
+                         double min_time, long long *allocs) {
+  double elapsed = 0;
+  bench->setup(state);
+  while (elapsed < min_time && state->iterations < BENCH_MAX_ITERATIONS) {
+    if (elapsed > 0) {
+      double factor = min_time * 1.4 / elapsed;
+      if (factor > 10) factor = 10;
+      if (factor < 2) factor = 2;
+      state->iterations = (long long)(state->iterations * factor);
+    }
+    bench->setup(state);
+    *allocs = bench_allocs;
+    double start = bench_now();
+    bench->run(state);
+    elapsed = bench_now() - start;
+    *allocs = bench_allocs - *allocs;
+  }
+  return elapsed;
+}
+/**
+ * @brief Times one benchmark and, if it has one, its C library counterpart,
+ * alternating their runs so that both see the same state of the machine.
+ *
+ * @param bench Pointer to the benchmark case.
+ * @param states The states of the s21 and the libc runs, size and libc set;
+ * receive the iteration counts and the bytes of the last operations.
+ * @param min_time Shortest accepted measurement in seconds.
+ * @param ns_per_op Receives the ns/op of the fastest of bench_repetitions
+ * runs of each.
+ * @param allocs Receives the allocations of the calibrated runs.
+ */
+static void bench_sample(const bench_case_type *bench,
+                         bench_state_type states[2], double min_time,
+                         double ns_per_op[2], long long allocs[2]) {
+  int impls = bench->libc ? 2 : 1;
+  double best[2] = {0, 0};
+  for (int k = 0; k < impls; k++) {
+    best[k] = bench_time(bench, &states[k], min_time, &allocs[k]);
+  }
+  for (int i = 1; i < bench_repetitions; i++) {
+    for (int k = 0; k < impls; k++) {
+      bench->setup(&states[k]);
+      double start = bench_now();
+      bench->run(&states[k]);
+      double again = bench_now() - start;
+      if (again < best[k]) best[k] = again;
+    }
+  }
+  for (int k = 0; k < impls; k++) {
+    ns_per_op[k] = best[k] * 1e9 / (double)states[k].iterations;
+  }
+}
+/**
+ * @brief Measures one benchmark and its C library counterpart and records
+ * them, the libc result right after the s21 one; a pass after the first adds
+ * a sample to the results of the first.
+ *
+ * @param bench Pointer to the benchmark case.
+ * @param size Bytes per operation.
+ * @param min_time Shortest accepted measurement in seconds.
+ */
+static void bench_measure(const bench_case_type *bench, s21_size_t size,
+                          double min_time) {
+  bench_state_type states[2] = {
+      {size, 1, 0, bench->format, bench->token, bench->arg, 0},
+      {size, 1, 1, bench->format, bench->token, bench->arg, 0}};
+  double ns_per_op[2] = {0, 0};
+  long long allocs[2] = {0, 0};
+  bench_sample(bench, states, min_time, ns_per_op, allocs);
+  for (int k = 0; k < (bench->libc ? 2 : 1); k++) {
+    if (bench_pass ? bench_cursor < bench_results_count
+                   : bench_results_count < BENCH_MAX_RESULTS) {
+      bench_result_type *result = bench_pass
+                                      ? &bench_results[bench_cursor++]
+                                      : &bench_results[bench_results_count++];
+      result->samples[bench_pass] = ns_per_op[k];
+      result->bench = bench;
+      result->name = bench->name;
+      result->family = bench->family;
+      result->impl = k ? "libc" : "s21";
+      result->size = bench->sized ? size : 0;
+      result->run_size = size;
+      result->iterations = states[k].iterations;
+      result->ns_per_op = ns_per_op[k];
+      result->bytes_per_op = (double)states[k].bytes;
+#ifdef S21_BENCH_ALLOCS
+      result->allocs_per_op =
+          (double)allocs[k] / (double)states[k].iterations;
+#else
+      result->allocs_per_op = -1;
+#endif
+      printf("%-8s %-12s %8llu %-4s %12.1f ns/op %10.0f B/op %6.2f "
+             "allocs/op\n",
+             result->family, result->name, result->size, result->impl,
+             result->ns_per_op, result->bytes_per_op, result->allocs_per_op);
+      fflush(stdout);
+    }
+  }
+}
+/**
+ * @brief Replaces the ns/op of every result with the median of its passes.
+ */
+static void bench_take_medians(void) {
+  for (int i = 0; i < bench_results_count; i++) {
+    double *samples = bench_results[i].samples;
+    for (int j = 1; j < bench_passes; j++) {
+      for (int k = j; k > 0 && samples[k] < samples[k - 1]; k--) {
+        double sample = samples[k];
+        samples[k] = samples[k - 1];
+        samples[k - 1] = sample;
+      }
+    }
+    bench_results[i].ns_per_op = samples[bench_passes / 2];
+  }
+}
+/**
+ * @brief Writes the JSON name of a measurement.
+ *
+ * @param name Buffer of BENCH_NAME_SIZE bytes.
+ * @param result Pointer to the measurement.
+ */
+static void bench_full_name(char *name, const bench_result_type *result) {
+  snprintf(name, BENCH_NAME_SIZE, "%s/%s/%s/%llu", result->impl,
+           result->family, result->name, result->size);
+}
+/**
+ * @brief Writes every measurement as CSV.
+ *
+ * @param path Destination file.
+ */
+static void bench_write_csv(const char *path) {
+  FILE *file = fopen(path, "w");
+  if (file) {
+    fprintf(file,
+            "family,name,impl,size,iterations,ns_per_op,bytes_per_op,"
+            "allocs_per_op\n");
+    for (int i = 0; i < bench_results_count; i++) {
+      const bench_result_type *r = &bench_results[i];
+      fprintf(file, "%s,\"%s\",%s,%llu,%lld,%.3f,%.0f,%.3f\n", r->family,
+              r->name, r->impl, r->size, r->iterations, r->ns_per_op,
+              r->bytes_per_op, r->allocs_per_op);
+    }
+    fclose(file);
+  }
+}
+/**
+ * @brief Writes every measurement as JSON in the layout of Google Benchmark.
+ *
+ * @param path Destination file.
+ * @param min_time The --min-time used for the run.
+ */
+static void bench_write_json(const char *path, double min_time) {
+  FILE *file = fopen(path, "w");
+  if (file) {
+    time_t now = time(s21_NULL);
+    char date[32] = {0};
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+    fprintf(file, "{\n  \"context\": {\n    \"date\": \"%s\",\n", date);
+    fprintf(file, "    \"num_cpus\": %ld,\n", sysconf(_SC_NPROCESSORS_ONLN));
+    fprintf(file, "    \"simd_block_size\": %d,\n", S21_BLOCK_SIZE);
+    fprintf(file, "    \"kernels\": \"%s\",\n", s21_kernels_name());
+    fprintf(file, "    \"min_time\": %g,\n", min_time);
+    fprintf(file, "    \"repetitions\": %d,\n", bench_repetitions);
+    fprintf(file, "    \"passes\": %d\n  },\n  \"benchmarks\": [\n",
+            bench_passes);
+    for (int i = 0; i < bench_results_count; i++) {
+      const bench_result_type *r = &bench_results[i];
+      char name[BENCH_NAME_SIZE];
+      bench_full_name(name, r);
+      fprintf(file,
+              "    {\"name\": \"%s\", \"family\": \"%s\", "
+              "\"function\": \"%s\", \"impl\": \"%s\", \"size\": %llu, "
+              "\"iterations\": %lld, \"ns_per_op\": %.3f, "
+              "\"bytes_per_op\": %.0f, \"allocs_per_op\": %.3f}%s\n",
+              name, r->family, r->name, r->impl, r->size, r->iterations,
+              r->ns_per_op, r->bytes_per_op, r->allocs_per_op,
+              i + 1 < bench_results_count ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+  }
+}
+// __Gate__
+/**
+ * @brief Reads the measurements of a JSON file written by --json.
+ *
+ * Every benchmark sits on a line of its own, so the name and ns_per_op fields
+ * are picked from the lines that hold both.
+ *
+ * @param path The baseline file.
+ * @return 0 on success, -1 if the file could not be opened.
+ */
+static int bench_read_baseline(const char *path) {
+  FILE *file = fopen(path, "r");
+  char line[512];
+  while (file && bench_baselines_count < BENCH_MAX_RESULTS &&
+         fgets(line, sizeof(line), file)) {
+    const char *name = strstr(line, "\"name\": \"");
+    const char *ns = strstr(line, "\"ns_per_op\": ");
+    bench_baseline_type *baseline = &bench_baselines[bench_baselines_count];
+    if (name && ns &&
+        s21_sscanf(name + 9, "%95[^\"]", baseline->name) == 1 &&
+        s21_sscanf(ns + 13, "%lf", &baseline->ns_per_op) == 1) {
+      bench_baselines_count++;
+    }
+  }
+  if (file) fclose(file);
+  return file ? 0 : -1;
+}
+/**
+ * @brief Looks up the baseline of a measurement.
+ *
+ * @param result Pointer to the measurement.
+ * @return The baseline ns/op, or 0 if the baseline has none.
+ */
+static double bench_baseline_of(const bench_result_type *result) {
+  char name[BENCH_NAME_SIZE];
+  double ns_per_op = 0;
+  bench_full_name(name, result);
+  for (int i = 0; i < bench_baselines_count && !ns_per_op; i++) {
+    if (!strcmp(bench_baselines[i].name, name)) {
+      ns_per_op = bench_baselines[i].ns_per_op;
+    }
+  }
+  return ns_per_op;
+}
+/**
+ * @brief Measures a benchmark of the gate again, twice as long.
+ *
+ * @param result Pointer to the s21 measurement to repeat.
+ * @param min_time The --min-time of the run.
+ * @param libc_ns Receives the new ns/op of the libc counterpart, if any.
+ * @return The new ns/op.
+ */
+static double bench_remeasure(const bench_result_type *result,
+                              double min_time, double *libc_ns) {
+  const bench_case_type *bench = result->bench;
+  bench_state_type states[2] = {
+      {result->run_size, 1, 0, bench->format, bench->token, bench->arg, 0},
+      {result->run_size, 1, 1, bench->format, bench->token, bench->arg, 0}};
+  double ns_per_op[2] = {0, 0};
+  long long allocs[2] = {0, 0};
+  bench_sample(bench, states, min_time * 2, ns_per_op, allocs);
+  *libc_ns = ns_per_op[1];
+  return ns_per_op[0];
+}
+/**
+ * @brief Compares the s21 measurements with the baseline.
+ *
+ * The suspected regressions are measured again in rounds after the whole run
+ * rather than one after another, so a stretch of time the machine was slow in
+ * does not sample all the measurements of a benchmark.
+ *
+ * @param threshold Accepted slowdown in percent, doubled for a benchmark whose
+ * baseline is below BENCH_NOISE_FLOOR ns/op.
+ * @param relative 1 to compare the ratios of the s21 and libc ns/op of the
+ * benchmarks that have a libc counterpart, which cancels the speed of the
+ * machine; the others are compared by ns/op.
+ * @param min_time Shortest accepted measurement in seconds.
+ * @return The number of benchmarks that stay slower than the threshold after
+ * BENCH_RETRIES more rounds of measurements.
+ */
+static int bench_gate(double threshold, int relative, double min_time) {
+  int regressions = 0, checks = 0, suspects = 1;
+  for (int i = 0; i < bench_results_count; i++) {
+    const bench_result_type *r = &bench_results[i];
+    // bench_measure records the libc counterpart right after the s21 function
+    const bench_result_type *libc =
+        relative && i + 1 < bench_results_count && r[1].bench == r->bench &&
+                r[1].run_size == r->run_size && strcmp(r[1].impl, "s21")
+            ? &r[1]
+            : s21_NULL;
+    double baseline = strcmp(r->impl, "s21") ? 0 : bench_baseline_of(r);
+    double libc_baseline = libc ? bench_baseline_of(libc) : 0;
+    if (baseline && (!libc || libc_baseline)) {
+      bench_check_type *check = &bench_checks[checks++];
+      double allowed =
+          baseline < BENCH_NOISE_FLOOR ? threshold * 2 : threshold;
+      check->result = r;
+      check->libc = libc;
+      check->baseline = libc ? baseline / libc_baseline : baseline;
+      check->limit = check->baseline * (1 + allowed / 100);
+      check->current = libc ? r->ns_per_op / libc->ns_per_op : r->ns_per_op;
+    }
+  }
+  for (int round = 0; suspects && round < BENCH_RETRIES; round++) {
+    suspects = 0;
+    for (int i = 0; i < checks; i++) {
+      bench_check_type *check = &bench_checks[i];
+      if (check->current > check->limit) {
+        double libc_ns = 1;
+        double ns = bench_remeasure(check->result, min_time, &libc_ns);
+        double again = check->libc ? ns / libc_ns : ns;
+        if (again < check->current) check->current = again;
+        suspects += check->current > check->limit;
+      }
+    }
+  }
+  for (int i = 0; i < checks; i++) {
+    const bench_check_type *check = &bench_checks[i];
+    if (check->current > check->limit) {
+      char name[BENCH_NAME_SIZE];
+      bench_full_name(name, check->result);
+      printf("REGRESSION %s: %.*f%s, baseline %.*f%s (%+.1f%%)\n", name,
+             check->libc ? 2 : 1, check->current,
+             check->libc ? " x libc" : " ns/op", check->libc ? 2 : 1,
+             check->baseline, check->libc ? " x libc" : " ns/op",
+             (check->current / check->baseline - 1) * 100);
+      regressions++;
+    }
+  }
+  printf("gate: %d of %d benchmarks slower than the baseline by more than "
+         "%g%% (%g%% below %g ns/op)\n",
+         regressions, checks, threshold, threshold * 2, BENCH_NOISE_FLOOR);
+  return regressions;
+}
+/**
+ * @brief Runs the benchmarks selected by the command line.
+ *
+ * @param argc Number of arguments.
+ * @param argv Arguments, see the file description.
+ * @return 0 on success, 1 if the buffers or the baseline could not be read or
+ * allocated, 2 if the gate found a regression.
+ */
+int main(int argc, char **argv) {
+  const char *json_path = s21_NULL;
+  const char *csv_path = s21_NULL;
+  const char *filter = s21_NULL;
+  const char *baseline_path = s21_NULL;
+  double min_time = BENCH_MIN_TIME;
+  double threshold = BENCH_THRESHOLD;
+  int relative = 0;
+  int status = 0;
+  for (int i = 1; i < argc; i++) {
+    if (!strncmp(argv[i], "--json=", 7)) json_path = argv[i] + 7;
+    if (!strncmp(argv[i], "--csv=", 6)) csv_path = argv[i] + 6;
+    if (!strncmp(argv[i], "--filter=", 9)) filter = argv[i] + 9;
+    if (!strncmp(argv[i], "--min-time=", 11)) min_time = atof(argv[i] + 11);
+    if (!strncmp(argv[i], "--passes=", 9)) {
+      bench_passes = atoi(argv[i] + 9);
+      if (bench_passes < 1) bench_passes = 1;
+      if (bench_passes > BENCH_MAX_PASSES) bench_passes = BENCH_MAX_PASSES;
+    }
+    if (!strncmp(argv[i], "--repetitions=", 14)) {
+      bench_repetitions = atoi(argv[i] + 14);
+      if (bench_repetitions < 1) bench_repetitions = 1;
+    }
+    if (!strncmp(argv[i], "--baseline=", 11)) baseline_path = argv[i] + 11;
+    if (!strncmp(argv[i], "--threshold=", 12)) threshold = atof(argv[i] + 12);
+    if (!strcmp(argv[i], "--relative")) relative = 1;
+  }
+  bench_input = malloc(BENCH_MAX_SIZE + BENCH_SLACK);
+  bench_other = malloc(BENCH_MAX_SIZE + BENCH_SLACK);
+  bench_output = malloc(BENCH_MAX_SIZE + BENCH_SLACK);
+  if (!bench_input || !bench_other || !bench_output) status = 1;
+  if (!status && baseline_path && bench_read_baseline(baseline_path)) {
+    fprintf(stderr, "s21_bench: cannot read the baseline %s\n", baseline_path);
+    status = 1;
+  }
+  size_t count = sizeof(bench_cases) / sizeof(bench_cases[0]);
+  for (bench_pass = 0; !status && bench_pass < bench_passes; bench_pass++) {
+    bench_cursor = 0;
+    for (size_t i = 0; i < count; i++) {
+      const bench_case_type *bench = &bench_cases[i];
+      char full_name[64];
+      snprintf(full_name, sizeof(full_name), "%s/%s", bench->family,
+               bench->name);
+      if (filter && !strstr(full_name, filter)) continue;
+      size_t sizes =
+          bench->sized ? sizeof(bench_sizes) / sizeof(bench_sizes[0]) : 1;
+      for (size_t j = 0; j < sizes; j++) {
+        bench_measure(bench, bench_sizes[j], min_time);
+      }
+    }
+  }
+  bench_take_medians();
+  if (!status && csv_path) bench_write_csv(csv_path);
+  if (!status && json_path) bench_write_json(json_path, min_time);
+  if (!status && baseline_path && bench_gate(threshold, relative, min_time)) {
+    status = 2;
+  }
+  free(bench_input);
+  free(bench_other);
+  free(bench_output);
+  return status;
+}
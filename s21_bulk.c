@@ -0,0 +1,229 @@
+/**
+ * @file s21_bulk.c
+ * @brief Implementation of the bulk text driver.
+ *
+ * A run first cuts the whole text into line-aligned chunks, one s21_memchr
+ * call per chunk boundary, and then starts its workers; the calling thread is
+ * one of them. A worker takes chunk indices from the atomic cursor of the run
+ * until none is left, so the chunks are spread over the threads as they
+ * finish, whatever the time each chunk takes. Deliveries hold the lock of the
+ * run: in ordered mode a finished chunk waits in the results array until the
+ * chunks before it were delivered.
+ *
+ * Function Overview:
+ * - s21_bulk_buffer: Runs a job over a memory buffer.
+ * - s21_bulk_file: Runs a job over a file mapped with mmap.
+ * - s21_bulk_split: Finds the chunk boundaries.
+ * - s21_bulk_worker, s21_bulk_process, s21_bulk_deliver: The work of a
+ * thread.
+ *
+ * @note A line handed to a callback is always followed by a '\n' or a '\0',
+ * so the s21_sscanf family can read it in place.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include "s21_bulk.h"
+
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Runs a job over a memory buffer.
+ *
+ * @param data Pointer to the text. Its last line must be followed by a '\0'
+ * for callbacks that read it as a string.
+ * @param length Length of the text.
+ * @param job Pointer to the job.
+ * @return 0 on success, -1 if the chunk tables could not be allocated.
+ */
+int s21_bulk_buffer(const char *data, s21_size_t length,
+                    const bulk_job_type *job) {
+  bulk_run_type run;
+  s21_size_t chunk_size = job->chunk_size ? job->chunk_size : S21_BULK_CHUNK;
+  s21_size_t most = length / chunk_size + 2;  // bounds of the most chunks
+  int status = 0;
+  run.job = job;
+  run.data = data;
+  run.bounds = malloc(most * sizeof(s21_size_t));
+  run.results = calloc(most, sizeof(void *));
+  run.done = calloc(most, sizeof(unsigned char));
+  run.delivered = 0;
+  if (!run.bounds || !run.results || !run.done) {
+    status = -1;
+  } else {
+    pthread_t workers[S21_BULK_MAX_THREADS];
+    int started = 0;
+    run.count = s21_bulk_split(data, length, chunk_size, run.bounds);
+    atomic_init(&run.next, 0);
+    pthread_mutex_init(&run.lock, s21_NULL);
+    // a thread that fails to start leaves its share to the others
+    for (int threads = s21_bulk_threads(job, run.count);
+         started < threads - 1 &&
+         !pthread_create(&workers[started], s21_NULL, s21_bulk_worker, &run);
+         started++) {
+    }
+    s21_bulk_worker(&run);
+    for (int i = 0; i < started; i++) pthread_join(workers[i], s21_NULL);
+    pthread_mutex_destroy(&run.lock);
+  }
+  free(run.bounds);
+  free(run.results);
+  free(run.done);
+  return status;
+}
+/**
+ * @brief Runs a job over a file mapped with mmap.
+ *
+ * A file whose last line has no '\n' and ends exactly on a page boundary is
+ * read into a null-terminated heap buffer instead, the byte after a mapping
+ * being readable as '\0' only inside its last page.
+ *
+ * @param path Path of the file.
+ * @param job Pointer to the job.
+ * @return 0 on success, -1 if the file could not be opened, mapped or read.
+ */
+int s21_bulk_file(const char *path, const bulk_job_type *job) {
+  int status = -1;
+  int fd = open(path, O_RDONLY);
+  struct stat info;
+  if (fd >= 0 && !fstat(fd, &info)) {
+    s21_size_t length = (s21_size_t)info.st_size;
+    long page = sysconf(_SC_PAGESIZE);
+    char *data = length ? mmap(s21_NULL, length, PROT_READ, MAP_PRIVATE, fd, 0)
+                        : s21_NULL;
+    if (!length) {
+      status = s21_bulk_buffer("", 0, job);
+    } else if (data != MAP_FAILED && (data[length - 1] == '\n' || page <= 0 ||
+                                      length % (s21_size_t)page)) {
+      posix_madvise(data, length, POSIX_MADV_SEQUENTIAL);
+      status = s21_bulk_buffer(data, length, job);
+      munmap(data, length);
+    } else if (data != MAP_FAILED) {
+      munmap(data, length);
+      char *copy = malloc(length + 1);
+      s21_size_t got = 0;
+      ssize_t count = 1;
+      while (copy && got < length && count > 0) {
+        count = pread(fd, copy + got, length - got, (off_t)got);
+        if (count > 0) got += (s21_size_t)count;
+      }
+      if (copy && got == length) {
+        copy[length] = '\0';
+        status = s21_bulk_buffer(copy, length, job);
+      }
+      free(copy);
+    }
+  }
+  if (fd >= 0) close(fd);
+  return status;
+}
+// __Chunks__
+/**
+ * @brief Cuts a text into chunks of at least chunk_size bytes that end after
+ * a '\n', the last one at the end of the text.
+ *
+ * @param data Pointer to the text.
+ * @param length Length of the text.
+ * @param chunk_size The size to cut at before the line alignment.
+ * @param bounds Array of length / chunk_size + 2 elements, set to the offsets
+ * of the chunk starts followed by length.
+ * @return The number of chunks.
+ */
+s21_size_t s21_bulk_split(const char *data, s21_size_t length,
+                          s21_size_t chunk_size, s21_size_t *bounds) {
+  s21_size_t count = 0;
+  bounds[0] = 0;
+  while (bounds[count] < length) {
+    s21_size_t start = bounds[count];
+    s21_size_t end = length - start > chunk_size ? start + chunk_size : length;
+    if (end < length) {
+      const char *newline = s21_memchr(data + end - 1, '\n', length - end + 1);
+      end = newline ? (s21_size_t)(newline - data) + 1 : length;
+    }
+    bounds[++count] = end;
+  }
+  return count;
+}
+/**
+ * @brief Returns the number of threads of a run.
+ *
+ * @param job Pointer to the job.
+ * @param count Number of chunks.
+ * @return The threads of the job, or the online processors, at most
+ * S21_BULK_MAX_THREADS and count, at least 1.
+ */
+int s21_bulk_threads(const bulk_job_type *job, s21_size_t count) {
+  long threads = job->threads > 0 ? job->threads
+                                  : sysconf(_SC_NPROCESSORS_ONLN);
+  if (threads > S21_BULK_MAX_THREADS) threads = S21_BULK_MAX_THREADS;
+  if ((s21_size_t)threads > count) threads = (long)count;
+  if (threads < 1) threads = 1;
+  return (int)threads;
+}
+// __Workers__
+/**
+ * @brief Processes chunks until the run has none left.
+ *
+ * @param argument Pointer to the bulk_run_type.
+ * @return s21_NULL.
+ */
+void *s21_bulk_worker(void *argument) {
+  bulk_run_type *run = argument;
+  for (s21_size_t index = atomic_fetch_add(&run->next, 1); index < run->count;
+       index = atomic_fetch_add(&run->next, 1)) {
+    s21_bulk_process(run, index);
+  }
+  return s21_NULL;
+}
+/**
+ * @brief Runs the callbacks of a job on one chunk and delivers its result.
+ *
+ * @param run Pointer to the run.
+ * @param index Index of the chunk.
+ */
+void s21_bulk_process(bulk_run_type *run, s21_size_t index) {
+  const bulk_job_type *job = run->job;
+  const char *line = run->data + run->bounds[index];
+  const char *end = run->data + run->bounds[index + 1];
+  void *result = s21_NULL;
+  if (job->chunk) {
+    result = job->chunk(job->context, s21_strview_n(line, end - line), index);
+  } else if (job->line) {
+    while (line < end) {
+      const char *newline = s21_memchr(line, '\n', end - line);
+      const char *stop = newline ? newline : end;
+      job->line(job->context, s21_strview_n(line, stop - line), index);
+      line = newline ? newline + 1 : end;
+    }
+  }
+  s21_bulk_deliver(run, index, result);
+}
+/**
+ * @brief Hands the result of a chunk to the deliver callback, after the
+ * results of the chunks before it in ordered mode.
+ *
+ * @param run Pointer to the run.
+ * @param index Index of the chunk.
+ * @param result The result of the chunk.
+ */
+void s21_bulk_deliver(bulk_run_type *run, s21_size_t index, void *result) {
+  const bulk_job_type *job = run->job;
+  if (job->deliver) {
+    pthread_mutex_lock(&run->lock);
+    if (job->ordered) {
+      run->results[index] = result;
+      run->done[index] = 1;
+      while (run->delivered < run->count && run->done[run->delivered]) {
+        job->deliver(job->context, run->delivered,
+                     run->results[run->delivered]);
+        run->delivered++;
+      }
+    } else {
+      job->deliver(job->context, index, result);
+    }
+    pthread_mutex_unlock(&run->lock);
+  }
+}
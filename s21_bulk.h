@@ -0,0 +1,69 @@
+/**
+ * @file s21_bulk.h
+ * @brief Header file defining the bulk text driver.
+ *
+ * The driver runs a job over a large text, a memory buffer or a file mapped
+ * with mmap, on a pool of threads. The text is cut into chunks of about
+ * chunk_size bytes that end on a '\n', found with s21_memchr, and the workers
+ * take the next chunk from a shared atomic cursor, so a thread that is done
+ * early keeps picking up work while a slow one is busy. Every chunk is handed
+ * to the chunk callback, or line by line to the line callback, and its result
+ * to the deliver callback, one delivery at a time, in file order if asked.
+ *
+ * Structures:
+ * - bulk_job_type: The callbacks and the settings of a run.
+ * - bulk_run_type: The state the workers of a run share.
+ *
+ * @note Programs using the driver link with -pthread.
+ */
+#ifndef SRC_S21_BULK_H_
+#define SRC_S21_BULK_H_
+
+#include <pthread.h>
+
+#include "s21_string.h"
+
+#define S21_BULK_CHUNK (1 << 20)  // default chunk size in bytes
+#define S21_BULK_MAX_THREADS 256
+
+typedef struct bulk_job {
+  // processes a chunk of whole lines, the last '\n' included, and returns the
+  // result handed to deliver; s21_NULL to call line for every line instead
+  void *(*chunk)(void *context, strview_type chunk, s21_size_t index);
+  // processes one line, without its '\n', of the chunk 'index'
+  void (*line)(void *context, strview_type line, s21_size_t index);
+  // receives the result of every chunk, s21_NULL in line mode; may be s21_NULL
+  void (*deliver)(void *context, s21_size_t index, void *result);
+  void *context;          // passed to every callback
+  int threads;            // workers, 0: one per online processor
+  s21_size_t chunk_size;  // bytes per chunk before the line alignment, 0:
+                          // S21_BULK_CHUNK
+  int ordered;            // 1: deliver the chunks in file order
+} bulk_job_type;
+
+typedef struct bulk_run {
+  const bulk_job_type *job;
+  const char *data;
+  s21_size_t *bounds;       // chunk i is data[bounds[i], bounds[i + 1])
+  s21_size_t count;         // number of chunks
+  void **results;           // results waiting for an ordered delivery
+  unsigned char *done;      // 1 for the chunks waiting in results
+  s21_size_t delivered;     // chunks delivered so far in ordered mode
+  _Atomic s21_size_t next;  // the next chunk to take
+  pthread_mutex_t lock;     // serializes the deliveries
+} bulk_run_type;
+
+int s21_bulk_buffer(const char *data, s21_size_t length,
+                    const bulk_job_type *job);
+int s21_bulk_file(const char *path, const bulk_job_type *job);
+
+// __Chunks__
+s21_size_t s21_bulk_split(const char *data, s21_size_t length,
+                          s21_size_t chunk_size, s21_size_t *bounds);
+int s21_bulk_threads(const bulk_job_type *job, s21_size_t count);
+// __Workers__
+void *s21_bulk_worker(void *argument);
+void s21_bulk_process(bulk_run_type *run, s21_size_t index);
+void s21_bulk_deliver(bulk_run_type *run, s21_size_t index, void *result);
+
+#endif  // SRC_S21_BULK_H_
@@ -0,0 +1,83 @@
+/**
+ * @file s21_charset.c
+ * @brief Implementation of the 256-bit character set.
+ *
+ * A set keeps one bit per byte value, so testing a byte costs one shift and
+ * one mask whatever the size of the set. Functions that take a set of
+ * characters as a string build it once per call and then scan the input in a
+ * single pass, instead of comparing every input byte with every set byte.
+ *
+ * Function Overview:
+ * - s21_charset_init, s21_charset_add, s21_charset_invert: Build a set.
+ * - s21_charset_has: Test one byte.
+ * - s21_charset_span, s21_charset_cspan: Length of the prefix of a string
+ * inside or outside the set, the engines of s21_strspn and s21_strcspn.
+ *
+ * @note The '\0' byte is never a member of a set built from a string or
+ * inverted, so a span always stops at the end of the string.
+ */
+#include "s21_string.h"
+
+/**
+ * @brief Builds the set of the characters of a string.
+ *
+ * @param set Pointer to the set to build.
+ * @param chars The characters of the set, may be s21_NULL for an empty set.
+ */
+void s21_charset_init(charset_type *set, const char *chars) {
+  for (int i = 0; i < S21_CHARSET_WORDS; i++) set->bits[i] = 0;
+  for (; chars && *chars; chars++) s21_charset_add(set, (unsigned char)*chars);
+}
+/**
+ * @brief Adds a byte to a set.
+ *
+ * @param set Pointer to the set.
+ * @param c The byte to add.
+ */
+void s21_charset_add(charset_type *set, unsigned char c) {
+  set->bits[c >> 6] |= 1ULL << (c & 63);
+}
+/**
+ * @brief Replaces a set with its complement, '\0' left out.
+ *
+ * @param set Pointer to the set.
+ */
+void s21_charset_invert(charset_type *set) {
+  for (int i = 0; i < S21_CHARSET_WORDS; i++) set->bits[i] = ~set->bits[i];
+  set->bits[0] &= ~1ULL;
+}
+/**
+ * @brief Checks whether a byte belongs to a set.
+ *
+ * @param set Pointer to the set.
+ * @param c The byte to check.
+ * @return 1 if 'c' is in the set, otherwise 0.
+ */
+int s21_charset_has(const charset_type *set, unsigned char c) {
+  return (int)(set->bits[c >> 6] >> (c & 63) & 1);
+}
+/**
+ * @brief Calculates the length of the prefix of a string made of set members.
+ *
+ * @param str Pointer to the string to be scanned.
+ * @param set Pointer to the set.
+ * @return Length of the prefix.
+ */
+s21_size_t s21_charset_span(const char *str, const charset_type *set) {
+  const unsigned char *ptr = (const unsigned char *)str;
+  while (*ptr && s21_charset_has(set, *ptr)) ptr++;
+  return ptr - (const unsigned char *)str;
+}
+/**
+ * @brief Calculates the length of the prefix of a string with no set members.
+ *
+ * @param str Pointer to the string to be scanned.
+ * @param set Pointer to the set.
+ * @return Length of the prefix, the length of the string if no byte of it is
+ * in the set.
+ */
+s21_size_t s21_charset_cspan(const char *str, const charset_type *set) {
+  const unsigned char *ptr = (const unsigned char *)str;
+  while (*ptr && !s21_charset_has(set, *ptr)) ptr++;
+  return ptr - (const unsigned char *)str;
+}
@@ -0,0 +1,392 @@
+/**
+ * @file s21_decimal.c
+ * @brief Implementation of the exact binary to decimal conversion engine.
+ *
+ * A finite binary float is m * 2^e. For e >= 0 it is the integer m * 2^e, for
+ * e < 0 it is m * 5^-e / 10^-e. Both forms are computed exactly in a base 10^9
+ * big integer, so every decimal digit of the value is available and rounding
+ * can look at the whole tail instead of a few guard digits.
+ *
+ * Function Overview:
+ * - s21_decimal_from_float, s21_decimal_from_binary: Build the exact decimal.
+ * - s21_decimal_round: Digits rounded to a number of significant digits, used
+ * by %f, %e and %g.
+ * - s21_decimal_shortest: Shortest digits of a double that read back to the
+ * same value, found between the exact halfway points to its neighbours.
+ *
+ * @note Numbers are expected to be finite and non-negative, the sign, NaN and
+ * infinity are handled by the callers.
+ */
+#include "s21_decimal.h"
+
+static const unsigned int s21_pow10[S21_BIGNUM_BASE_DIGITS + 1] = {
+    1,      10,      100,      1000,      10000,
+    100000, 1000000, 10000000, 100000000, 1000000000};
+
+static const unsigned int s21_pow5[S21_BIGNUM_POW5_STEP + 1] = {
+    1,       5,        25,        125,        625,        3125,      15625,
+    78125,   390625,   1953125,   9765625,    48828125,   244140625,
+    1220703125};
+
+// __Big integers__
+/**
+ * @brief Sets a big integer to a 64-bit value.
+ *
+ * @param num Pointer to the big integer.
+ * @param value The value to store.
+ */
+void s21_bignum_set(bignum_type *num, unsigned long long value) {
+  num->size = 0;
+  while (value) {
+    num->limbs[num->size++] = (unsigned int)(value % S21_BIGNUM_BASE);
+    value /= S21_BIGNUM_BASE;
+  }
+}
+/**
+ * @brief Multiplies a big integer by a small factor in place.
+ *
+ * @param num Pointer to the big integer.
+ * @param factor The factor, any 32-bit value.
+ */
+void s21_bignum_mul_small(bignum_type *num, unsigned int factor) {
+  unsigned long long carry = 0;
+  for (int i = 0; i < num->size; i++) {
+    carry += (unsigned long long)num->limbs[i] * factor;
+    num->limbs[i] = (unsigned int)(carry % S21_BIGNUM_BASE);
+    carry /= S21_BIGNUM_BASE;
+  }
+  while (carry && num->size < S21_BIGNUM_LIMBS) {
+    num->limbs[num->size++] = (unsigned int)(carry % S21_BIGNUM_BASE);
+    carry /= S21_BIGNUM_BASE;
+  }
+}
+/**
+ * @brief Adds a small value to a big integer in place.
+ *
+ * @param num Pointer to the big integer.
+ * @param value The value to add.
+ */
+void s21_bignum_add_small(bignum_type *num, unsigned int value) {
+  unsigned long long carry = value;
+  for (int i = 0; carry && i < num->size; i++) {
+    carry += num->limbs[i];
+    num->limbs[i] = (unsigned int)(carry % S21_BIGNUM_BASE);
+    carry /= S21_BIGNUM_BASE;
+  }
+  while (carry && num->size < S21_BIGNUM_LIMBS) {
+    num->limbs[num->size++] = (unsigned int)(carry % S21_BIGNUM_BASE);
+    carry /= S21_BIGNUM_BASE;
+  }
+}
+/**
+ * @brief Multiplies a big integer by 2^power in place.
+ *
+ * @param num Pointer to the big integer.
+ * @param power Non-negative power of two.
+ */
+void s21_bignum_mul_pow2(bignum_type *num, int power) {
+  while (power > 0) {
+    int step = (power < S21_BIGNUM_POW2_STEP) ? power : S21_BIGNUM_POW2_STEP;
+    s21_bignum_mul_small(num, 1U << step);
+    power -= step;
+  }
+}
+/**
+ * @brief Multiplies a big integer by 5^power in place.
+ *
+ * @param num Pointer to the big integer.
+ * @param power Non-negative power of five.
+ */
+void s21_bignum_mul_pow5(bignum_type *num, int power) {
+  while (power > 0) {
+    int step = (power < S21_BIGNUM_POW5_STEP) ? power : S21_BIGNUM_POW5_STEP;
+    s21_bignum_mul_small(num, s21_pow5[step]);
+    power -= step;
+  }
+}
+/**
+ * @brief Counts the decimal digits of a big integer.
+ *
+ * The digits of the top limb come from its bit length: bits * 1233 / 4096
+ * underestimates bits * log10(2) by less than one, so one comparison with the
+ * power of ten table corrects it.
+ *
+ * @param num Pointer to the big integer.
+ * @return The number of digits, 0 for zero.
+ */
+int s21_bignum_digits_count(const bignum_type *num) {
+  int count = 0;
+  if (num->size > 0) {
+    unsigned int top = num->limbs[num->size - 1];
+    int bits = 32 - __builtin_clz(top);  // the top limb is never zero
+    int digits = (bits * 1233) >> 12;    // at most 9, limbs are below 2^30
+    if (top >= s21_pow10[digits]) {
+      digits += 1;
+    }
+    count = (num->size - 1) * S21_BIGNUM_BASE_DIGITS + digits;
+  }
+  return count;
+}
+// __Decimal conversion__
+/**
+ * @brief Converts a finite non-negative long double into an exact decimal.
+ *
+ * The significand is read in S21_BIGNUM_POW2_STEP bit chunks, so the
+ * conversion does not depend on the width of long double.
+ *
+ * @param value The value to convert.
+ * @param decimal Pointer to the decimal to fill.
+ */
+void s21_decimal_from_float(long double value, decimal_type *decimal) {
+  int exponent = 0;
+  long double fraction = frexpl(value, &exponent);
+  s21_bignum_set(&decimal->mantissa, 0);
+  while (fraction != 0) {
+    unsigned int chunk = 0;
+    fraction = ldexpl(fraction, S21_BIGNUM_POW2_STEP);
+    chunk = (unsigned int)fraction;
+    fraction -= chunk;
+    s21_bignum_mul_small(&decimal->mantissa, 1U << S21_BIGNUM_POW2_STEP);
+    s21_bignum_add_small(&decimal->mantissa, chunk);
+    exponent -= S21_BIGNUM_POW2_STEP;
+  }
+  s21_decimal_scale(decimal, exponent);
+}
+/**
+ * @brief Converts mantissa * 2^exponent into an exact decimal.
+ *
+ * @param mantissa The integer mantissa.
+ * @param exponent The binary exponent.
+ * @param decimal Pointer to the decimal to fill.
+ */
+void s21_decimal_from_binary(unsigned long long mantissa, int exponent,
+                             decimal_type *decimal) {
+  while (mantissa && !(mantissa & 1) && exponent < 0) {
+    mantissa >>= 1;
+    exponent += 1;
+  }
+  s21_bignum_set(&decimal->mantissa, mantissa);
+  s21_decimal_scale(decimal, exponent);
+}
+/**
+ * @brief Applies the binary exponent to the mantissa of a decimal.
+ *
+ * @param decimal Pointer to the decimal holding the integer mantissa.
+ * @param exponent The binary exponent of the value.
+ */
+void s21_decimal_scale(decimal_type *decimal, int exponent) {
+  decimal->scale = 0;
+  if (exponent > 0) {
+    s21_bignum_mul_pow2(&decimal->mantissa, exponent);
+  } else if (exponent < 0) {
+    s21_bignum_mul_pow5(&decimal->mantissa, -exponent);
+    decimal->scale = -exponent;
+  }
+  decimal->digits_count = s21_bignum_digits_count(&decimal->mantissa);
+}
+/**
+ * @brief Returns the power of ten of the leading digit of a decimal.
+ *
+ * @param decimal Pointer to the decimal.
+ * @return The decimal exponent, 0 for zero.
+ */
+int s21_decimal_exponent(const decimal_type *decimal) {
+  int exponent = 0;
+  if (decimal->digits_count > 0) {
+    exponent = decimal->digits_count - 1 - decimal->scale;
+  }
+  return exponent;
+}
+/**
+ * @brief Returns the digit of a decimal at a power of ten.
+ *
+ * @param decimal Pointer to the decimal.
+ * @param power The power of ten of the digit.
+ * @return The digit, 0 outside of the stored digits.
+ */
+int s21_decimal_digit(const decimal_type *decimal, int power) {
+  int digit = 0;
+  long index = (long)power + decimal->scale;
+  if (index >= 0 && index < decimal->digits_count) {
+    digit = (int)(decimal->mantissa.limbs[index / S21_BIGNUM_BASE_DIGITS] /
+                  s21_pow10[index % S21_BIGNUM_BASE_DIGITS] % 10);
+  }
+  return digit;
+}
+/**
+ * @brief Checks whether a decimal has nonzero digits below a power of ten.
+ *
+ * @param decimal Pointer to the decimal.
+ * @param power The power of ten, digits strictly below it are checked.
+ * @return 1 if any of those digits is nonzero, otherwise 0.
+ */
+int s21_decimal_nonzero_below(const decimal_type *decimal, int power) {
+  int nonzero = 0;
+  long index = (long)power + decimal->scale;
+  if (index > decimal->digits_count) index = decimal->digits_count;
+  if (index > 0) {
+    int limb = (int)(index / S21_BIGNUM_BASE_DIGITS);
+    int rest = (int)(index % S21_BIGNUM_BASE_DIGITS);
+    for (int i = 0; i < limb && !nonzero; i++) {
+      nonzero = decimal->mantissa.limbs[i] != 0;
+    }
+    if (!nonzero && rest && limb < decimal->mantissa.size) {
+      nonzero = decimal->mantissa.limbs[limb] % s21_pow10[rest] != 0;
+    }
+  }
+  return nonzero;
+}
+/**
+ * @brief Reads the digits of a decimal between two powers of ten as an
+ * integer.
+ *
+ * @param decimal Pointer to the decimal.
+ * @param top The power of ten of the most significant digit to read.
+ * @param power The power of ten of the least significant digit to read, at
+ * most 19 digits are read.
+ * @return The integer formed by the digits.
+ */
+unsigned long long s21_decimal_truncate(const decimal_type *decimal, int top,
+                                        int power) {
+  unsigned long long result = 0;
+  for (int i = top; i >= power; i--) {
+    result = result * 10 + s21_decimal_digit(decimal, i);
+  }
+  return result;
+}
+// __Digits__
+/**
+ * @brief Writes the leading digits of a decimal rounded to 'count' significant
+ * digits, halfway cases are rounded to even.
+ *
+ * @param decimal Pointer to the decimal.
+ * @param count The number of significant digits, 0 keeps only a possible
+ * carry and a negative count produces no digits.
+ * @param digits The buffer for the digits, it must hold count + 1 characters.
+ * @param exponent Pointer to the power of ten of the first written digit,
+ * adjusted when rounding carries into a new digit.
+ * @return The number of digits written.
+ */
+int s21_decimal_round(const decimal_type *decimal, int count, char *digits,
+                      int *exponent) {
+  int top = s21_decimal_exponent(decimal), length = 0;
+  if (count > 0) {
+    for (; length < count; length++) {
+      digits[length] = (char)('0' + s21_decimal_digit(decimal, top - length));
+    }
+    if (s21_decimal_round_up(decimal, top - count, digits[count - 1] - '0')) {
+      int position = count - 1;
+      while (position >= 0 && digits[position] == '9') {
+        digits[position--] = '0';
+      }
+      if (position >= 0) {
+        digits[position] = (char)(digits[position] + 1);
+      } else {
+        // 9.99 -> 10.0: the number of digits stays the same
+        digits[0] = '1';
+        top += 1;
+      }
+    }
+  } else if (count == 0 && s21_decimal_round_up(decimal, top, 0)) {
+    digits[length++] = '1';
+    top += 1;
+  }
+  digits[length] = '\0';
+  *exponent = top;
+  return length;
+}
+/**
+ * @brief Decides whether digits kept above a power of ten round up.
+ *
+ * @param decimal Pointer to the decimal.
+ * @param power The power of ten of the first dropped digit.
+ * @param last_digit The last kept digit, used for halfway cases.
+ * @return 1 if the kept digits have to be incremented, otherwise 0.
+ */
+int s21_decimal_round_up(const decimal_type *decimal, int power,
+                         int last_digit) {
+  int digit = s21_decimal_digit(decimal, power), up = 0;
+  if (digit > 5) {
+    up = 1;
+  } else if (digit == 5) {
+    up = s21_decimal_nonzero_below(decimal, power) || (last_digit % 2);
+  }
+  return up;
+}
+/**
+ * @brief Finds the shortest digits that read back to the same double.
+ *
+ * Every number strictly between the halfway points to the neighbouring doubles
+ * rounds to 'value', the halfway points themselves do when the mantissa is
+ * even. The digits are searched from one digit up, and among the candidates of
+ * the first length that fits the one closest to 'value' is taken.
+ *
+ * @param value Finite positive double.
+ * @param digits The buffer for the digits, at least S21_SHORTEST_MAX_DIGITS + 2
+ * characters.
+ * @param exponent Pointer to the power of ten of the first digit.
+ * @return The number of digits written.
+ */
+int s21_decimal_shortest(double value, char *digits, int *exponent) {
+  decimal_type low, high, exact;
+  int binary_exponent = 0, top = 0, length = 0, inclusive = 0;
+  unsigned long long mantissa = 0, best = 0;
+  const int min_exponent = DBL_MIN_EXP - DBL_MANT_DIG;
+  mantissa = (unsigned long long)ldexp(frexp(value, &binary_exponent),
+                                       DBL_MANT_DIG);
+  binary_exponent -= DBL_MANT_DIG;
+  if (binary_exponent < min_exponent) {
+    mantissa >>= min_exponent - binary_exponent;
+    binary_exponent = min_exponent;
+  }
+  inclusive = (mantissa % 2 == 0);
+  s21_decimal_from_binary(mantissa, binary_exponent, &exact);
+  s21_decimal_from_binary(2 * mantissa + 1, binary_exponent - 1, &high);
+  if (mantissa == 1ULL << (DBL_MANT_DIG - 1) &&
+      binary_exponent > min_exponent) {
+    s21_decimal_from_binary(4 * mantissa - 1, binary_exponent - 2, &low);
+  } else {
+    s21_decimal_from_binary(2 * mantissa - 1, binary_exponent - 1, &low);
+  }
+  top = s21_decimal_exponent(&high);
+  for (int count = 1; count <= S21_SHORTEST_MAX_DIGITS + 1 && !length;
+       count++) {
+    int power = top - count + 1;
+    unsigned long long lowest = s21_decimal_truncate(&low, top, power);
+    unsigned long long highest = s21_decimal_truncate(&high, top, power);
+    if (s21_decimal_nonzero_below(&low, power) || !inclusive) lowest += 1;
+    if (!s21_decimal_nonzero_below(&high, power) && !inclusive) highest -= 1;
+    if (lowest <= highest) {
+      best = s21_decimal_truncate(&exact, top, power);
+      best += s21_decimal_round_up(&exact, power - 1, (int)(best % 10));
+      if (best < lowest) best = lowest;
+      if (best > highest) best = highest;
+      length = s21_ull_to_digits(best, digits);
+      *exponent = power + length - 1;
+    }
+  }
+  while (length > 1 && digits[length - 1] == '0') {
+    digits[--length] = '\0';
+  }
+  return length;
+}
+/**
+ * @brief Writes the decimal digits of an unsigned 64-bit value.
+ *
+ * @param value The value to convert.
+ * @param digits The buffer for the digits, at least 21 characters.
+ * @return The number of digits written.
+ */
+int s21_ull_to_digits(unsigned long long value, char *digits) {
+  char reverse_str[21] = {0};
+  int length = 0;
+  do {
+    reverse_str[length++] = (char)('0' + value % 10);
+    value /= 10;
+  } while (value);
+  for (int i = 0; i < length; i++) {
+    digits[i] = reverse_str[length - 1 - i];
+  }
+  digits[length] = '\0';
+  return length;
+}
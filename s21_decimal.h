@@ -0,0 +1,75 @@
+/**
+ * @file s21_decimal.h
+ * @brief Header file defining the exact binary to decimal conversion engine.
+ *
+ * This header file declares the types and functions used to turn a floating
+ * point number into decimal digits without losing precision. The engine is
+ * used by the %f, %e and %g conversions of s21_sprintf and by s21_dtoa.
+ *
+ * Structures:
+ * - bignum_type: Unsigned big integer stored in base 10^9 limbs, least
+ * significant limb first.
+ * - decimal_type: Exact decimal value of a float, mantissa / 10^scale.
+ *
+ * Included functionalities:
+ * - Exact conversion of any finite long double (s21_decimal_from_float) or of
+ * an integer mantissa and binary exponent (s21_decimal_from_binary).
+ * - Precision driven digits: s21_decimal_round rounds the exact value to any
+ * number of significant digits, half to even, like glibc does.
+ * - Shortest round trip digits of a double: s21_decimal_shortest finds the
+ * shortest digit string that reads back to the same double.
+ *
+ * All storage lives in the structures themselves, nothing is allocated on the
+ * heap.
+ */
+#ifndef SRC_S21_DECIMAL_H_
+#define SRC_S21_DECIMAL_H_
+
+#include "s21_string.h"
+
+#define S21_BIGNUM_BASE 1000000000U
+#define S21_BIGNUM_BASE_DIGITS 9
+// 5^16509 * 2^113 has about 11600 decimal digits
+#define S21_BIGNUM_LIMBS 1320
+// the largest factors one limb multiplication can take
+#define S21_BIGNUM_POW2_STEP 28
+#define S21_BIGNUM_POW5_STEP 13
+#define S21_SHORTEST_MAX_DIGITS 17
+
+typedef struct bignum {
+  int size;  // limbs in use, 0 for zero
+  unsigned int limbs[S21_BIGNUM_LIMBS];
+} bignum_type;
+
+typedef struct decimal {
+  bignum_type mantissa;
+  int scale;         // the value is mantissa / 10^scale
+  int digits_count;  // decimal digits of mantissa, 0 for zero
+} decimal_type;
+
+// __Big integers__
+void s21_bignum_set(bignum_type *num, unsigned long long value);
+void s21_bignum_mul_small(bignum_type *num, unsigned int factor);
+void s21_bignum_add_small(bignum_type *num, unsigned int value);
+void s21_bignum_mul_pow2(bignum_type *num, int power);
+void s21_bignum_mul_pow5(bignum_type *num, int power);
+int s21_bignum_digits_count(const bignum_type *num);
+// __Decimal conversion__
+void s21_decimal_from_float(long double value, decimal_type *decimal);
+void s21_decimal_from_binary(unsigned long long mantissa, int exponent,
+                             decimal_type *decimal);
+void s21_decimal_scale(decimal_type *decimal, int exponent);
+int s21_decimal_exponent(const decimal_type *decimal);
+int s21_decimal_digit(const decimal_type *decimal, int power);
+int s21_decimal_nonzero_below(const decimal_type *decimal, int power);
+unsigned long long s21_decimal_truncate(const decimal_type *decimal, int top,
+                                        int power);
+// __Digits__
+int s21_decimal_round(const decimal_type *decimal, int count, char *digits,
+                      int *exponent);
+int s21_decimal_round_up(const decimal_type *decimal, int power,
+                         int last_digit);
+int s21_decimal_shortest(double value, char *digits, int *exponent);
+int s21_ull_to_digits(unsigned long long value, char *digits);
+
+#endif  // SRC_S21_DECIMAL_H_
@@ -0,0 +1,117 @@
+/**
+ * @file s21_dispatch.c
+ * @brief Implementation of the run-time selection of the string kernels.
+ *
+ * The active table is resolved on the first call of s21_kernels and kept in
+ * an atomic pointer, so later calls cost one load. Threads that race on the
+ * first call resolve the same table, whichever store lands last.
+ *
+ * @note Nothing here may call s21_memcpy, s21_memset, s21_strlen, s21_memchr
+ * or the search, they dispatch through s21_kernels themselves.
+ */
+#include "s21_dispatch.h"
+
+#include <stdatomic.h>
+
+static _Atomic(const kernels_type *) s21_active_kernels = s21_NULL;
+
+// the best backend first, s21_kernels_swar runs everywhere
+static const kernels_type *const s21_kernels_list[] = {
+#if defined(S21_KERNELS_X86)
+    &s21_kernels_avx2,
+    &s21_kernels_sse2,
+#elif defined(S21_KERNELS_ARM)
+    &s21_kernels_neon,
+#endif
+    &s21_kernels_swar};
+
+#define S21_KERNELS_COUNT \
+  (sizeof(s21_kernels_list) / sizeof(s21_kernels_list[0]))
+
+/**
+ * @brief Returns the kernels the string functions run on, resolving them on
+ * the first call.
+ *
+ * @return Pointer to the active table, never s21_NULL.
+ */
+const kernels_type *s21_kernels(void) {
+  const kernels_type *kernels =
+      atomic_load_explicit(&s21_active_kernels, memory_order_acquire);
+  if (!kernels) {
+    kernels = s21_kernels_resolve();
+    atomic_store_explicit(&s21_active_kernels, kernels, memory_order_release);
+  }
+  return kernels;
+}
+/**
+ * @brief Picks the kernels named by S21_KERNELS, or else the best ones the
+ * CPU supports.
+ *
+ * @return Pointer to the chosen table.
+ */
+const kernels_type *s21_kernels_resolve(void) {
+  const kernels_type *kernels = s21_kernels_find(getenv("S21_KERNELS"));
+  for (s21_size_t i = 0; !kernels && i < S21_KERNELS_COUNT; i++) {
+    if (s21_kernels_supported(s21_kernels_list[i])) {
+      kernels = s21_kernels_list[i];
+    }
+  }
+  return kernels;
+}
+/**
+ * @brief Looks up a backend built into the library by name.
+ *
+ * @param name "avx2", "sse2", "neon" or "swar", may be s21_NULL.
+ * @return Pointer to the table, or s21_NULL if the name is unknown or the CPU
+ * does not support the backend.
+ */
+const kernels_type *s21_kernels_find(const char *name) {
+  const kernels_type *kernels = s21_NULL;
+  for (s21_size_t i = 0; name && !kernels && i < S21_KERNELS_COUNT; i++) {
+    if (!s21_strcmp(name, s21_kernels_list[i]->name) &&
+        s21_kernels_supported(s21_kernels_list[i])) {
+      kernels = s21_kernels_list[i];
+    }
+  }
+  return kernels;
+}
+/**
+ * @brief Checks whether the running CPU can execute a backend.
+ *
+ * @param kernels Pointer to a table of s21_kernels_list.
+ * @return 1 if the backend can run, otherwise 0.
+ */
+int s21_kernels_supported(const kernels_type *kernels) {
+  int supported = 1;
+#if defined(S21_KERNELS_X86) && defined(__GNUC__)
+  // also false when the OS does not save the AVX registers
+  if (kernels == &s21_kernels_avx2) supported = __builtin_cpu_supports("avx2");
+#elif defined(S21_KERNELS_X86)
+  if (kernels == &s21_kernels_avx2) supported = 0;
+#else
+  (void)kernels;
+#endif
+  return supported;
+}
+/**
+ * @brief Switches the string functions to another backend.
+ *
+ * @param name "avx2", "sse2", "neon" or "swar", s21_NULL for the automatic
+ * choice.
+ * @return 0 on success, 1 if the backend is not built in or not supported, in
+ * which case the active one is kept.
+ */
+int s21_kernels_select(const char *name) {
+  const kernels_type *kernels =
+      name ? s21_kernels_find(name) : s21_kernels_resolve();
+  if (kernels) {
+    atomic_store_explicit(&s21_active_kernels, kernels, memory_order_release);
+  }
+  return kernels == s21_NULL;
+}
+/**
+ * @brief Returns the name of the backend the string functions run on.
+ *
+ * @return "avx2", "sse2", "neon" or "swar".
+ */
+const char *s21_kernels_name(void) { return s21_kernels()->name; }
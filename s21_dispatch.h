@@ -0,0 +1,58 @@
+/**
+ * @file s21_dispatch.h
+ * @brief Header file defining the run-time selection of the string kernels.
+ *
+ * The hot kernels of s21_string.c and s21_search.c are built once per backend
+ * of s21_simd.h, whatever flags the library is compiled with, and the best one
+ * the running CPU supports is picked on the first call:
+ * - x86-64: AVX2 when the CPU and the OS support it, otherwise SSE2;
+ * - AArch64: NEON;
+ * - anything else, and builds with -DS21_NO_SIMD: SWAR.
+ *
+ * The S21_KERNELS environment variable ("avx2", "sse2", "neon" or "swar")
+ * overrides the choice, and s21_kernels_select switches it at run time.
+ *
+ * Structures:
+ * - kernels_type: One backend, its name and a function pointer per kernel.
+ */
+#ifndef SRC_S21_DISPATCH_H_
+#define SRC_S21_DISPATCH_H_
+
+#include "s21_search.h"
+#include "s21_string.h"
+
+// copies and fills from this size on bypass the caches, -D to tune
+#ifndef S21_STREAM_THRESHOLD
+#define S21_STREAM_THRESHOLD (4ULL << 20)
+#endif
+
+typedef struct kernels {
+  const char *name;  // "avx2", "sse2", "neon" or "swar"
+  void *(*memcpy)(void *dest, const void *src, s21_size_t n);
+  void *(*memmove)(void *dest, const void *src, s21_size_t n);
+  void *(*memset)(void *str, int c, s21_size_t n);
+  s21_size_t (*strlen)(const char *str);
+  void *(*memchr)(const void *str, int c, s21_size_t n);
+  s21_size_t (*search_short)(haystack_type *haystack,
+                             const unsigned char *needle,
+                             s21_size_t needle_len);
+} kernels_type;
+
+// one table per backend built into the library, see s21_kernels_*.c
+extern const kernels_type s21_kernels_swar;
+#if !defined(S21_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+#define S21_KERNELS_X86
+extern const kernels_type s21_kernels_sse2;
+extern const kernels_type s21_kernels_avx2;
+#elif !defined(S21_NO_SIMD) && defined(__aarch64__)
+#define S21_KERNELS_ARM
+extern const kernels_type s21_kernels_neon;
+#endif
+
+// __Dispatch__
+const kernels_type *s21_kernels(void);
+const kernels_type *s21_kernels_resolve(void);
+const kernels_type *s21_kernels_find(const char *name);
+int s21_kernels_supported(const kernels_type *kernels);
+
+#endif  // SRC_S21_DISPATCH_H_
@@ -0,0 +1,433 @@
+/**
+ * @file s21_fuzz.c
+ * @brief Differential fuzzer comparing s21_snprintf and s21_sscanf with the C
+ * library.
+ *
+ * Every input is read as a sequence of cases. A case builds one conversion
+ * from the bytes it consumes, the flags, width, precision, length modifier and
+ * specifier of a format, or the format and the text of a scan, takes its
+ * value from the next bytes and runs it through the s21_ function and its C
+ * library counterpart. Any difference in the output, the return value, the
+ * stored value or the characters consumed is printed and aborts the process,
+ * so libFuzzer and AFL record the input as a crash.
+ *
+ * Builds:
+ * - libFuzzer: `make fuzz`, clang with -fsanitize=fuzzer and
+ * -DS21_FUZZ_LIBFUZZER, which provides its own main.
+ * - AFL: afl-clang-fast without S21_FUZZ_LIBFUZZER, run as `s21_fuzz @@`.
+ * - Standalone: `make fuzz_smoke`, any compiler, random inputs.
+ *
+ * Usage of the standalone build:
+ *   s21_fuzz [--runs=N] [--seed=N] [FILE...]
+ * Files are replayed one input each; without files, --runs random inputs
+ * are generated from --seed.
+ *
+ * @note Cases where s21_sprintf deliberately differs from glibc are not
+ * generated: "%%" with flags or a width, which the C standard leaves undefined,
+ * %p of a null pointer, which glibc prints as "(nil)", the "hh" and "ll"
+ * modifiers s21_sprintf does not support and scan sets with a '-', whose
+ * ranges are implementation-defined. A scan where glibc consumes a dangling
+ * exponent or "0x" prefix that s21_sscanf leaves in the input, such as the "e"
+ * of "1e", the "p" of "0x1p" or the "x" of "0x", is not a difference either:
+ * glibc cannot push back more than one character, and fails a float
+ * conversion on a "0x" that has no hexadecimal digit after it.
+ */
+#define _GNU_SOURCE
+
+#include <stdint.h>
+#include <string.h>
+
+#include "s21_string.h"
+
+#define FUZZ_OUTPUT_SIZE 512
+#define FUZZ_FORMAT_SIZE 64
+#define FUZZ_MAX_WIDTH 64
+#define FUZZ_MAX_PRECISION 40
+#define FUZZ_MAX_TEXT 24  // characters of a %s argument or of a scan input
+#define FUZZ_MAX_INPUT (1 << 20)  // bytes of a replayed file
+#define FUZZ_RUNS 10000
+#define FUZZ_RANDOM_SIZE 256  // longest random input of the standalone build
+
+typedef struct fuzz_input {
+  const uint8_t *data;
+  size_t size;
+  size_t position;  // next byte to consume
+} fuzz_input_type;
+
+typedef union fuzz_value {
+  long long integer;
+  double real;
+  long double extended;
+  char text[FUZZ_MAX_WIDTH + 1];
+} fuzz_value_type;
+
+// __Input__
+/**
+ * @brief Consumes one byte of the input.
+ *
+ * @param input Pointer to the input.
+ * @return The byte, 0 past the end of the input.
+ */
+static unsigned fuzz_byte(fuzz_input_type *input) {
+  return input->position < input->size ? input->data[input->position++] : 0;
+}
+/**
+ * @brief Consumes bytes of the input as a little-endian integer.
+ *
+ * @param input Pointer to the input.
+ * @param bytes Number of bytes, at most 8.
+ * @return The integer.
+ */
+static unsigned long long fuzz_bits(fuzz_input_type *input, int bytes) {
+  unsigned long long value = 0;
+  for (int i = 0; i < bytes; i++) {
+    value |= (unsigned long long)fuzz_byte(input) << (8 * i);
+  }
+  return value;
+}
+/**
+ * @brief Consumes a double, either raw bits or a short decimal value.
+ *
+ * @param input Pointer to the input.
+ * @return The value, never a NaN.
+ */
+static double fuzz_double(fuzz_input_type *input) {
+  double value = 0;
+  if (fuzz_byte(input) & 1) {
+    unsigned long long bits = fuzz_bits(input, 8);
+    memcpy(&value, &bits, sizeof(value));
+    if (value != value) value = 0;
+  } else {
+    long long mantissa = (long long)(int32_t)fuzz_bits(input, 4);
+    int scale = (int)(fuzz_byte(input) % 40) - 20;
+    value = (double)mantissa;
+    for (; scale > 0; scale--) value *= 10;
+    for (; scale < 0; scale++) value /= 10;
+  }
+  return value;
+}
+/**
+ * @brief Consumes a short text made of the characters of an alphabet.
+ *
+ * @param input Pointer to the input.
+ * @param alphabet The characters to pick from.
+ * @param text Buffer of FUZZ_MAX_TEXT + 1 bytes, null-terminated.
+ */
+static void fuzz_text(fuzz_input_type *input, const char *alphabet,
+                      char *text) {
+  size_t count = strlen(alphabet);
+  unsigned length = fuzz_byte(input) % (FUZZ_MAX_TEXT + 1);
+  for (unsigned i = 0; i < length; i++) {
+    text[i] = alphabet[fuzz_byte(input) % count];
+  }
+  text[length] = '\0';
+}
+/**
+ * @brief Reports a difference and aborts.
+ *
+ * @param format The format of the case.
+ * @param text The scanned text, s21_NULL for a sprintf case.
+ * @param what The part of the results that differs.
+ * @param expected The result of the C library.
+ * @param got The result of s21_.
+ */
+static void fuzz_fail(const char *format, const char *text, const char *what,
+                      const char *expected, const char *got) {
+  fprintf(stderr, "mismatch in %s\n  format: \"%s\"\n", what, format);
+  if (text) fprintf(stderr, "  input:  \"%s\"\n", text);
+  fprintf(stderr, "  libc:   \"%s\"\n  s21:    \"%s\"\n", expected, got);
+  abort();
+}
+// __Cases__
+/**
+ * @brief Appends a flag, width and precision part of a conversion.
+ *
+ * @param input Pointer to the input.
+ * @param format The format being built, of FUZZ_FORMAT_SIZE bytes.
+ * @param flags The characters allowed as flags.
+ */
+static void fuzz_modifiers(fuzz_input_type *input, char *format,
+                           const char *flags) {
+  unsigned mask = fuzz_byte(input);
+  unsigned width = fuzz_byte(input), precision = fuzz_byte(input);
+  char *end = format + strlen(format);
+  for (int i = 0; flags[i]; i++) {
+    if (mask & (1u << i)) *end++ = flags[i];
+  }
+  *end = '\0';
+  if (width & 0x80) {
+    end += sprintf(end, "%u", width % FUZZ_MAX_WIDTH);
+  }
+  if (precision & 0x80) {
+    end += sprintf(end, ".%u", precision % FUZZ_MAX_PRECISION);
+  } else if (precision & 0x40) {
+    end += sprintf(end, ".");
+  }
+}
+/**
+ * @brief Runs one random conversion through s21_snprintf and snprintf.
+ *
+ * @param input Pointer to the input.
+ */
+static void fuzz_sprintf(fuzz_input_type *input) {
+  static const char specifiers[] = "diouxXcsfeEgGp%";
+  static const char *integer_lengths[] = {"", "h", "l"};
+  char specifier = specifiers[fuzz_byte(input) % (sizeof(specifiers) - 1)];
+  char format[FUZZ_FORMAT_SIZE] = "%";
+  char expected[FUZZ_OUTPUT_SIZE], got[FUZZ_OUTPUT_SIZE];
+  char text[FUZZ_MAX_TEXT + 1];
+  // a short size checks the truncation of snprintf
+  size_t size = fuzz_byte(input) & 1 ? fuzz_byte(input) % 16 : sizeof(got);
+  int a = 0, b = 0;
+  if (specifier != '%') fuzz_modifiers(input, format, "-+ #0");
+  if (strchr("diouxX", specifier)) {
+    unsigned long long value = fuzz_bits(input, 8);
+    int length = (int)(fuzz_byte(input) % 3);
+    strcat(format, integer_lengths[length]);
+    strncat(format, &specifier, 1);
+    if (length == 2) {
+      a = snprintf(expected, size, format, value);
+      b = s21_snprintf(got, size, format, value);
+    } else {
+      a = snprintf(expected, size, format, (int)value);
+      b = s21_snprintf(got, size, format, (int)value);
+    }
+  } else if (strchr("feEgG", specifier)) {
+    double value = fuzz_double(input);
+    int extended = fuzz_byte(input) & 1;
+    strcat(format, extended ? "L" : "");
+    strncat(format, &specifier, 1);
+    if (extended) {
+      a = snprintf(expected, size, format, (long double)value);
+      b = s21_snprintf(got, size, format, (long double)value);
+    } else {
+      a = snprintf(expected, size, format, value);
+      b = s21_snprintf(got, size, format, value);
+    }
+  } else if (specifier == 'c') {
+    int value = (int)(fuzz_byte(input) % 255) + 1;
+    strcat(format, "c");
+    a = snprintf(expected, size, format, value);
+    b = s21_snprintf(got, size, format, value);
+  } else if (specifier == 's') {
+    fuzz_text(input, "abc XYZ019%-._", text);
+    strcat(format, "s");
+    a = snprintf(expected, size, format, text);
+    b = s21_snprintf(got, size, format, text);
+  } else if (specifier == 'p') {
+    void *value = (void *)(uintptr_t)(fuzz_bits(input, sizeof(void *)) | 1);
+    strcat(format, "p");
+    a = snprintf(expected, size, format, value);
+    b = s21_snprintf(got, size, format, value);
+  } else {
+    strcat(format, "%");
+    a = snprintf(expected, size, format, 0);
+    b = s21_snprintf(got, size, format, 0);
+  }
+  if (a != b) {
+    char counts[2][16];
+    sprintf(counts[0], "%d", a);
+    sprintf(counts[1], "%d", b);
+    fuzz_fail(format, s21_NULL, "the return value", counts[0], counts[1]);
+  }
+  if (size && strcmp(expected, got)) {
+    fuzz_fail(format, s21_NULL, "the output", expected, got);
+  }
+}
+/**
+ * @brief Recognizes a scan that glibc ends after characters it cannot push
+ * back.
+ *
+ * @param text The scanned text.
+ * @param same_result 1 if both calls returned the same count.
+ * @param expected_count The %n of sscanf, -1 if not reached.
+ * @param got_count The %n of s21_sscanf, -1 if not reached.
+ * @return 1 if glibc also consumed a dangling exponent, "0x" or "0x.", 2 if it
+ * failed on a partial "infinity" after the "inf" s21_sscanf read or on the
+ * "x" of a float "0x" without hexadecimal digits after the "0", otherwise 0.
+ */
+static int fuzz_pushback(const char *text, int same_result,
+                         int expected_count, int got_count) {
+  int prefix = got_count >= 1 && text[got_count - 1] == '0' &&
+               (text[got_count] | 0x20) == 'x';  // glibc also takes "0x."
+  int pushback = 0;
+  if (same_result && got_count >= 0 && expected_count > got_count &&
+      s21_strspn(text + got_count, prefix ? "xX." : "eEpP+-xX") >=
+          (s21_size_t)(expected_count - got_count)) {
+    pushback = 1;
+  } else if (expected_count < 0 && got_count >= 3) {
+    const char *rest = text + got_count;
+    int matched = 0;
+    while (matched < 5 && (rest[matched] | 0x20) == "inity"[matched]) {
+      matched++;
+    }
+    if (matched && matched < 5 && (rest[-1] | 0x20) == 'f' &&
+        (rest[-2] | 0x20) == 'n' && (rest[-3] | 0x20) == 'i') {
+      pushback = 2;
+    }
+  }
+  if (expected_count < 0 && prefix) pushback = 2;
+  return pushback;
+}
+/**
+ * @brief Runs one random conversion through s21_sscanf and sscanf.
+ *
+ * @param input Pointer to the input.
+ */
+static void fuzz_sscanf(fuzz_input_type *input) {
+  static const char specifiers[] = "diouxXfegsc[";
+  static const char *integer_lengths[] = {"", "h", "hh", "l", "ll"};
+  static const char *float_lengths[] = {"", "l", "L"};
+  static const char alphabet[] = " \t+-0123456789abcdefxXeE.nNiIaAy";
+  static const char set_alphabet[] = "\t+0123456789abcdefxXeE.nNiIaAy";
+  static const char float_alphabet[] = " \t+-0123456789abcdefxXeEpP.nNiIaAy";
+  static const size_t integer_sizes[] = {sizeof(int), sizeof(short),
+                                         sizeof(char), sizeof(long),
+                                         sizeof(long long)};
+  static const size_t float_sizes[] = {sizeof(float), sizeof(double),
+                                       sizeof(long double)};
+  char specifier = specifiers[fuzz_byte(input) % (sizeof(specifiers) - 1)];
+  char format[FUZZ_FORMAT_SIZE] = "%";
+  char text[FUZZ_MAX_TEXT + 1];
+  fuzz_value_type expected, got;
+  int expected_count = -1, got_count = -1;
+  unsigned width = fuzz_byte(input);
+  size_t size = 0;
+  int suppress = (width & 0x40) != 0;
+  memset(&expected, 0, sizeof(expected));
+  memset(&got, 0, sizeof(got));
+  if (suppress) strcat(format, "*");
+  // %s and %[ always get a width, their buffer is FUZZ_MAX_WIDTH + 1 bytes
+  if ((width & 0x80) || strchr("s[", specifier)) {
+    sprintf(format + strlen(format), "%u", width % (FUZZ_MAX_WIDTH - 1) + 1);
+  }
+  if (strchr("diouxX", specifier)) {
+    int length = (int)(fuzz_byte(input) % 5);
+    strcat(format, integer_lengths[length]);
+    size = integer_sizes[length];
+  } else if (strchr("feg", specifier)) {
+    int length = (int)(fuzz_byte(input) % 3);
+    strcat(format, float_lengths[length]);
+    size = float_sizes[length];
+  } else {
+    size = sizeof(expected.text);
+  }
+  strncat(format, &specifier, 1);
+  if (specifier == '[') {
+    char set[FUZZ_MAX_TEXT + 1];
+    fuzz_text(input, set_alphabet, set);
+    if (fuzz_byte(input) & 1) strcat(format, "^");
+    strncat(format, "0", !set[0]);  // an empty set is not a scan set
+    strcat(format, set);
+    strcat(format, "]");
+  }
+  strcat(format, "%n");
+  fuzz_text(input, strchr("feg", specifier) ? float_alphabet : alphabet, text);
+  int a = suppress ? sscanf(text, format, &expected_count)
+                   : sscanf(text, format, &expected, &expected_count);
+  int b = suppress ? s21_sscanf(text, format, &got_count)
+                   : s21_sscanf(text, format, &got, &got_count);
+  char values[2][FUZZ_OUTPUT_SIZE];
+  int pushback = fuzz_pushback(text, a == b, expected_count, got_count);
+  if (pushback == 1) got_count = expected_count;
+  if (pushback == 2) {
+    // glibc failed on the rest of "infinity", s21 stored the "inf"
+  } else if (a != b || expected_count != got_count) {
+    sprintf(values[0], "%d, %%n %d", a, expected_count);
+    sprintf(values[1], "%d, %%n %d", b, got_count);
+    fuzz_fail(format, text, "the return value", values[0], values[1]);
+  }
+  if (pushback != 2 && memcmp(&expected, &got, size)) {
+    for (int i = 0; i < 2; i++) {
+      const unsigned char *bytes =
+          (const unsigned char *)(i ? (void *)&got : (void *)&expected);
+      for (size_t j = 0; j < size && j < 32; j++) {
+        sprintf(values[i] + 2 * j, "%02x", bytes[j]);
+      }
+    }
+    fuzz_fail(format, text, "the stored value", values[0], values[1]);
+  }
+}
+/**
+ * @brief Runs the cases of one input, the libFuzzer entry point.
+ *
+ * @param data Pointer to the input.
+ * @param size Length of the input.
+ * @return 0.
+ */
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  fuzz_input_type input = {data, size, 0};
+  while (input.position < input.size) {
+    if (fuzz_byte(&input) & 1) {
+      fuzz_sscanf(&input);
+    } else {
+      fuzz_sprintf(&input);
+    }
+  }
+  return 0;
+}
+
+#ifndef S21_FUZZ_LIBFUZZER
+// __Standalone__
+/**
+ * @brief Replays one input file.
+ *
+ * @param path Path of the file.
+ * @return 0 on success, 1 if the file could not be read.
+ */
+static int fuzz_replay(const char *path) {
+  FILE *file = fopen(path, "rb");
+  uint8_t *data = malloc(FUZZ_MAX_INPUT);
+  int status = 1;
+  if (file && data) {
+    size_t size = fread(data, 1, FUZZ_MAX_INPUT, file);
+    LLVMFuzzerTestOneInput(data, size);
+    status = 0;
+  }
+  if (file) fclose(file);
+  free(data);
+  return status;
+}
+/**
+ * @brief Replays the files of the command line, or runs random inputs.
+ *
+ * @param argc Number of arguments.
+ * @param argv Arguments, see the file description.
+ * @return 0 if no case differs, 1 if a file could not be read.
+ */
+int main(int argc, char **argv) {
+  long long runs = FUZZ_RUNS;
+  unsigned long long seed = 88172645463325252ULL;
+  int files = 0, status = 0;
+  for (int i = 1; i < argc; i++) {
+    if (!strncmp(argv[i], "--runs=", 7)) {
+      runs = atoll(argv[i] + 7);
+    } else if (!strncmp(argv[i], "--seed=", 7)) {
+      seed = strtoull(argv[i] + 7, s21_NULL, 10) * 2654435761ULL + 1;
+    } else {
+      files++;
+      if (fuzz_replay(argv[i])) {
+        fprintf(stderr, "s21_fuzz: cannot read %s\n", argv[i]);
+        status = 1;
+      }
+    }
+  }
+  for (long long run = 0; !files && run < runs; run++) {
+    uint8_t data[FUZZ_RANDOM_SIZE];
+    size_t size = 0;
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    size = seed % FUZZ_RANDOM_SIZE + 1;
+    for (size_t i = 0; i < size; i++) {
+      seed ^= seed << 13;
+      seed ^= seed >> 7;
+      seed ^= seed << 17;
+      data[i] = (uint8_t)(seed >> 56);
+    }
+    LLVMFuzzerTestOneInput(data, size);
+  }
+  if (!files) printf("s21_fuzz: %lld random inputs, no difference\n", runs);
+  return status;
+}
+#endif  // S21_FUZZ_LIBFUZZER
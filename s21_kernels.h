@@ -0,0 +1,266 @@
+/**
+ * @file s21_kernels.h
+ * @brief The string kernels, written once against s21_simd.h and built once
+ * per backend.
+ *
+ * Each s21_kernels_<backend>.c defines S21_SIMD_BACKEND, S21_KERNEL and
+ * S21_KERNELS_NAME and includes this header, which defines the kernels as
+ * static functions and exports them as the kernels_type table
+ * s21_kernels_<backend>. It must be included once per translation unit and
+ * only by those files.
+ *
+ * Included kernels:
+ * - memcpy, memmove and memset: overlapping unaligned units up to two blocks,
+ * stores aligned on the destination up to S21_STREAM_THRESHOLD bytes and
+ * non-temporal stores beyond, where the backend has them.
+ * - strlen: aligned blocks, which never cross a page.
+ * - memchr: unaligned blocks inside the buffer, the tail byte by byte.
+ * - search_short: the first and last byte filter of s21_search.c.
+ */
+#ifndef SRC_S21_KERNELS_H_
+#define SRC_S21_KERNELS_H_
+
+#include "s21_dispatch.h"
+#include "s21_simd.h"
+
+/**
+ * @brief Copies more than two blocks front to back: the first and last blocks
+ * unaligned, the rest with stores aligned on the destination.
+ *
+ * The first and last blocks are loaded up front and stored last, so the copy
+ * is correct when dest is below an overlapping src.
+ *
+ * @param dest Pointer to the destination.
+ * @param src Pointer to the source.
+ * @param n Number of bytes, above 2 * S21_BLOCK_SIZE.
+ * @param stream 1 to store the aligned part around the caches.
+ */
+static S21_TARGET void S21_KERNEL(copy_forward)(unsigned char *dest,
+                                                const unsigned char *src,
+                                                s21_size_t n, int stream) {
+  s21_block_type head = s21_block_load(src);
+  s21_block_type tail = s21_block_load(src + n - S21_BLOCK_SIZE);
+  s21_size_t i = S21_BLOCK_SIZE - (uintptr_t)dest % S21_BLOCK_SIZE;
+  if (stream) {
+    for (; i + S21_BLOCK_SIZE <= n; i += S21_BLOCK_SIZE) {
+      s21_block_stream(dest + i, s21_block_load(src + i));
+    }
+    s21_stream_fence();
+  } else {
+    for (; i + S21_BLOCK_SIZE <= n; i += S21_BLOCK_SIZE) {
+      s21_block_store_aligned(dest + i, s21_block_load(src + i));
+    }
+  }
+  s21_block_store(dest, head);
+  s21_block_store(dest + n - S21_BLOCK_SIZE, tail);
+}
+/**
+ * @brief Copies more than two blocks back to front, for dest above an
+ * overlapping src.
+ *
+ * @param dest Pointer to the destination.
+ * @param src Pointer to the source.
+ * @param n Number of bytes, above 2 * S21_BLOCK_SIZE.
+ */
+static S21_TARGET void S21_KERNEL(copy_backward)(unsigned char *dest,
+                                                 const unsigned char *src,
+                                                 s21_size_t n) {
+  s21_block_type head = s21_block_load(src);
+  s21_block_type tail = s21_block_load(src + n - S21_BLOCK_SIZE);
+  s21_size_t i = n - (uintptr_t)(dest + n) % S21_BLOCK_SIZE;
+  while (i > S21_BLOCK_SIZE) {
+    i -= S21_BLOCK_SIZE;
+    s21_block_store_aligned(dest + i, s21_block_load(src + i));
+  }
+  s21_block_store(dest, head);
+  s21_block_store(dest + n - S21_BLOCK_SIZE, tail);
+}
+/**
+ * @brief Copies up to two blocks with loads that all happen before the
+ * stores, so the regions may overlap.
+ *
+ * @param dest Pointer to the destination.
+ * @param src Pointer to the source.
+ * @param n Number of bytes, at most 2 * S21_BLOCK_SIZE.
+ */
+static S21_TARGET void S21_KERNEL(copy_small)(unsigned char *dest,
+                                              const unsigned char *src,
+                                              s21_size_t n) {
+  if (n < S21_BLOCK_SIZE) {
+    s21_copy_short(dest, src, n);
+  } else {
+    s21_block_type head = s21_block_load(src);
+    s21_block_type tail = s21_block_load(src + n - S21_BLOCK_SIZE);
+    s21_block_store(dest, head);
+    s21_block_store(dest + n - S21_BLOCK_SIZE, tail);
+  }
+}
+/**
+ * @brief Copies n bytes from src to dest: overlapping loads and stores up to
+ * two blocks, aligned blocks up to S21_STREAM_THRESHOLD and streaming stores
+ * beyond it.
+ *
+ * @param dest Pointer to the destination, must not overlap src.
+ * @param src Pointer to the source.
+ * @param n Number of bytes to copy.
+ * @return dest.
+ */
+static S21_TARGET void *S21_KERNEL(memcpy)(void *dest, const void *src,
+                                           s21_size_t n) {
+  if (n <= 2 * S21_BLOCK_SIZE) {
+    S21_KERNEL(copy_small)(dest, src, n);
+  } else {
+    S21_KERNEL(copy_forward)(dest, src, n, n >= S21_STREAM_THRESHOLD);
+  }
+  return dest;
+}
+/**
+ * @brief Copies n bytes from src to dest, the regions may overlap.
+ *
+ * @param dest Pointer to the destination.
+ * @param src Pointer to the source.
+ * @param n Number of bytes to copy.
+ * @return dest.
+ */
+static S21_TARGET void *S21_KERNEL(memmove)(void *dest, const void *src,
+                                            s21_size_t n) {
+  uintptr_t ahead = (uintptr_t)dest - (uintptr_t)src;
+  uintptr_t behind = (uintptr_t)src - (uintptr_t)dest;
+  if (n <= 2 * S21_BLOCK_SIZE) {
+    S21_KERNEL(copy_small)(dest, src, n);
+  } else if (ahead >= n) {
+    // dest is below src or past its end: front to back is safe
+    S21_KERNEL(copy_forward)(dest, src, n,
+                             behind >= n && n >= S21_STREAM_THRESHOLD);
+  } else {
+    S21_KERNEL(copy_backward)(dest, src, n);
+  }
+  return dest;
+}
+/**
+ * @brief Fills n bytes of str with the byte c: overlapping stores up to two
+ * blocks, aligned blocks up to S21_STREAM_THRESHOLD and streaming stores
+ * beyond it.
+ *
+ * @param str Pointer to the memory to fill.
+ * @param c The byte value, converted to unsigned char.
+ * @param n Number of bytes to fill.
+ * @return str.
+ */
+static S21_TARGET void *S21_KERNEL(memset)(void *str, int c, s21_size_t n) {
+  unsigned char *out = str;
+  s21_block_type fill = s21_block_splat((unsigned char)c);
+  if (n < S21_BLOCK_SIZE) {
+    s21_fill_short(out, (unsigned char)c, n);
+  } else {
+    s21_size_t i = S21_BLOCK_SIZE - (uintptr_t)out % S21_BLOCK_SIZE;
+    s21_block_store(out, fill);
+    if (n >= S21_STREAM_THRESHOLD) {
+      for (; i + S21_BLOCK_SIZE <= n; i += S21_BLOCK_SIZE) {
+        s21_block_stream(out + i, fill);
+      }
+      s21_stream_fence();
+    } else {
+      for (; i + S21_BLOCK_SIZE <= n; i += S21_BLOCK_SIZE) {
+        s21_block_store_aligned(out + i, fill);
+      }
+    }
+    s21_block_store(out + n - S21_BLOCK_SIZE, fill);
+  }
+  return str;
+}
+/**
+ * @brief Measures a null-terminated string an aligned block at a time.
+ *
+ * @param str Pointer to the string.
+ * @return The number of bytes before the '\0'.
+ */
+static S21_TARGET s21_size_t S21_KERNEL(strlen)(const char *str) {
+  const char *block = str - (uintptr_t)str % S21_BLOCK_SIZE;
+  s21_block_type zero = s21_block_splat(0);
+  unsigned long long mask =
+      s21_mask_from(s21_block_eq(s21_block_load(block), zero), str - block);
+  while (!mask) {
+    block += S21_BLOCK_SIZE;
+    mask = s21_block_eq(s21_block_load(block), zero);
+  }
+  return block + s21_mask_first(mask) - str;
+}
+/**
+ * @brief Finds the first byte c in the first n bytes of str.
+ *
+ * @param str Pointer to the memory to scan.
+ * @param c The byte value, converted to unsigned char.
+ * @param n Number of bytes to scan.
+ * @return Pointer to the byte, or s21_NULL.
+ */
+static S21_TARGET void *S21_KERNEL(memchr)(const void *str, int c,
+                                           s21_size_t n) {
+  const unsigned char *ptr = str;
+  const unsigned char *end = ptr + n;
+  s21_block_type pattern = s21_block_splat((unsigned char)c);
+  unsigned long long mask = 0;
+  void *result = s21_NULL;
+  while (!mask && end - ptr >= S21_BLOCK_SIZE) {
+    mask = s21_block_eq(s21_block_load(ptr), pattern);
+    if (!mask) ptr += S21_BLOCK_SIZE;
+  }
+  if (mask) {
+    result = (void *)(ptr + s21_mask_first(mask));
+  } else {
+    for (; ptr < end && !result; ptr++) {
+      if (*ptr == (unsigned char)c) result = (void *)ptr;
+    }
+  }
+  return result;
+}
+/**
+ * @brief Searches a short needle with the first and last byte block filter.
+ *
+ * A block of window starts is compared against the first needle byte and the
+ * block S21_BLOCK_SIZE - 1 bytes further against the last one. Only starts
+ * where both match are compared in full, which costs at most
+ * S21_SHORT_NEEDLE bytes each, so the search stays linear.
+ *
+ * @param haystack Pointer to the haystack.
+ * @param needle Pointer to the needle bytes.
+ * @param needle_len Length of the needle, 1 to S21_SHORT_NEEDLE.
+ * @return Offset of the occurrence, or S21_NOT_FOUND.
+ */
+static S21_TARGET s21_size_t S21_KERNEL(search_short)(
+    haystack_type *haystack, const unsigned char *needle,
+    s21_size_t needle_len) {
+  s21_block_type first = s21_block_splat(needle[0]);
+  s21_block_type last = s21_block_splat(needle[needle_len - 1]);
+  s21_size_t result = S21_NOT_FOUND;
+  s21_size_t pos = 0;
+  while (result == S21_NOT_FOUND &&
+         s21_haystack_reach(haystack, pos + needle_len - 1 + S21_BLOCK_SIZE)) {
+    const unsigned char *window = haystack->data + pos;
+    unsigned long long mask =
+        s21_block_eq(s21_block_load(window), first) &
+        s21_block_eq(s21_block_load(window + needle_len - 1), last);
+    while (mask && result == S21_NOT_FOUND) {
+      s21_size_t start = s21_mask_first(mask);
+      if (needle_len < 3 || !s21_memcmp(window + start + 1, needle + 1,
+                                        needle_len - 2)) {
+        result = pos + start;
+      }
+      mask = s21_mask_next(mask);
+    }
+    pos += S21_BLOCK_SIZE;
+  }
+  while (result == S21_NOT_FOUND &&
+         s21_haystack_reach(haystack, pos + needle_len)) {
+    if (!s21_memcmp(haystack->data + pos, needle, needle_len)) result = pos;
+    pos++;
+  }
+  return result;
+}
+
+const kernels_type S21_KERNEL(kernels) = {
+    S21_KERNELS_NAME,   S21_KERNEL(memcpy), S21_KERNEL(memmove),
+    S21_KERNEL(memset), S21_KERNEL(strlen), S21_KERNEL(memchr),
+    S21_KERNEL(search_short)};
+
+#endif  // SRC_S21_KERNELS_H_
@@ -0,0 +1,14 @@
+/**
+ * @file s21_kernels_neon.c
+ * @brief The NEON build of the string kernels, see s21_kernels.h.
+ */
+#include "s21_dispatch.h"
+
+#ifdef S21_KERNELS_ARM
+#define S21_SIMD_BACKEND S21_BACKEND_NEON
+#define S21_KERNEL(name) s21_##name##_neon
+#define S21_KERNELS_NAME "neon"
+
+#include "s21_kernels.h"
+
+#endif  // S21_KERNELS_ARM
@@ -0,0 +1,14 @@
+/**
+ * @file s21_kernels_sse2.c
+ * @brief The SSE2 build of the string kernels, see s21_kernels.h.
+ */
+#include "s21_dispatch.h"
+
+#ifdef S21_KERNELS_X86
+#define S21_SIMD_BACKEND S21_BACKEND_SSE2
+#define S21_KERNEL(name) s21_##name##_sse2
+#define S21_KERNELS_NAME "sse2"
+
+#include "s21_kernels.h"
+
+#endif  // S21_KERNELS_X86
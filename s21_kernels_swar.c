@@ -0,0 +1,9 @@
+/**
+ * @file s21_kernels_swar.c
+ * @brief The portable SWAR build of the string kernels, see s21_kernels.h.
+ */
+#define S21_SIMD_BACKEND S21_BACKEND_SWAR
+#define S21_KERNEL(name) s21_##name##_swar
+#define S21_KERNELS_NAME "swar"
+
+#include "s21_kernels.h"
@@ -0,0 +1,185 @@
+/**
+ * @file s21_search.c
+ * @brief Implementation of the substring search engine.
+ *
+ * Two-Way splits the needle at a critical factorization u.v. Each window is
+ * checked by matching v left to right and then u right to left; a mismatch in
+ * v shifts the window past the mismatching byte, a full match of v shifts it
+ * by the period of the needle. The bytes matched in the previous window are
+ * remembered for periodic needles, so no haystack byte is compared more than
+ * twice and the search needs O(1) extra space.
+ *
+ * Function Overview:
+ * - s21_search: Picks the block filter or Two-Way for a needle.
+ * - s21_search_short: First and last byte block filter for short needles.
+ * - s21_search_two_way: The Two-Way scan.
+ * - s21_critical_factorization: Split point and period of a needle.
+ *
+ * @note The caller handles the empty needle.
+ */
+#include "s21_search.h"
+
+#include "s21_dispatch.h"
+
+// __Haystack__
+/**
+ * @brief Makes sure the first 'end' bytes of the haystack are known.
+ *
+ * A string haystack is measured S21_HAYSTACK_STEP bytes at a time, so the
+ * search never reads further than the window it is about to compare.
+ *
+ * @param haystack Pointer to the haystack.
+ * @param end The number of bytes the next comparison needs.
+ * @return 1 if the haystack has at least 'end' bytes, otherwise 0.
+ */
+int s21_haystack_reach(haystack_type *haystack, s21_size_t end) {
+  if (haystack->open && haystack->length < end) {
+    s21_size_t wanted = end - haystack->length;
+    if (wanted < S21_HAYSTACK_STEP) wanted = S21_HAYSTACK_STEP;
+    s21_size_t found =
+        s21_strnlen((const char *)haystack->data + haystack->length, wanted);
+    haystack->length += found;
+    haystack->open = found == wanted;
+  }
+  return end <= haystack->length;
+}
+// __Search__
+/**
+ * @brief Finds the first occurrence of a needle in a haystack.
+ *
+ * @param haystack Pointer to the haystack.
+ * @param needle Pointer to the needle bytes.
+ * @param needle_len Length of the needle, at least 1.
+ * @return Offset of the occurrence, or S21_NOT_FOUND.
+ */
+s21_size_t s21_search(haystack_type *haystack, const unsigned char *needle,
+                      s21_size_t needle_len) {
+  s21_size_t result = S21_NOT_FOUND;
+  if (needle_len <= S21_SHORT_NEEDLE) {
+    result = s21_search_short(haystack, needle, needle_len);
+  } else {
+    result = s21_search_two_way(haystack, needle, needle_len);
+  }
+  return result;
+}
+/**
+ * @brief Searches a short needle with the first and last byte block filter of
+ * the active kernels, see s21_kernels.h.
+ *
+ * @param haystack Pointer to the haystack.
+ * @param needle Pointer to the needle bytes.
+ * @param needle_len Length of the needle, 1 to S21_SHORT_NEEDLE.
+ * @return Offset of the occurrence, or S21_NOT_FOUND.
+ */
+s21_size_t s21_search_short(haystack_type *haystack,
+                            const unsigned char *needle,
+                            s21_size_t needle_len) {
+  return s21_kernels()->search_short(haystack, needle, needle_len);
+}
+/**
+ * @brief Searches a needle with the Two-Way algorithm.
+ *
+ * @param haystack Pointer to the haystack.
+ * @param needle Pointer to the needle bytes.
+ * @param needle_len Length of the needle, at least 1.
+ * @return Offset of the occurrence, or S21_NOT_FOUND.
+ */
+s21_size_t s21_search_two_way(haystack_type *haystack,
+                              const unsigned char *needle,
+                              s21_size_t needle_len) {
+  const unsigned char *data = haystack->data;
+  s21_size_t period = 1;
+  s21_size_t suffix = s21_critical_factorization(needle, needle_len, &period);
+  int periodic = !s21_memcmp(needle, needle + period, suffix);
+  s21_size_t memory = 0;  // needle bytes known to match from the last shift
+  s21_size_t result = S21_NOT_FOUND;
+  s21_size_t pos = 0;
+  s21_size_t i = 0;
+  if (!periodic) {
+    period = (suffix > needle_len - suffix ? suffix : needle_len - suffix) + 1;
+  }
+  while (result == S21_NOT_FOUND &&
+         s21_haystack_reach(haystack, pos + needle_len)) {
+    i = suffix > memory ? suffix : memory;
+    while (i < needle_len && needle[i] == data[pos + i]) i++;
+    if (i < needle_len) {
+      pos += i - suffix + 1;
+      memory = 0;
+    } else {
+      i = suffix;
+      while (i > memory && needle[i - 1] == data[pos + i - 1]) i--;
+      if (i <= memory) {
+        result = pos;
+      } else {
+        pos += period;
+        memory = periodic ? needle_len - period : 0;
+      }
+    }
+  }
+  return result;
+}
+// __Factorization__
+/**
+ * @brief Finds a critical factorization of a needle.
+ *
+ * The split point is the later of the maximal suffixes for the byte order and
+ * for the reversed byte order, which is critical by the Critical
+ * Factorization Theorem.
+ *
+ * @param needle Pointer to the needle bytes.
+ * @param needle_len Length of the needle.
+ * @param period Receives the period of the right part of the split.
+ * @return Length of the left part of the split.
+ */
+s21_size_t s21_critical_factorization(const unsigned char *needle,
+                                      s21_size_t needle_len,
+                                      s21_size_t *period) {
+  s21_size_t reverse_period = 1;
+  s21_size_t suffix = s21_maximal_suffix(needle, needle_len, 0, period);
+  s21_size_t reverse_suffix =
+      s21_maximal_suffix(needle, needle_len, 1, &reverse_period);
+  if (reverse_suffix > suffix) {
+    suffix = reverse_suffix;
+    *period = reverse_period;
+  }
+  return suffix;
+}
+/**
+ * @brief Finds the lexicographically maximal suffix of a needle.
+ *
+ * @param needle Pointer to the needle bytes.
+ * @param needle_len Length of the needle.
+ * @param reverse 1 to compare bytes in reversed order.
+ * @param period Receives the period of the suffix.
+ * @return Offset where the suffix starts.
+ */
+s21_size_t s21_maximal_suffix(const unsigned char *needle,
+                              s21_size_t needle_len, int reverse,
+                              s21_size_t *period) {
+  s21_size_t start = 0;  // the suffix begins here
+  s21_size_t offset = 1;
+  s21_size_t step = 1;
+  s21_size_t j = 1;
+  while (j + offset - 1 < needle_len) {
+    unsigned char candidate = needle[j + offset - 1];
+    unsigned char current = needle[start + offset - 1];
+    if (reverse ? candidate > current : candidate < current) {
+      j += offset;
+      offset = 1;
+      step = j - start;
+    } else if (candidate == current) {
+      if (offset != step) {
+        offset++;
+      } else {
+        j += step;
+        offset = 1;
+      }
+    } else {
+      start = j;
+      j++;
+      offset = step = 1;
+    }
+  }
+  *period = step;
+  return start;
+}
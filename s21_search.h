@@ -0,0 +1,50 @@
+/**
+ * @file s21_search.h
+ * @brief Header file defining the substring search engine.
+ *
+ * This header file declares the engine behind s21_strstr and s21_memmem. The
+ * search runs in linear time and constant space for every needle:
+ * - needles up to S21_SHORT_NEEDLE bytes go through a block filter that only
+ * compares positions where both the first and the last needle byte match;
+ * - longer needles use the Two-Way algorithm of Crochemore and Perrin.
+ *
+ * Structures:
+ * - haystack_type: The searched bytes. A haystack is either a buffer of known
+ * length or a string whose length is discovered only as far as the search
+ * needs it, so s21_strstr does not measure the whole haystack first.
+ */
+#ifndef SRC_S21_SEARCH_H_
+#define SRC_S21_SEARCH_H_
+
+#include "s21_string.h"
+
+#define S21_NOT_FOUND ((s21_size_t)-1)
+#define S21_SHORT_NEEDLE 32
+#define S21_HAYSTACK_STEP 256  // bytes a string haystack is measured by
+
+typedef struct haystack {
+  const unsigned char *data;
+  s21_size_t length;  // bytes known to belong to the haystack
+  int open;           // 1 while the '\0' ending a string is not reached
+} haystack_type;
+
+// __Haystack__
+int s21_haystack_reach(haystack_type *haystack, s21_size_t end);
+// __Search__
+s21_size_t s21_search(haystack_type *haystack, const unsigned char *needle,
+                      s21_size_t needle_len);
+s21_size_t s21_search_short(haystack_type *haystack,
+                            const unsigned char *needle,
+                            s21_size_t needle_len);
+s21_size_t s21_search_two_way(haystack_type *haystack,
+                              const unsigned char *needle,
+                              s21_size_t needle_len);
+// __Factorization__
+s21_size_t s21_critical_factorization(const unsigned char *needle,
+                                      s21_size_t needle_len,
+                                      s21_size_t *period);
+s21_size_t s21_maximal_suffix(const unsigned char *needle,
+                              s21_size_t needle_len, int reverse,
+                              s21_size_t *period);
+
+#endif  // SRC_S21_SEARCH_H_
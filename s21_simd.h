@@ -0,0 +1,443 @@
+/**
+ * @file s21_simd.h
+ * @brief Block-at-a-time byte matching, copying and filling used by the
+ * string functions of s21_string.c and the kernels of s21_kernels.h.
+ *
+ * A block is the widest unit the build can compare at once. The backend is
+ * chosen at build time:
+ * - AVX2: 32-byte blocks, built with -mavx2;
+ * - SSE2: 16-byte blocks, always available on x86-64;
+ * - NEON: 16-byte blocks, always available on AArch64;
+ * - SWAR: 8-byte words with the "has zero byte" bit trick, builds everywhere
+ * and is forced with -DS21_NO_SIMD.
+ *
+ * A translation unit that defines S21_SIMD_BACKEND before including this
+ * header gets that backend whatever the compiler flags; its functions then
+ * carry S21_TARGET. The kernels of s21_kernels.h are built this way once per
+ * backend and picked at run time by s21_dispatch.c.
+ *
+ * Every backend returns a match mask with S21_MASK_STEP bits per byte, set to
+ * S21_MASK_LANE for a matching byte, and the first byte in memory in the
+ * lowest bits, so the string functions are written once for all of them.
+ *
+ * @note Loads from a block aligned to S21_BLOCK_SIZE never cross a page, so
+ * scanning a string with an unknown length starts from the aligned block that
+ * contains it and masks off the bytes before the string.
+ */
+#ifndef SRC_S21_SIMD_H_
+#define SRC_S21_SIMD_H_
+
+#include <stdint.h>
+
+#include "s21_string.h"
+
+#if defined(__GNUC__)
+#define S21_MAY_ALIAS __attribute__((__may_alias__, __aligned__(1)))
+#define S21_INLINE static inline __attribute__((__always_inline__)) S21_TARGET
+#else
+#define S21_MAY_ALIAS
+#define S21_INLINE static inline
+#endif
+
+#define S21_PAGE_SIZE 4096
+
+#define S21_BACKEND_SWAR 0
+#define S21_BACKEND_SSE2 1
+#define S21_BACKEND_AVX2 2
+#define S21_BACKEND_NEON 3
+
+#ifndef S21_SIMD_BACKEND
+#if defined(S21_NO_SIMD)
+#define S21_SIMD_BACKEND S21_BACKEND_SWAR
+#elif defined(__AVX2__)
+#define S21_SIMD_BACKEND S21_BACKEND_AVX2
+#elif defined(__SSE2__) || defined(_M_X64)
+#define S21_SIMD_BACKEND S21_BACKEND_SSE2
+#elif defined(__ARM_NEON) || defined(__aarch64__)
+#define S21_SIMD_BACKEND S21_BACKEND_NEON
+#else
+#define S21_SIMD_BACKEND S21_BACKEND_SWAR
+#endif
+#endif
+
+#if S21_SIMD_BACKEND == S21_BACKEND_AVX2
+#include <immintrin.h>
+#define S21_SIMD_AVX2
+#if !defined(__AVX2__) && defined(__GNUC__)
+#define S21_TARGET __attribute__((__target__("avx2")))
+#endif
+#define S21_BLOCK_SIZE 32
+#define S21_MASK_STEP 1
+#define S21_MASK_FULL 0xFFFFFFFFULL
+#define S21_MASK_LANE 1ULL
+typedef __m256i s21_block_type;
+#elif S21_SIMD_BACKEND == S21_BACKEND_SSE2
+#include <emmintrin.h>
+#define S21_SIMD_SSE2
+#define S21_BLOCK_SIZE 16
+#define S21_MASK_STEP 1
+#define S21_MASK_FULL 0xFFFFULL
+#define S21_MASK_LANE 1ULL
+typedef __m128i s21_block_type;
+#elif S21_SIMD_BACKEND == S21_BACKEND_NEON
+#include <arm_neon.h>
+#define S21_SIMD_NEON
+#define S21_BLOCK_SIZE 16
+#define S21_MASK_STEP 4
+#define S21_MASK_FULL 0xFFFFFFFFFFFFFFFFULL
+#define S21_MASK_LANE 0xFULL
+typedef uint8x16_t s21_block_type;
+#else
+#define S21_SIMD_SWAR
+#define S21_BLOCK_SIZE 8
+#define S21_MASK_STEP 8
+#define S21_MASK_FULL 0x8080808080808080ULL
+#define S21_MASK_LANE 0x80ULL
+#define S21_SWAR_LOW 0x7F7F7F7F7F7F7F7FULL
+typedef unsigned long long s21_block_type;
+#endif
+
+#ifndef S21_TARGET
+#define S21_TARGET
+#endif
+
+// The loads of a string with an unknown length may read past its end inside
+// its page, which AddressSanitizer reports; built with it, they are kept out
+// of line and uninstrumented.
+#if defined(__SANITIZE_ADDRESS__)
+#define S21_ASAN
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define S21_ASAN
+#endif
+#endif
+#ifdef S21_ASAN
+#define S21_NO_ASAN __attribute__((__no_sanitize_address__, __noinline__))
+#define S21_LOAD static __attribute__((__unused__)) S21_NO_ASAN S21_TARGET
+#else
+#define S21_NO_ASAN
+#define S21_LOAD S21_INLINE
+#endif
+
+#define S21_WORD_SIZE 8
+typedef unsigned long long S21_MAY_ALIAS s21_word_type;
+typedef uint32_t S21_MAY_ALIAS s21_word32_type;
+typedef uint16_t S21_MAY_ALIAS s21_word16_type;
+
+/**
+ * @brief Loads an 8-byte word from any address.
+ *
+ * @param ptr Pointer to S21_WORD_SIZE readable bytes.
+ * @return The word, the first byte in memory in the lowest bits.
+ */
+S21_LOAD unsigned long long s21_word_load(const void *ptr) {
+  unsigned long long word = *(const s21_word_type *)ptr;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  word = __builtin_bswap64(word);
+#endif
+  return word;
+}
+/**
+ * @brief Checks whether a word can be loaded at an address without touching
+ * the next page.
+ *
+ * @param ptr The address of the word.
+ * @return 1 if the whole word is inside the page of 'ptr', otherwise 0.
+ */
+S21_INLINE int s21_word_in_page(const void *ptr) {
+  return (uintptr_t)ptr % S21_PAGE_SIZE <= S21_PAGE_SIZE - S21_WORD_SIZE;
+}
+
+/**
+ * @brief Loads a block from any address.
+ *
+ * @param ptr Pointer to S21_BLOCK_SIZE readable bytes.
+ * @return The loaded block.
+ */
+S21_LOAD s21_block_type s21_block_load(const void *ptr) {
+#if defined(S21_SIMD_AVX2)
+  return _mm256_loadu_si256((const __m256i *)ptr);
+#elif defined(S21_SIMD_SSE2)
+  return _mm_loadu_si128((const __m128i *)ptr);
+#elif defined(S21_SIMD_NEON)
+  return vld1q_u8((const uint8_t *)ptr);
+#else
+  return s21_word_load(ptr);
+#endif
+}
+/**
+ * @brief Fills every byte of a block with the same value.
+ *
+ * @param byte The value to repeat.
+ * @return The filled block.
+ */
+S21_INLINE s21_block_type s21_block_splat(unsigned char byte) {
+#if defined(S21_SIMD_AVX2)
+  return _mm256_set1_epi8((char)byte);
+#elif defined(S21_SIMD_SSE2)
+  return _mm_set1_epi8((char)byte);
+#elif defined(S21_SIMD_NEON)
+  return vdupq_n_u8(byte);
+#else
+  return 0x0101010101010101ULL * byte;
+#endif
+}
+/**
+ * @brief Compares two blocks byte by byte.
+ *
+ * @param block The first block.
+ * @param pattern The second block.
+ * @return Mask with S21_MASK_STEP bits set for every equal byte.
+ */
+S21_INLINE unsigned long long s21_block_eq(s21_block_type block,
+                                           s21_block_type pattern) {
+#if defined(S21_SIMD_AVX2)
+  return (unsigned)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern));
+#elif defined(S21_SIMD_SSE2)
+  return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern));
+#elif defined(S21_SIMD_NEON)
+  uint8x8_t nibbles =
+      vshrn_n_u16(vreinterpretq_u16_u8(vceqq_u8(block, pattern)), 4);
+  return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+#else
+  // exact per byte: no borrow runs from one byte into the next
+  s21_block_type x = block ^ pattern;
+  return ~(((x & S21_SWAR_LOW) + S21_SWAR_LOW) | x | S21_SWAR_LOW);
+#endif
+}
+/**
+ * @brief Keeps the mask bits of the bytes from 'offset' to the end of a block.
+ *
+ * @param mask The match mask of a block.
+ * @param offset The index of the first byte to keep.
+ * @return The masked match mask.
+ */
+S21_INLINE unsigned long long s21_mask_from(unsigned long long mask,
+                                            s21_size_t offset) {
+  return mask & ((S21_MASK_FULL << (offset * S21_MASK_STEP)) & S21_MASK_FULL);
+}
+/**
+ * @brief Returns the index of the first matching byte of a nonzero mask.
+ *
+ * @param mask The match mask.
+ * @return The byte index inside the block.
+ */
+S21_INLINE s21_size_t s21_mask_first(unsigned long long mask) {
+  s21_size_t index = 0;
+#if defined(__GNUC__)
+  index = (s21_size_t)__builtin_ctzll(mask);
+#else
+  while (!(mask & 1)) {
+    mask >>= 1;
+    index += 1;
+  }
+#endif
+  return index / S21_MASK_STEP;
+}
+/**
+ * @brief Clears the mask bits of the first matching byte.
+ *
+ * @param mask The nonzero match mask.
+ * @return The mask of the remaining matching bytes.
+ */
+S21_INLINE unsigned long long s21_mask_next(unsigned long long mask) {
+  return mask & ~(S21_MASK_LANE << (s21_mask_first(mask) * S21_MASK_STEP));
+}
+/**
+ * @brief Returns the index of the last matching byte of a nonzero mask.
+ *
+ * @param mask The match mask.
+ * @return The byte index inside the block.
+ */
+S21_INLINE s21_size_t s21_mask_last(unsigned long long mask) {
+  s21_size_t index = 63;
+#if defined(__GNUC__)
+  index -= (s21_size_t)__builtin_clzll(mask);
+#else
+  while (!(mask >> 63)) {
+    mask <<= 1;
+    index -= 1;
+  }
+#endif
+  return index / S21_MASK_STEP;
+}
+/**
+ * @brief Stores a block at any address.
+ *
+ * @param ptr Pointer to S21_BLOCK_SIZE writable bytes.
+ * @param block The block to store.
+ */
+S21_INLINE void s21_block_store(void *ptr, s21_block_type block) {
+#if defined(S21_SIMD_AVX2)
+  _mm256_storeu_si256((__m256i *)ptr, block);
+#elif defined(S21_SIMD_SSE2)
+  _mm_storeu_si128((__m128i *)ptr, block);
+#elif defined(S21_SIMD_NEON)
+  vst1q_u8((uint8_t *)ptr, block);
+#else
+  unsigned long long word = block;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  word = __builtin_bswap64(word);
+#endif
+  *(s21_word_type *)ptr = word;
+#endif
+}
+/**
+ * @brief Stores a block at an address aligned to S21_BLOCK_SIZE.
+ *
+ * @param ptr Pointer to S21_BLOCK_SIZE writable bytes, aligned.
+ * @param block The block to store.
+ */
+S21_INLINE void s21_block_store_aligned(void *ptr, s21_block_type block) {
+#if defined(S21_SIMD_AVX2)
+  _mm256_store_si256((__m256i *)ptr, block);
+#elif defined(S21_SIMD_SSE2)
+  _mm_store_si128((__m128i *)ptr, block);
+#else
+  s21_block_store(ptr, block);
+#endif
+}
+/**
+ * @brief Stores a block around the caches where the backend can.
+ *
+ * @param ptr Pointer to S21_BLOCK_SIZE writable bytes, aligned.
+ * @param block The block to store.
+ * @note A run of streaming stores ends with s21_stream_fence.
+ */
+S21_INLINE void s21_block_stream(void *ptr, s21_block_type block) {
+#if defined(S21_SIMD_AVX2)
+  _mm256_stream_si256((__m256i *)ptr, block);
+#elif defined(S21_SIMD_SSE2)
+  _mm_stream_si128((__m128i *)ptr, block);
+#else
+  s21_block_store(ptr, block);
+#endif
+}
+/**
+ * @brief Orders the streaming stores before the stores that follow them.
+ */
+S21_INLINE void s21_stream_fence(void) {
+#if defined(S21_SIMD_AVX2) || defined(S21_SIMD_SSE2)
+  _mm_sfence();
+#endif
+}
+/**
+ * @brief Copies fewer than S21_BLOCK_SIZE bytes with two overlapping loads
+ * and stores of the widest fitting unit.
+ *
+ * Both loads happen before the first store, so the regions may overlap.
+ *
+ * @param dest Pointer to n writable bytes.
+ * @param src Pointer to n readable bytes.
+ * @param n Number of bytes, below S21_BLOCK_SIZE.
+ */
+S21_INLINE void s21_copy_short(unsigned char *dest, const unsigned char *src,
+                               s21_size_t n) {
+  if (n >= 8) {
+#if defined(S21_SIMD_AVX2)
+    if (n >= 16) {
+      __m128i head = _mm_loadu_si128((const __m128i *)src);
+      __m128i tail = _mm_loadu_si128((const __m128i *)(src + n - 16));
+      _mm_storeu_si128((__m128i *)dest, head);
+      _mm_storeu_si128((__m128i *)(dest + n - 16), tail);
+    } else
+#endif
+    {
+      unsigned long long head = *(const s21_word_type *)src;
+      unsigned long long tail = *(const s21_word_type *)(src + n - 8);
+      *(s21_word_type *)dest = head;
+      *(s21_word_type *)(dest + n - 8) = tail;
+    }
+  } else if (n >= 4) {
+    uint32_t head = *(const s21_word32_type *)src;
+    uint32_t tail = *(const s21_word32_type *)(src + n - 4);
+    *(s21_word32_type *)dest = head;
+    *(s21_word32_type *)(dest + n - 4) = tail;
+  } else if (n >= 2) {
+    uint16_t head = *(const s21_word16_type *)src;
+    uint16_t tail = *(const s21_word16_type *)(src + n - 2);
+    *(s21_word16_type *)dest = head;
+    *(s21_word16_type *)(dest + n - 2) = tail;
+  } else if (n) {
+    *dest = *src;
+  }
+}
+/**
+ * @brief Fills fewer than S21_BLOCK_SIZE bytes with two overlapping stores of
+ * the widest fitting unit.
+ *
+ * @param dest Pointer to n writable bytes.
+ * @param byte The fill value.
+ * @param n Number of bytes, below S21_BLOCK_SIZE.
+ */
+S21_INLINE void s21_fill_short(unsigned char *dest, unsigned char byte,
+                               s21_size_t n) {
+  unsigned long long word = 0x0101010101010101ULL * byte;
+  if (n >= 8) {
+#if defined(S21_SIMD_AVX2)
+    if (n >= 16) {
+      __m128i fill = _mm_set1_epi8((char)byte);
+      _mm_storeu_si128((__m128i *)dest, fill);
+      _mm_storeu_si128((__m128i *)(dest + n - 16), fill);
+    } else
+#endif
+    {
+      *(s21_word_type *)dest = word;
+      *(s21_word_type *)(dest + n - 8) = word;
+    }
+  } else if (n >= 4) {
+    *(s21_word32_type *)dest = (uint32_t)word;
+    *(s21_word32_type *)(dest + n - 4) = (uint32_t)word;
+  } else if (n >= 2) {
+    *(s21_word16_type *)dest = (uint16_t)word;
+    *(s21_word16_type *)(dest + n - 2) = (uint16_t)word;
+  } else if (n) {
+    *dest = byte;
+  }
+}
+/**
+ * @brief Flips the case of the ASCII letters of one case in a block.
+ *
+ * @param block The block to convert.
+ * @param first 'a' to convert lowercase letters, 'A' for uppercase ones.
+ * @return The block with 0x20 toggled in every byte from 'first' to
+ * 'first' + 25, the other bytes unchanged.
+ */
+S21_INLINE s21_block_type s21_block_flip_case(s21_block_type block,
+                                              unsigned char first) {
+#if defined(S21_SIMD_AVX2)
+  // shift the range to the bottom of the signed bytes, one compare remains
+  __m256i shifted =
+      _mm256_add_epi8(block, _mm256_set1_epi8((char)(0x80 - first)));
+  __m256i letters = _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 26), shifted);
+  return _mm256_xor_si256(block,
+                          _mm256_and_si256(letters, _mm256_set1_epi8(0x20)));
+#elif defined(S21_SIMD_SSE2)
+  __m128i shifted = _mm_add_epi8(block, _mm_set1_epi8((char)(0x80 - first)));
+  __m128i letters = _mm_cmpgt_epi8(_mm_set1_epi8(-128 + 26), shifted);
+  return _mm_xor_si128(block, _mm_and_si128(letters, _mm_set1_epi8(0x20)));
+#elif defined(S21_SIMD_NEON)
+  uint8x16_t letters = vcltq_u8(vsubq_u8(block, vdupq_n_u8(first)),
+                                vdupq_n_u8(26));
+  return veorq_u8(block, vandq_u8(letters, vdupq_n_u8(0x20)));
+#else
+  // in range on the low seven bits, then drop the bytes with the high bit
+  s21_block_type ones = 0x0101010101010101ULL, low = block & S21_SWAR_LOW;
+  s21_block_type letters = (low + (0x80 - first) * ones) &
+                           ~(low + (0x7F - first - 25) * ones) & ~block &
+                           (0x80 * ones);
+  return block ^ (letters >> 2);
+#endif
+}
+/**
+ * @brief Checks whether a block can be loaded at an address without touching
+ * the next page.
+ *
+ * @param ptr The address of the block.
+ * @return 1 if the whole block is inside the page of 'ptr', otherwise 0.
+ */
+S21_INLINE int s21_block_in_page(const void *ptr) {
+  return (uintptr_t)ptr % S21_PAGE_SIZE <= S21_PAGE_SIZE - S21_BLOCK_SIZE;
+}
+
+#endif  // SRC_S21_SIMD_H_
@@ -0,0 +1,264 @@
+/**
+ * @file s21_sink.c
+ * @brief Implementation of the output sinks of the s21_sprintf family.
+ *
+ * A sink receives the formatted output as a sequence of spans. The formatting
+ * core stages small pieces in a S21_SINK_STAGING_SIZE buffer on the stack and
+ * hands them over when it is full; a span larger than the staging buffer, such
+ * as a long %s argument, goes to the sink directly without being copied.
+ *
+ * Function Overview:
+ * - s21_sprintf_sink, s21_vsprintf_sink: Format into any sink.
+ * - s21_fprintf, s21_vfprintf: Format into a FILE stream.
+ * - s21_dprintf, s21_vdprintf: Format into a file descriptor, one write(2)
+ * per staging buffer.
+ * - s21_asprintf, s21_vasprintf: Format into a heap buffer of the right size.
+ * - s21_sink_buffer, s21_sink_file, s21_sink_fd: The built-in sinks.
+ *
+ * @note A failing sink makes the call return -1, the output written before the
+ * failure is not taken back.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <unistd.h>
+
+#include "s21_sprintf.h"
+#include "s21_stats.h"
+
+// __Formatting__
+/**
+ * @brief Formats a string and writes the result to a sink
+ *
+ * @param sink Pointer to the sink receiving the output
+ * @param format Pointer to the format string that specifies how to format the
+ * data
+ * @param ... Variable arguments to be formatted according to the format string
+ * @return int The number of characters written, or -1 on error
+ */
+int s21_sprintf_sink(const sink_type *sink, const char *format, ...) {
+  int n = 0;
+  va_list var_arg;
+  va_start(var_arg, format);
+  n = s21_vsprintf_sink(sink, format, var_arg);
+  va_end(var_arg);
+  return n;
+}
+/**
+ * @brief Formats a string from a va_list and writes the result to a sink
+ *
+ * @param sink Pointer to the sink receiving the output
+ * @param format Pointer to the format string that specifies how to format the
+ * data
+ * @param var_arg Variable argument list to be formatted according to the format
+ * string
+ * @return int The number of characters written, or -1 on error
+ */
+int s21_vsprintf_sink(const sink_type *sink, const char *format,
+                      va_list var_arg) {
+  char staging[S21_SINK_STAGING_SIZE];
+  cursor_type cursor = {staging, S21_SINK_STAGING_SIZE, 0, 0, sink, 0};
+  return s21_format(&cursor, format, s21_NULL, var_arg);
+}
+/**
+ * @brief Formats a string and writes the result to a stream
+ *
+ * @param stream The stream receiving the output, left buffered
+ * @param format Pointer to the format string
+ * @param ... Variable arguments to be formatted according to the format string
+ * @return int The number of characters written, or -1 on error
+ */
+int s21_fprintf(FILE *stream, const char *format, ...) {
+  int n = 0;
+  va_list var_arg;
+  va_start(var_arg, format);
+  n = s21_vfprintf(stream, format, var_arg);
+  va_end(var_arg);
+  return n;
+}
+/**
+ * @brief Formats a string from a va_list and writes the result to a stream
+ *
+ * @param stream The stream receiving the output, left buffered
+ * @param format Pointer to the format string
+ * @param var_arg Variable argument list to be formatted
+ * @return int The number of characters written, or -1 on error
+ */
+int s21_vfprintf(FILE *stream, const char *format, va_list var_arg) {
+  sink_type sink = s21_sink_file(stream);
+  return s21_vsprintf_sink(&sink, format, var_arg);
+}
+/**
+ * @brief Formats a string and writes the result to a file descriptor
+ *
+ * @param fd The file descriptor receiving the output
+ * @param format Pointer to the format string
+ * @param ... Variable arguments to be formatted according to the format string
+ * @return int The number of characters written, or -1 on error
+ */
+int s21_dprintf(int fd, const char *format, ...) {
+  int n = 0;
+  va_list var_arg;
+  va_start(var_arg, format);
+  n = s21_vdprintf(fd, format, var_arg);
+  va_end(var_arg);
+  return n;
+}
+/**
+ * @brief Formats a string from a va_list and writes the result to a file
+ * descriptor
+ *
+ * @param fd The file descriptor receiving the output
+ * @param format Pointer to the format string
+ * @param var_arg Variable argument list to be formatted
+ * @return int The number of characters written, or -1 on error
+ */
+int s21_vdprintf(int fd, const char *format, va_list var_arg) {
+  sink_type sink = s21_sink_fd(fd);
+  return s21_vsprintf_sink(&sink, format, var_arg);
+}
+/**
+ * @brief Formats a string into a newly allocated buffer
+ *
+ * @param strp Receives the buffer, to be released with free, or NULL on error
+ * @param format Pointer to the format string
+ * @param ... Variable arguments to be formatted according to the format string
+ * @return int The number of characters written, or -1 on error
+ */
+int s21_asprintf(char **strp, const char *format, ...) {
+  int n = 0;
+  va_list var_arg;
+  va_start(var_arg, format);
+  n = s21_vasprintf(strp, format, var_arg);
+  va_end(var_arg);
+  return n;
+}
+/**
+ * @brief Formats a string from a va_list into a newly allocated buffer
+ *
+ * @param strp Receives the buffer, to be released with free, or NULL on error
+ * @param format Pointer to the format string
+ * @param var_arg Variable argument list to be formatted
+ * @return int The number of characters written, or -1 on error
+ */
+int s21_vasprintf(char **strp, const char *format, va_list var_arg) {
+  sink_buffer_type buffer = {s21_NULL, 0, 0, 1};
+  sink_type sink = s21_sink_buffer(&buffer);
+  int n = s21_vsprintf_sink(&sink, format, var_arg);
+  if (n >= 0 && !buffer.data) {
+    buffer.data = calloc(1, sizeof(char));
+    if (buffer.data) {
+      S21_STAT_ADD(allocations, 1);
+    } else {
+      n = -1;
+    }
+  }
+  if (n < 0) {
+    free(buffer.data);
+    buffer.data = s21_NULL;
+    n = -1;
+  }
+  *strp = buffer.data;
+  return n;
+}
+// __Built-in sinks__
+/**
+ * @brief Makes a sink that stores the output in a memory buffer.
+ *
+ * @param buffer Pointer to the buffer state. A fixed buffer keeps the first
+ * capacity - 1 characters, a growable one starts from any data/capacity pair,
+ * including s21_NULL/0, and is extended with realloc.
+ * @return The sink.
+ */
+sink_type s21_sink_buffer(sink_buffer_type *buffer) {
+  sink_type sink = {s21_buffer_write, s21_NULL, buffer};
+  return sink;
+}
+/**
+ * @brief Makes a sink that writes the output to a stream with fwrite.
+ *
+ * @param stream The stream, flushed by its own buffering rules.
+ * @return The sink.
+ */
+sink_type s21_sink_file(FILE *stream) {
+  sink_type sink = {s21_file_write, s21_NULL, stream};
+  return sink;
+}
+/**
+ * @brief Makes a sink that writes the output to a file descriptor with
+ * write(2).
+ *
+ * @param fd The file descriptor.
+ * @return The sink.
+ */
+sink_type s21_sink_fd(int fd) {
+  sink_type sink = {s21_fd_write, s21_NULL, (void *)(intptr_t)fd};
+  return sink;
+}
+/**
+ * @brief Write callback of the memory buffer sink.
+ *
+ * @param context Pointer to the sink_buffer_type.
+ * @param span Pointer to the characters to store.
+ * @param len Number of characters to store.
+ * @return 0 on success, -1 if a growable buffer could not be extended.
+ */
+int s21_buffer_write(void *context, const char *span, s21_size_t len) {
+  sink_buffer_type *buffer = context;
+  s21_size_t needed = buffer->length + len + 1;
+  int status = 0;
+  if (buffer->growable && needed > buffer->capacity) {
+    s21_size_t capacity = buffer->capacity ? buffer->capacity : 64;
+    while (capacity < needed) capacity *= 2;
+    char *data = realloc(buffer->data, capacity);
+    if (data) {
+      S21_STAT_ADD(allocations, 1);
+      buffer->data = data;
+      buffer->capacity = capacity;
+    } else {
+      status = -1;
+    }
+  }
+  if (!status && buffer->capacity > buffer->length) {
+    s21_size_t room = buffer->capacity - buffer->length - 1;
+    if (len > room) len = room;
+    s21_memcpy(buffer->data + buffer->length, span, len);
+    buffer->length += len;
+    buffer->data[buffer->length] = '\0';
+  }
+  return status;
+}
+/**
+ * @brief Write callback of the stream sink.
+ *
+ * @param context The FILE stream.
+ * @param span Pointer to the characters to write.
+ * @param len Number of characters to write.
+ * @return 0 on success, -1 on a write error.
+ */
+int s21_file_write(void *context, const char *span, s21_size_t len) {
+  return fwrite(span, 1, len, (FILE *)context) == len ? 0 : -1;
+}
+/**
+ * @brief Write callback of the file descriptor sink, retries short writes and
+ * interrupted calls.
+ *
+ * @param context The file descriptor stored as a pointer.
+ * @param span Pointer to the characters to write.
+ * @param len Number of characters to write.
+ * @return 0 on success, -1 on a write error.
+ */
+int s21_fd_write(void *context, const char *span, s21_size_t len) {
+  int fd = (int)(intptr_t)context;
+  int status = 0;
+  while (len && !status) {
+    ssize_t written = write(fd, span, len);
+    if (written > 0) {
+      span += written;
+      len -= (s21_size_t)written;
+    } else if (written == 0 || errno != EINTR) {
+      status = -1;
+    }
+  }
+  return status;
+}
@@ -0,0 +1,618 @@
+/**
+ * @file s21_source.c
+ * @brief Implementation of the input sources of the s21_sscanf family.
+ *
+ * A scanner keeps a window of the input, refilled from a source callback or
+ * fed by the caller, and runs the steps of s21_sscanf over it. Before the
+ * literal and again before the conversion of every step the window is
+ * extended until it holds the rest of the next non-blank line, so a number or
+ * a token cut by a chunk or a line boundary is always read whole.
+ * The characters a call consumes are dropped at the start of the next one,
+ * which keeps the memory to about the longest line plus one chunk however
+ * long the input is.
+ *
+ * Function Overview:
+ * - s21_scanner_init, s21_scanner_free: Set up and release a scanner.
+ * - s21_scanner_feed, s21_scanner_close: Push input into a scanner without a
+ * source, for example from a ring buffer or a socket.
+ * - s21_scan, s21_vscan: Formatted input from a scanner.
+ * - s21_fscanf, s21_vfscanf: Formatted input from a FILE stream, read with
+ * getc one step at a time by s21_stream_literal and s21_stream_token.
+ * - s21_source_file, s21_source_fd: The built-in sources.
+ *
+ * @note A conversion does not read past the end of the line it starts on, so
+ * %c and %[ stop at the first '\n' that is not yet in the window.
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdint.h>
+#include <unistd.h>
+
+#include "s21_sscanf.h"
+#include "s21_stats.h"
+
+// __Scanners__
+/**
+ * @brief Sets up a scanner with an empty window.
+ *
+ * @param scanner Pointer to the scanner.
+ * @param source The source to read from, with a s21_NULL read callback for a
+ * scanner fed with s21_scanner_feed.
+ */
+void s21_scanner_init(scanner_type *scanner, source_type source) {
+  scanner->source = source;
+  scanner->window = s21_NULL;
+  scanner->start = 0;
+  scanner->length = 0;
+  scanner->capacity = 0;
+  scanner->chunk = S21_SCANNER_CHUNK;
+  scanner->end = 0;
+  scanner->error = 0;
+}
+/**
+ * @brief Appends input to a scanner without a source.
+ *
+ * @param scanner Pointer to the scanner.
+ * @param data Pointer to the characters.
+ * @param len Number of characters.
+ * @return 0 on success, -1 if the window could not be extended.
+ */
+int s21_scanner_feed(scanner_type *scanner, const char *data, s21_size_t len) {
+  s21_scanner_compact(scanner);
+  int status = s21_scanner_reserve(scanner, len);
+  if (!status) {
+    s21_memcpy(scanner->window + scanner->length, data, len);
+    scanner->length += len;
+    scanner->window[scanner->length] = '\0';
+  }
+  return status;
+}
+/**
+ * @brief Marks the end of the input of a scanner without a source, so the
+ * last line no longer waits for its '\n'.
+ *
+ * @param scanner Pointer to the scanner.
+ */
+void s21_scanner_close(scanner_type *scanner) { scanner->end = 1; }
+/**
+ * @brief Releases the window of a scanner.
+ *
+ * @param scanner Pointer to the scanner, set up again to an empty window.
+ */
+void s21_scanner_free(scanner_type *scanner) {
+  s21_size_t chunk = scanner->chunk;
+  free(scanner->window);
+  s21_scanner_init(scanner, scanner->source);
+  scanner->chunk = chunk;
+}
+/**
+ * @brief Performs formatted input from a scanner.
+ *
+ * @param scanner Pointer to the scanner.
+ * @param format Pointer to the format string, as for s21_sscanf.
+ * @return The number of assigned conversions, -1 if the input ended or failed
+ * before the first one, or S21_SCAN_AGAIN.
+ */
+int s21_scan(scanner_type *scanner, const char *format, ...) {
+  va_list argument_pointer;
+  va_start(argument_pointer, format);
+  int result = s21_vscan(scanner, format, argument_pointer);
+  va_end(argument_pointer);
+  return result;
+}
+/**
+ * @brief Performs formatted input from a scanner with a va_list of the
+ * arguments.
+ *
+ * @param scanner Pointer to the scanner.
+ * @param format Pointer to the format string, as for s21_sscanf.
+ * @param var_arg Variable argument list of the pointers to store to.
+ * @return The number of assigned conversions, -1 if the input ended or failed
+ * before the first one, or S21_SCAN_AGAIN if a fed scanner ran out of input.
+ * In that case nothing is consumed and the call is to be repeated once more
+ * input was fed; the arguments it already stored are stored again.
+ */
+int s21_vscan(scanner_type *scanner, const char *format, va_list var_arg) {
+  char *temp_format = (char *)format;
+  scan_step_type step;
+  scan_state_type state = {s21_NULL, 0, 0, 1, 0};
+  s21_size_t offset = 0;
+  va_list argument_pointer;
+  s21_scanner_compact(scanner);
+  int status = s21_scanner_reserve(scanner, 0);
+  va_copy(argument_pointer, var_arg);
+  while (!status && *temp_format && !state.parsing_status) {
+    s21_parse_scan_step(&temp_format, &step);
+    status = s21_scanner_ensure(scanner, offset);
+    if (!status) {
+      // the window may have moved, only offsets survive a refill
+      state.temp_str = scanner->window + offset;
+      s21_match_scan_literal(&state, &step);
+      offset = state.temp_str - scanner->window;
+    }
+    // a literal that ends a line leaves the conversion input on the next one
+    if (!status && !state.parsing_status && step.specifier &&
+        step.specifier != 'n') {
+      status = s21_scanner_ensure(scanner, offset);
+      state.temp_str = scanner->window + offset;
+    }
+    if (!status) {
+      s21_convert_scan_step(&state, &step, &argument_pointer, scanner->window);
+      offset = state.temp_str - scanner->window;
+    }
+  }
+  va_end(argument_pointer);
+  S21_STAT_ADD(sscanf_calls, 1);
+  if (state.parsing_status) S21_STAT_ADD(parse_failures, 1);
+  if (!status) scanner->start = offset;
+  return status ? status : state.result;
+}
+/**
+ * @brief Performs formatted input from a stream.
+ *
+ * @param stream The stream to read from.
+ * @param format Pointer to the format string, as for s21_sscanf.
+ * @return The number of assigned conversions, or -1 if the input ended or
+ * failed before the first one.
+ */
+int s21_fscanf(FILE *stream, const char *format, ...) {
+  va_list argument_pointer;
+  va_start(argument_pointer, format);
+  int result = s21_vfscanf(stream, format, argument_pointer);
+  va_end(argument_pointer);
+  return result;
+}
+/**
+ * @brief Performs formatted input from a stream with a va_list of the
+ * arguments.
+ *
+ * Like fscanf, the stream is read with getc only as far as the steps of the
+ * format can use, and the one character that stops a step is given back with
+ * ungetc. Pipes, sockets and terminals are read the same as regular files.
+ *
+ * @param stream The stream to read from.
+ * @param format Pointer to the format string, as for s21_sscanf.
+ * @param var_arg Variable argument list of the pointers to store to.
+ * @return The number of assigned conversions, or -1 if the input ended or
+ * failed before the first one.
+ *
+ * @note As with fscanf, the characters a step reads but does not convert,
+ * such as the 'e' of "1ex" read by %f, are consumed.
+ */
+int s21_vfscanf(FILE *stream, const char *format, va_list var_arg) {
+  char *temp_format = (char *)format;
+  scan_step_type step;
+  scan_state_type state = {s21_NULL, 0, 0, 1, 0};
+  scanner_type scanner;
+  source_type source = {s21_NULL, stream};
+  s21_size_t offset = 0;
+  va_list argument_pointer;
+  s21_scanner_init(&scanner, source);
+  int status = s21_scanner_reserve(&scanner, 0);
+  va_copy(argument_pointer, var_arg);
+  while (!status && *temp_format && !state.parsing_status) {
+    s21_parse_scan_step(&temp_format, &step);
+    int lookahead = s21_stream_literal(&scanner, stream, step.literal);
+    state.temp_str = scanner.window + offset;
+    s21_match_scan_literal(&state, &step);
+    offset = s21_stream_unread(&scanner, stream, lookahead);
+    lookahead = state.parsing_status
+                    ? 0
+                    : s21_stream_token(&scanner, stream, &step);
+    state.temp_str = scanner.window + offset;
+    s21_convert_scan_step(&state, &step, &argument_pointer, scanner.window);
+    offset = s21_stream_unread(&scanner, stream, lookahead);
+    if (scanner.error) status = -1;
+  }
+  va_end(argument_pointer);
+  S21_STAT_ADD(sscanf_calls, 1);
+  if (state.parsing_status) S21_STAT_ADD(parse_failures, 1);
+  s21_scanner_free(&scanner);
+  return status ? status : state.result;
+}
+// __Windows__
+/**
+ * @brief Makes room in the window of a scanner, doubling it when it grows.
+ *
+ * @param scanner Pointer to the scanner.
+ * @param room Number of characters to make room for, besides the '\0'.
+ * @return 0 on success, -1 if the window could not be extended.
+ */
+int s21_scanner_reserve(scanner_type *scanner, s21_size_t room) {
+  s21_size_t needed = scanner->length + room + 1;
+  int status = 0;
+  if (needed > scanner->capacity) {
+    s21_size_t capacity = scanner->capacity ? scanner->capacity : 256;
+    while (capacity < needed) capacity *= 2;
+    char *window = realloc(scanner->window, capacity);
+    if (window) {
+      S21_STAT_ADD(allocations, 1);
+      if (!scanner->window) window[0] = '\0';
+      scanner->window = window;
+      scanner->capacity = capacity;
+    } else {
+      scanner->error = 1;
+      status = -1;
+    }
+  }
+  return status;
+}
+/**
+ * @brief Drops the consumed characters from the window of a scanner.
+ *
+ * @param scanner Pointer to the scanner.
+ */
+void s21_scanner_compact(scanner_type *scanner) {
+  if (scanner->start) {
+    scanner->length -= scanner->start;
+    s21_memmove(scanner->window, scanner->window + scanner->start,
+                scanner->length + 1);
+    scanner->start = 0;
+  }
+}
+/**
+ * @brief Reads the next chunk of input from the source of a scanner.
+ *
+ * @param scanner Pointer to the scanner, its source must not be s21_NULL.
+ * @return The number of characters read, 0 at the end of the input or -1 on
+ * error.
+ */
+long s21_scanner_fill(scanner_type *scanner) {
+  long count = -1;
+  if (!s21_scanner_reserve(scanner, scanner->chunk)) {
+    count = scanner->source.read(scanner->source.context,
+                                 scanner->window + scanner->length,
+                                 scanner->capacity - scanner->length - 1);
+    if (count > 0) {
+      scanner->length += (s21_size_t)count;
+      scanner->window[scanner->length] = '\0';
+    } else if (count == 0) {
+      scanner->end = 1;
+    } else {
+      scanner->error = 1;
+    }
+  }
+  return count;
+}
+/**
+ * @brief Extends the window of a scanner until it holds the rest of the next
+ * non-blank line after an offset, or the input has ended.
+ *
+ * @param scanner Pointer to the scanner.
+ * @param offset Offset in the window of the next character to scan.
+ * @return 0 when the line is in the window or the input has ended,
+ * S21_SCAN_AGAIN when a fed scanner needs more input, -1 on error.
+ */
+int s21_scanner_ensure(scanner_type *scanner, s21_size_t offset) {
+  static const charset_type whitespace = S21_CHARSET_WHITESPACE;
+  s21_size_t blank = offset;    // end of the whitespace after the offset
+  s21_size_t checked = offset;  // characters known to hold no '\n' after it
+  int status = 1;
+  while (status == 1) {
+    blank += s21_charset_span(scanner->window + blank, &whitespace);
+    if (checked < blank) checked = blank;
+    if (blank < scanner->length &&
+        s21_memchr(scanner->window + checked, '\n',
+                   scanner->length - checked)) {
+      status = 0;
+    } else if (scanner->error) {
+      status = -1;
+    } else if (scanner->end) {
+      status = 0;
+    } else if (!scanner->source.read) {
+      status = S21_SCAN_AGAIN;
+    } else {
+      checked = scanner->length;
+      if (s21_scanner_fill(scanner) < 0) status = -1;
+    }
+  }
+  return status;
+}
+// __Streams__
+/**
+ * @brief Reads a character of a stream into the window of a scanner.
+ *
+ * @param scanner Pointer to the scanner, its error is set on a read or an
+ * allocation failure.
+ * @param stream The stream.
+ * @return The character, EOF at the end of the stream or on error.
+ */
+int s21_stream_getc(scanner_type *scanner, FILE *stream) {
+  int c = EOF;
+  if (!s21_scanner_reserve(scanner, 1)) {
+    c = getc(stream);
+    if (c != EOF) {
+      scanner->window[scanner->length++] = (char)c;
+      scanner->window[scanner->length] = '\0';
+    } else if (ferror(stream)) {
+      scanner->error = 1;
+    }
+  }
+  return c;
+}
+/**
+ * @brief Reads the input the literal text of a step can match.
+ *
+ * Whitespace in the literal takes the whitespace of the input, any other
+ * character only itself, so the read stops at the first character that does
+ * not match.
+ *
+ * @param scanner Pointer to the scanner, the characters go to its window.
+ * @param stream The stream.
+ * @param literal Pointer to the literal, up to the next '%' or the end.
+ * @return 1 if the last character read did not match, otherwise 0.
+ */
+int s21_stream_literal(scanner_type *scanner, FILE *stream,
+                       const char *literal) {
+  static const charset_type whitespace = S21_CHARSET_WHITESPACE;
+  const char *ptr = literal;
+  int pending = 0;  // the last character read is not matched yet
+  int done = 0;
+  int c = 0;
+  while (!done && *ptr && *ptr != '%') {
+    if (!pending) pending = (c = s21_stream_getc(scanner, stream)) != EOF;
+    if (!pending) {
+      done = 1;
+    } else if (s21_charset_has(&whitespace, (unsigned char)*ptr)) {
+      if (s21_charset_has(&whitespace, (unsigned char)c)) {
+        pending = 0;
+      } else {
+        ptr++;
+      }
+    } else if (c == (unsigned char)*ptr) {
+      pending = 0;
+      ptr++;
+    } else {
+      done = 1;
+    }
+  }
+  return pending;
+}
+/**
+ * @brief Reads the input the conversion of a step can use: the whitespace it
+ * skips and then the longest run that still begins a valid token, at most
+ * the width.
+ *
+ * @param scanner Pointer to the scanner, the characters go to its window.
+ * @param stream The stream.
+ * @param step Pointer to the step.
+ * @return 1 if the last character read cannot extend the token, otherwise 0.
+ */
+int s21_stream_token(scanner_type *scanner, FILE *stream,
+                     const scan_step_type *step) {
+  static const charset_type whitespace = S21_CHARSET_WHITESPACE;
+  char specifier = step->specifier;
+  int wide = specifier == 'c' && step->assignment_target_type == 3;
+  s21_size_t limit = step->width ? (s21_size_t)step->width : SIZE_MAX;
+  int pending = 0;
+  int c = 0;
+  if (!step->width && specifier == 'c') limit = wide ? S21_UTF8_MAX : 1;
+  if (!specifier || specifier == 'n' ||
+      !s21_strchr("cdiouxXeEgGfsp[%", specifier)) {
+    limit = 0;  // nothing to read, or a conversion that fails anyway
+  } else if (specifier != 'c' && specifier != '[') {
+    do {
+      c = s21_stream_getc(scanner, stream);
+    } while (c != EOF && s21_charset_has(&whitespace, (unsigned char)c));
+    pending = c != EOF;
+  }
+  s21_size_t start = scanner->length - (s21_size_t)pending;
+  s21_size_t count = 0;
+  int done = 0;
+  while (!done) {
+    if (!pending && count < limit) {
+      pending = s21_stream_getc(scanner, stream) != EOF;
+    }
+    if (pending &&
+        s21_stream_viable(step, scanner->window + start, count + 1)) {
+      pending = 0;
+      count++;
+    } else {
+      done = 1;
+    }
+  }
+  return pending;
+}
+/**
+ * @brief Gives the character that stopped a read back to the stream, the
+ * characters before it count as consumed.
+ *
+ * @param scanner Pointer to the scanner.
+ * @param stream The stream.
+ * @param lookahead 1 if the last character of the window stopped the read.
+ * @return Offset in the window of the next character to scan.
+ */
+s21_size_t s21_stream_unread(scanner_type *scanner, FILE *stream,
+                             int lookahead) {
+  if (lookahead) {
+    ungetc((unsigned char)scanner->window[--scanner->length], stream);
+    scanner->window[scanner->length] = '\0';
+  }
+  return scanner->length;
+}
+/**
+ * @brief Tells whether characters can begin the token of a conversion.
+ *
+ * @param step Pointer to the step of the conversion.
+ * @param token Pointer to the characters, after the skipped whitespace.
+ * @param length Number of characters, at least 1.
+ * @return 1 if more input could make them a valid token, otherwise 0.
+ */
+int s21_stream_viable(const scan_step_type *step, const char *token,
+                      s21_size_t length) {
+  static const charset_type whitespace = S21_CHARSET_WHITESPACE;
+  unsigned char last = (unsigned char)token[length - 1];
+  int viable = 0;
+  switch (step->specifier) {
+    case 'c':
+      if (step->width || length == 1) {
+        viable = 1;
+      } else {  // the rest of the UTF-8 sequence of a %lc
+        unsigned char lead = (unsigned char)token[0];
+        s21_size_t size = lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : 2;
+        viable = (last & 0xC0) == 0x80 && lead >= 0xC0 && length <= size;
+      }
+      break;
+    case 'd':
+    case 'u':
+      viable = s21_integer_prefix(token, length, 10);
+      break;
+    case 'i':
+      viable = s21_integer_prefix(token, length, 0);
+      break;
+    case 'o':
+      viable = s21_integer_prefix(token, length, 8);
+      break;
+    case 'x':
+    case 'X':
+    case 'p':
+      viable = s21_integer_prefix(token, length, 16);
+      break;
+    case 's':
+      viable = !s21_charset_has(&whitespace, last);
+      break;
+    case '[':
+      viable = s21_charset_has(&step->set, last);
+      break;
+    case '%':
+      viable = length == 1 && last == '%';
+      break;
+    default:
+      viable = s21_float_prefix(token, length);
+  }
+  return viable;
+}
+/**
+ * @brief Tells whether characters begin an integer: a sign, then digits of
+ * the base after an optional "0x" for base 16.
+ *
+ * @param token Pointer to the characters.
+ * @param length Number of characters.
+ * @param base The base, 0 for the base of %i: 16 after "0x", 8 after '0',
+ * otherwise 10.
+ * @return 1 if they begin an integer, otherwise 0.
+ */
+int s21_integer_prefix(const char *token, s21_size_t length, int base) {
+  s21_size_t i = 0;
+  int viable = 1;
+  if (token[0] == '+' || token[0] == '-') i++;
+  if ((base == 0 || base == 16) && length > i + 1 && token[i] == '0' &&
+      (token[i + 1] == 'x' || token[i + 1] == 'X')) {
+    i += 2;
+    base = 16;
+  }
+  if (base == 0) base = i < length && token[i] == '0' ? 8 : 10;
+  while (viable && i < length) {
+    int digit = s21_float_digit((unsigned char)token[i++], 1);
+    viable = digit >= 0 && digit < base;
+  }
+  return viable;
+}
+/**
+ * @brief Tells whether characters begin a floating-point number: a sign,
+ * then "inf", "infinity", "nan", or digits with an optional fraction and
+ * exponent, hexadecimal ones after "0x".
+ *
+ * @param token Pointer to the characters.
+ * @param length Number of characters.
+ * @return 1 if they begin a number, otherwise 0.
+ */
+int s21_float_prefix(const char *token, s21_size_t length) {
+  s21_size_t i = 0;
+  int viable = 1;
+  if (token[0] == '+' || token[0] == '-') i++;
+  int first = i < length ? token[i] | 0x20 : 0;
+  if (first == 'i' || first == 'n') {
+    viable = s21_word_prefix(token + i, length - i,
+                             first == 'i' ? "infinity" : "nan");
+  } else {
+    int hex = length > i + 1 && token[i] == '0' &&
+              (token[i + 1] == 'x' || token[i + 1] == 'X');
+    int digits = 0;
+    int point = 0;
+    s21_size_t exponent = 0;  // position of the exponent character
+    if (hex) i += 2;
+    for (; viable && i < length; i++) {
+      int c = (unsigned char)token[i];
+      if (!exponent && s21_float_digit(c, hex) >= 0) {
+        digits = 1;
+      } else if (!exponent && !point && c == '.') {
+        point = 1;
+      } else if (!exponent && digits && (c | 0x20) == (hex ? 'p' : 'e')) {
+        exponent = i;
+      } else if (exponent && ((i == exponent + 1 && (c == '+' || c == '-')) ||
+                              s21_digit(c))) {
+        viable = 1;
+      } else {
+        viable = 0;
+      }
+    }
+  }
+  return viable;
+}
+/**
+ * @brief Tells whether characters begin a word, ignoring the case.
+ *
+ * @param token Pointer to the characters.
+ * @param length Number of characters.
+ * @param word Pointer to the word in lowercase.
+ * @return 1 if they begin the word, otherwise 0.
+ */
+int s21_word_prefix(const char *token, s21_size_t length, const char *word) {
+  s21_size_t i = 0;
+  while (i < length && word[i] && (token[i] | 0x20) == word[i]) i++;
+  return i == length;
+}
+// __Built-in sources__
+/**
+ * @brief Makes a source that reads a stream with fread, a chunk at a time.
+ *
+ * @param stream The stream, read ahead of what the scanner consumed.
+ * @return The source.
+ */
+source_type s21_source_file(FILE *stream) {
+  source_type source = {s21_file_read, stream};
+  return source;
+}
+/**
+ * @brief Makes a source that reads a file descriptor with read(2).
+ *
+ * @param fd The file descriptor.
+ * @return The source.
+ */
+source_type s21_source_fd(int fd) {
+  source_type source = {s21_fd_read, (void *)(intptr_t)fd};
+  return source;
+}
+/**
+ * @brief Read callback of the stream source.
+ *
+ * @param context The FILE stream.
+ * @param span Pointer to the buffer to fill.
+ * @param size Size of the buffer.
+ * @return The number of characters read, 0 at the end of the stream or -1 on
+ * a read error.
+ */
+long s21_file_read(void *context, char *span, s21_size_t size) {
+  FILE *stream = context;
+  s21_size_t count = fread(span, 1, size, stream);
+  return count ? (long)count : ferror(stream) ? -1 : 0;
+}
+/**
+ * @brief Read callback of the file descriptor source, retries interrupted
+ * calls.
+ *
+ * @param context The file descriptor stored as a pointer.
+ * @param span Pointer to the buffer to fill.
+ * @param size Size of the buffer.
+ * @return The number of characters read, 0 at the end of the file or -1 on a
+ * read error.
+ */
+long s21_fd_read(void *context, char *span, s21_size_t size) {
+  int fd = (int)(intptr_t)context;
+  ssize_t count = -1;
+  do {
+    count = read(fd, span, size);
+  } while (count < 0 && errno == EINTR);
+  return count < 0 ? -1 : (long)count;
+}
@@ -2,34 +2,55 @@
  * @file s21_sprintf.c
  * @brief Implementation of formatted string output function similar to sprintf.
  *
- * This file defines the function s21_sprintf, which formats a string according
- * to a format string and variable arguments, similar to the standard sprintf
- * function.
+ * This file defines the functions s21_sprintf, s21_snprintf and s21_vsnprintf,
+ * which format a string according to a format string and variable arguments,
+ * similar to the standard sprintf family of functions, and their compiled
+ * counterparts s21_sprintf_plan and s21_vsnprintf_plan.
  *
  * Function Overview:
- * - s21_sprintf: Formats a string based on the provided format string and
- * variable arguments.
- *
- * Inside s21_sprintf:
- * - Initializes formatting options and variables using s21_initialize_options.
- * - Processes each character of the format string:
- *   - Copies non-format characters directly to the output buffer.
- *   - Handles format specifiers by parsing options, extracting arguments,
- *     and formatting them using s21_process_format_specifier.
- * - Returns the total number of characters written to the buffer, excluding the
- * null-terminator.
- *
- * This function ensures handling of format specifiers (%d, %f, %s, etc.),
- * manages memory allocation, and handles various edge cases typical of
- * formatted string functions. It is designed to be used in applications where
- * custom formatted string output is required, offering flexibility and
- * efficiency similar to the standard sprintf function.
+ * - s21_vsnprintf: Formats a string based on the provided format string and
+ * va_list into a buffer of a given size.
+ * - s21_snprintf: Variadic wrapper over s21_vsnprintf.
+ * - s21_sprintf: Unbounded variadic wrapper over s21_vsnprintf.
+ * - s21_compile_format: Parses a format string once into a plan_type.
+ * - s21_vsnprintf_plan, s21_sprintf_plan: Execute a compiled plan.
+ * - s21_sprintf_batch: Formats many rows of column arrays with one plan.
+ * - s21_dtoa: Shortest round trip representation of a double.
+ * - s21_emit_*: The typed emitters constant formats are routed to by the
+ * s21_sprintf macro of s21_string.h.
+ *
+ * Inside s21_vsnprintf:
+ * - Splits the format string into steps with s21_parse_step. A step is a
+ *   literal span and the options of the conversion that follows it.
+ * - Executes every step with s21_execute_step:
+ *   - Copies the literal span to the output cursor in one write.
+ *   - Reads '*' width and precision, extracts the argument and formats it
+ *     using s21_process_format_specifier.
+ * - Returns the total number of characters that would have been written if the
+ * buffer was large enough, excluding the null-terminator.
+ *
+ * A plan stores the steps s21_vsnprintf would build, so repeated calls with the
+ * same format skip the parsing. Literal spans point into the original format
+ * string, which must outlive the plan.
+ *
+ * Floats are converted by the exact decimal engine of s21_decimal.c, so every
+ * printed digit is correct and halfway cases round to even like glibc.
+ *
+ * Every conversion writes digits, signs and padding through a single bounded
+ * cursor (cursor_type) straight into the caller's buffer. Intermediate values
+ * are built in the per-call scratch buffer of var, so formatting never touches
+ * the heap.
  *
  *  @note All functions are implemented to closely mimic their standard library
  * counterparts, with necessary adjustments and additional functionalities where
  * needed.
  */
+#ifndef S21_NO_FORMAT_ROUTES
+#define S21_NO_FORMAT_ROUTES  // the functions are defined here
+#endif
+
 #include "s21_sprintf.h"
+#include "s21_stats.h"
 /**
  * @brief Formats a string and writes the result to the buffer 'str'
  *
@@ -42,24 +63,659 @@
  */
 int s21_sprintf(char *str, const char *format, ...) {
   int n = 0;
-  opt options;
   va_list var_arg;
-  var variables = {0};
   va_start(var_arg, format);
-  while (*format) {
-    if (*format != '%') {
-      *str++ = *format++;
-      n += 1;
+  n = s21_vsnprintf(str, (s21_size_t)-1, format, var_arg);
+  va_end(var_arg);
+  return n;
+}
+/**
+ * @brief Formats a string and writes at most 'size' bytes of the result,
+ * including the null-terminator, to the buffer 'str'
+ *
+ * @param str Pointer to the buffer where the formatted string will be stored,
+ * may be NULL when size is 0
+ * @param size Size of the buffer pointed to by 'str'
+ * @param format Pointer to the format string that specifies how to format the
+ * data
+ * @param ... Variable arguments to be formatted according to the format string
+ * @return int The number of characters that would have been written if 'size'
+ * had been sufficiently large, excluding the null-terminator, or -1 on error
+ */
+int s21_snprintf(char *str, s21_size_t size, const char *format, ...) {
+  int n = 0;
+  va_list var_arg;
+  va_start(var_arg, format);
+  n = s21_vsnprintf(str, size, format, var_arg);
+  va_end(var_arg);
+  return n;
+}
+/**
+ * @brief Formats a string from a va_list and writes at most 'size' bytes of the
+ * result, including the null-terminator, to the buffer 'str'
+ *
+ * @param str Pointer to the buffer where the formatted string will be stored,
+ * may be NULL when size is 0
+ * @param size Size of the buffer pointed to by 'str'
+ * @param format Pointer to the format string that specifies how to format the
+ * data
+ * @param var_arg Variable argument list to be formatted according to the format
+ * string
+ * @return int The number of characters that would have been written if 'size'
+ * had been sufficiently large, excluding the null-terminator, or -1 on error
+ */
+int s21_vsnprintf(char *str, s21_size_t size, const char *format,
+                  va_list var_arg) {
+  cursor_type cursor = {str, size, 0, 0, s21_NULL, 0};
+  return s21_format(&cursor, format, s21_NULL, var_arg);
+}
+/**
+ * @brief Formats a va_list through a cursor, from a format string or from a
+ * compiled plan
+ *
+ * @param cursor Pointer to the output cursor, a buffer or a sink
+ * @param format Pointer to the format string, used when 'plan' is NULL
+ * @param plan Pointer to a compiled plan, may be NULL
+ * @param var_arg Variable argument list to be formatted
+ * @return int The number of characters produced, excluding the
+ * null-terminator, or -1 on error
+ */
+int s21_format(cursor_type *cursor, const char *format, const plan_type *plan,
+               va_list var_arg) {
+  int n = 0;
+  step_type step;
+  va_list args;
+  var variables;
+  s21_scratch_init(&variables);
+  va_copy(args, var_arg);
+  if (plan) {
+    for (int i = 0; i < plan->steps_count && !variables.error_flag &&
+                    !cursor->error;
+         i++) {
+      s21_execute_step(cursor, &plan->steps[i], &args, &variables);
+    }
+  } else {
+    while (*format && !variables.error_flag && !cursor->error) {
+      s21_parse_step(&format, &step);
+      s21_execute_step(cursor, &step, &args, &variables);
+    }
+  }
+  va_end(args);
+  s21_scratch_release(&variables);
+  s21_cursor_finish(cursor);
+  S21_STAT_ADD(sprintf_calls, 1);
+  S21_STAT_ADD(bytes_emitted, cursor->length);
+  if (variables.error_flag || cursor->error || cursor->length > INT_MAX) {
+    n = -1;
+  } else {
+    n = (int)cursor->length;
+  }
+  return n;
+}
+// __Plans__
+/**
+ * @brief Compiles a format string into a plan that can be executed repeatedly
+ *
+ * @param plan Pointer to the plan to fill
+ * @param format Pointer to the format string, must outlive the plan
+ * @return int 0 on success, 1 if the format has more than S21_PLAN_MAX_STEPS
+ * steps
+ */
+int s21_compile_format(plan_type *plan, const char *format) {
+  int status = 0;
+  plan->steps_count = 0;
+  while (*format && !status) {
+    if (plan->steps_count == S21_PLAN_MAX_STEPS) {
+      status = 1;
     } else {
-      s21_initialize_options(&options);
-      s21_options(&format, &options, var_arg);
-      s21_process_format_specifier(&str, options, var_arg, &n, &variables);
+      s21_parse_step(&format, &plan->steps[plan->steps_count++]);
     }
   }
+  return status;
+}
+/**
+ * @brief Formats the arguments according to a compiled plan and writes the
+ * result to the buffer 'str'
+ *
+ * @param str Pointer to the buffer where the formatted string will be stored
+ * @param plan Pointer to a plan filled by s21_compile_format
+ * @param ... Variable arguments to be formatted according to the plan
+ * @return int The number of characters written to the buffer, excluding the
+ * null-terminator
+ */
+int s21_sprintf_plan(char *str, const plan_type *plan, ...) {
+  int n = 0;
+  va_list var_arg;
+  va_start(var_arg, plan);
+  n = s21_vsnprintf_plan(str, (s21_size_t)-1, plan, var_arg);
   va_end(var_arg);
-  *str = '\0';
   return n;
 }
+/**
+ * @brief Formats a va_list according to a compiled plan and writes at most
+ * 'size' bytes of the result, including the null-terminator, to the buffer
+ * 'str'
+ *
+ * @param str Pointer to the buffer where the formatted string will be stored,
+ * may be NULL when size is 0
+ * @param size Size of the buffer pointed to by 'str'
+ * @param plan Pointer to a plan filled by s21_compile_format
+ * @param var_arg Variable argument list to be formatted according to the plan
+ * @return int The number of characters that would have been written if 'size'
+ * had been sufficiently large, excluding the null-terminator, or -1 on error
+ */
+int s21_vsnprintf_plan(char *str, s21_size_t size, const plan_type *plan,
+                       va_list var_arg) {
+  cursor_type cursor = {str, size, 0, 0, s21_NULL, 0};
+  return s21_format(&cursor, s21_NULL, plan, var_arg);
+}
+/**
+ * @brief Parses one step of the format string: the literal span up to the next
+ * '%' and the conversion that follows it
+ *
+ * @param format Pointer to the format string (updated past the parsed step)
+ * @param step Pointer to the step to fill
+ */
+void s21_parse_step(const char **format, step_type *step) {
+  step->literal = *format;
+  while (**format && **format != '%') {
+    *format += 1;
+  }
+  step->literal_len = *format - step->literal;
+  s21_initialize_options(&step->options);
+  if (**format == '%') {
+    s21_options(format, &step->options);
+  }
+}
+/**
+ * @brief Writes the literal span of a step and then its conversion
+ *
+ * @param cursor Pointer to the output cursor
+ * @param step Pointer to the step to execute
+ * @param var_arg Pointer to the variable argument list
+ * @param variables Pointer to the variables structure
+ */
+void s21_execute_step(cursor_type *cursor, const step_type *step,
+                      va_list *var_arg, var *variables) {
+  opt options = step->options;
+  s21_cursor_write(cursor, step->literal, step->literal_len);
+  s21_resolve_arguments(&options, var_arg);
+  s21_process_format_specifier(cursor, options, var_arg, variables);
+}
+/**
+ * @brief Replaces width and precision given as '*' with the values taken from
+ * the argument list, a negative precision counting as omitted
+ *
+ * @param options Pointer to the options of the conversion
+ * @param var_arg Pointer to the variable argument list
+ */
+void s21_resolve_arguments(opt *options, va_list *var_arg) {
+  if (options->min_width == S21_FROM_ARGUMENT) {
+    options->min_width = va_arg(*var_arg, int);
+    if (options->min_width < 0) {
+      options->min_width *= -1;
+      options->flags.MINUS = 1;
+    }
+  }
+  if (options->precision == S21_FROM_ARGUMENT) {
+    options->precision = va_arg(*var_arg, int);
+    if (options->precision < 0) options->precision = -1;  // taken as omitted
+  }
+}
+// __Batches__
+/**
+ * @brief Formats many rows with one format back to back into one buffer
+ *
+ * The format is compiled once, then row i of every column is formatted
+ * without a va_list. Every argument a row consumes, a '*' width or precision
+ * included, comes from its own column: a pointer to the first element of an
+ * array of the argument type (int for %d and '*', short for %hd, char for
+ * %c, double for %f, const char * for %s, void * for %p, int for %n, ...).
+ *
+ * @param str Pointer to the buffer, may be NULL when size is 0
+ * @param size Size of the buffer pointed to by 'str', including the
+ * null-terminator written after the last row
+ * @param format Pointer to the format string of one row
+ * @param rows Number of rows to format
+ * @param offsets Array of rows + 1 elements set to the offset of every row and
+ * to the total length, counted like the return value of s21_snprintf, may be
+ * NULL
+ * @param ... The columns, in the order the format consumes its arguments
+ * @return int The length of all the rows, excluding the null-terminator, or -1
+ * on error
+ */
+int s21_sprintf_batch(char *str, s21_size_t size, const char *format,
+                      int rows, s21_size_t *offsets, ...) {
+  int n = -1;
+  plan_type plan;
+  if (!s21_compile_format(&plan, format)) {
+    void *columns[S21_BATCH_MAX_COLUMNS];
+    int count = s21_batch_columns_count(&plan);
+    cursor_type cursor = {str, size, 0, 0, s21_NULL, 0};
+    va_list var_arg;
+    va_start(var_arg, offsets);
+    for (int i = 0; i < count; i++) {
+      columns[i] = va_arg(var_arg, void *);
+    }
+    va_end(var_arg);
+    n = s21_format_batch(&cursor, &plan, rows, columns, offsets);
+  }
+  return n;
+}
+/**
+ * @brief Counts the columns a row of a plan consumes
+ *
+ * @param plan Pointer to a compiled plan
+ * @return int The number of arguments of one row
+ */
+int s21_batch_columns_count(const plan_type *plan) {
+  int count = 0;
+  for (int i = 0; i < plan->steps_count; i++) {
+    opt options = plan->steps[i].options;
+    count += (options.min_width == S21_FROM_ARGUMENT) +
+             (options.precision == S21_FROM_ARGUMENT) +
+             (options.format_spec != NO_SPECIFIER &&
+              options.format_spec != PERCENT_SPECIFIER);
+  }
+  return count;
+}
+/**
+ * @brief Formats rows of columns through a cursor according to a compiled plan
+ *
+ * @param cursor Pointer to the output cursor
+ * @param plan Pointer to a compiled plan
+ * @param rows Number of rows to format
+ * @param columns Array of the columns of one row
+ * @param offsets Array of rows + 1 offsets to fill, may be NULL
+ * @return int The number of characters produced, excluding the
+ * null-terminator, or -1 on error
+ */
+int s21_format_batch(cursor_type *cursor, const plan_type *plan, int rows,
+                     void *const *columns, s21_size_t *offsets) {
+  int n = 0;
+  var variables;
+  s21_scratch_init(&variables);
+  for (int row = 0; row < rows && !variables.error_flag && !cursor->error;
+       row++) {
+    s21_size_t row_start = cursor->length;
+    int column = 0;
+    if (offsets) offsets[row] = row_start;
+    for (int i = 0; i < plan->steps_count && !variables.error_flag &&
+                    !cursor->error;
+         i++) {
+      s21_execute_batch_step(cursor, &plan->steps[i], columns, &column, row,
+                             row_start, &variables);
+    }
+  }
+  if (offsets && rows >= 0) offsets[rows] = cursor->length;
+  s21_scratch_release(&variables);
+  s21_cursor_finish(cursor);
+  S21_STAT_ADD(sprintf_calls, 1);
+  S21_STAT_ADD(bytes_emitted, cursor->length);
+  if (variables.error_flag || cursor->error || cursor->length > INT_MAX) {
+    n = -1;
+  } else {
+    n = (int)cursor->length;
+  }
+  return n;
+}
+/**
+ * @brief Writes the literal span of a step and then its conversion, taking the
+ * arguments from row 'row' of the columns
+ *
+ * @param cursor Pointer to the output cursor
+ * @param step Pointer to the step to execute
+ * @param columns Array of the columns of one row
+ * @param column Pointer to the index of the next column, advanced past the
+ * columns the step consumes
+ * @param row Index of the row
+ * @param row_start Length of the output before the row, for %n
+ * @param variables Pointer to the variables structure
+ */
+void s21_execute_batch_step(cursor_type *cursor, const step_type *step,
+                            void *const *columns, int *column, int row,
+                            s21_size_t row_start, var *variables) {
+  opt options = step->options;
+  s21_cursor_write(cursor, step->literal, step->literal_len);
+  if (options.min_width == S21_FROM_ARGUMENT) {
+    options.min_width = ((const int *)columns[(*column)++])[row];
+    if (options.min_width < 0) {
+      options.min_width *= -1;
+      options.flags.MINUS = 1;
+    }
+  }
+  if (options.precision == S21_FROM_ARGUMENT) {
+    options.precision = ((const int *)columns[(*column)++])[row];
+    if (options.precision < 0) options.precision = -1;  // taken as omitted
+  }
+  if (options.format_spec == PERCENT_SPECIFIER) {
+    s21_perc_specifier(cursor, options);
+  } else if (options.format_spec != NO_SPECIFIER) {
+    s21_process_column_specifier(cursor, options, columns[(*column)++], row,
+                                 (long int)(cursor->length - row_start),
+                                 variables);
+  }
+}
+/**
+ * @brief Formats element 'row' of a column according to the options
+ *
+ * @param cursor Pointer to the output cursor
+ * @param options Struct containing the parsed format options
+ * @param column Pointer to the first element of the column
+ * @param row Index of the element
+ * @param n The number of characters of the row written so far, for %n
+ * @param variables Struct containing additional variables used in formatting
+ */
+void s21_process_column_specifier(cursor_type *cursor, opt options,
+                                  void *column, int row, long int n,
+                                  var *variables) {
+  int wide = options.length_spec == LONG_LOWERCASE_LEN_SPECIFIER;
+  S21_STAT_COUNT(sprintf_specifiers, options.format_spec, S21_STATS_SPECIFIERS);
+  S21_STAT_COUNT(sprintf_widths, s21_stats_width(options.min_width),
+                 S21_STATS_WIDTHS);
+  if (options.format_spec == CHAR_SPECIFIER && wide) {
+    s21_lc_specifier(cursor, options, ((const wchar_t *)column)[row]);
+  } else if (options.format_spec == CHAR_SPECIFIER) {
+    s21_c_specifier(cursor, options, ((const char *)column)[row], variables);
+  } else if (options.format_spec == STRING_SPECIFIER) {
+    s21_s_specifier(cursor, options, ((const void *const *)column)[row]);
+  } else if (s21_is_spec_int(options.format_spec)) {
+    int is_negative = 0;
+    long unsigned u_var =
+        s21_unsigned_column(options, column, row, &is_negative);
+    s21_int_specifiers(cursor, options, u_var, is_negative);
+  } else if (s21_is_spec_float(options.format_spec)) {
+    s21_float_specifiers(
+        cursor, options,
+        options.length_spec == LONG_UPPERCASE_LEN_SPECIFIER
+            ? ((const long double *)column)[row]
+            : ((const double *)column)[row],
+        variables);
+  } else if (options.format_spec == COUNT_SPECIFIER) {
+    if (options.length_spec == SHORT_LEN_SPECIFIER) {
+      ((short int *)column)[row] = n;
+    } else if (wide) {
+      ((long int *)column)[row] = n;
+    } else {
+      ((int *)column)[row] = n;
+    }
+  }
+}
+/**
+ * @brief Reads element 'row' of an integer column, the counterpart of
+ * s21_unsigned_variable
+ *
+ * @param options The format options specifying the format and length
+ * specifiers
+ * @param column Pointer to the first element of the column
+ * @param row Index of the element
+ * @param is_negative Pointer set to -1 if a signed value is negative
+ * @return long unsigned The magnitude of the value
+ */
+long unsigned s21_unsigned_column(opt options, const void *column, int row,
+                                  int *is_negative) {
+  long unsigned u_var = 0;
+  if (options.format_spec == INT_DEC_SPECIFIER ||
+      options.format_spec == INT_HEX_SPECIFIER) {
+    long int int_var = 0;
+    if (options.length_spec == LONG_LOWERCASE_LEN_SPECIFIER) {
+      int_var = ((const long int *)column)[row];
+    } else if (options.length_spec == SHORT_LEN_SPECIFIER) {
+      int_var = ((const short int *)column)[row];
+    } else {
+      int_var = ((const int *)column)[row];
+    }
+    u_var = s21_signed_magnitude(int_var, is_negative);
+  } else if (options.format_spec == POINTER_SPECIFIER) {
+    u_var = (unsigned long)((const void *const *)column)[row];
+  } else if (options.length_spec == LONG_LOWERCASE_LEN_SPECIFIER) {
+    u_var = ((const unsigned long int *)column)[row];
+  } else if (options.length_spec == SHORT_LEN_SPECIFIER) {
+    u_var = ((const unsigned short int *)column)[row];
+  } else {
+    u_var = ((const unsigned int *)column)[row];
+  }
+  return u_var;
+}
+// __Scratch__
+/**
+ * @brief Points the scratch buffer of a call at its stack part
+ *
+ * @param variables Pointer to the variables structure of the call
+ */
+void s21_scratch_init(var *variables) {
+  variables->error_flag = 0;
+  variables->buffer = variables->char_buffer;
+  variables->buffer_size = S21_BUFFER_SIZE;
+}
+/**
+ * @brief Makes the scratch buffer hold at least 'size' bytes, moving it to the
+ * heap when the stack part is too small
+ *
+ * The previous content is not kept, a conversion reserves before it writes.
+ *
+ * @param variables Pointer to the variables structure of the call
+ * @param size Number of bytes the conversion needs
+ * @return int 0 on success, 1 with error_flag set and errno ENOMEM if the
+ * memory cannot be allocated, or EOVERFLOW if the size exceeds INT_MAX
+ */
+int s21_scratch_reserve(var *variables, s21_size_t size) {
+  int status = 0;
+  if (size > (s21_size_t)INT_MAX) {
+    variables->error_flag = 1;
+    errno = EOVERFLOW;  // digit counts are int, like the return value
+    status = 1;
+  } else if (size > variables->buffer_size) {
+    char *buffer = malloc(size);
+    if (buffer) {
+      S21_STAT_ADD(allocations, 1);
+      s21_scratch_release(variables);
+      variables->buffer = buffer;
+      variables->buffer_size = size;
+    } else {
+      variables->error_flag = 1;
+      errno = ENOMEM;
+      status = 1;
+    }
+  }
+  return status;
+}
+/**
+ * @brief Frees the heap part of the scratch buffer, if any
+ *
+ * @param variables Pointer to the variables structure of the call
+ */
+void s21_scratch_release(var *variables) {
+  if (variables->buffer != variables->char_buffer) {
+    free(variables->buffer);
+    s21_scratch_init(variables);
+  }
+}
+// __Shortest__
+/**
+ * @brief Writes the shortest decimal representation of a double that reads
+ * back to the same value
+ *
+ * Fixed-point notation is used for exponents from -4 up to
+ * S21_SHORTEST_MAX_DIGITS - 1, scientific notation otherwise, with no trailing
+ * zeros, the way %g lays out its digits.
+ *
+ * @param str Pointer to the buffer, at least S21_DTOA_SIZE bytes
+ * @param value The value to write
+ * @return int The number of characters written, excluding the null-terminator
+ */
+int s21_dtoa(char *str, double value) {
+  char *buf = str;
+  if (signbit(value) && value == value) {
+    *buf++ = '-';
+  }
+  value = fabs(value);
+  if (value != value) {
+    s21_strcpy(buf, "nan");
+  } else if (value > DBL_MAX) {
+    s21_strcpy(buf, "inf");
+  } else if (value == 0) {
+    s21_strcpy(buf, "0");
+  } else {
+    int exponent = 0, length = 0;
+    length = s21_decimal_shortest(value, buf, &exponent);
+    if ((-4 <= exponent) && (exponent < S21_SHORTEST_MAX_DIGITS)) {
+      int precision = length - 1 - exponent;
+      s21_fixed_layout(buf, length, exponent, (precision > 0) ? precision : 0,
+                       0);
+    } else {
+      s21_exp_layout(buf, length, 0);
+      s21_add_exponent(buf, exponent, 'e');
+    }
+  }
+  return (int)s21_strlen(str);
+}
+// __Format routes__
+/**
+ * @brief Copies a format without conversions, the route of s21_sprintf for a
+ * constant format with no '%'
+ *
+ * @param str Pointer to the buffer where the string will be stored
+ * @param literal The format string
+ * @return int The number of characters written, excluding the null-terminator
+ */
+int s21_emit_literal(char *str, const char *literal) {
+  return s21_emit_span(str, literal, s21_strlen(literal));
+}
+/**
+ * @brief Writes a signed integer, the route of "%d", "%i", "%ld" and "%li"
+ *
+ * @param str Pointer to the buffer where the digits will be stored
+ * @param value The value to write
+ * @return int The number of characters written, excluding the null-terminator
+ */
+int s21_emit_signed(char *str, long value) {
+  char digits_buf[S21_INT_DIGITS_SIZE];
+  char *end = digits_buf + S21_INT_DIGITS_SIZE;
+  char *digits = s21_signed_digits(value, end);
+  return s21_emit_span(str, digits, end - digits);
+}
+/**
+ * @brief Writes an unsigned integer, the route of "%u", "%lu" and "%x"
+ *
+ * @param str Pointer to the buffer where the digits will be stored
+ * @param value The value to write
+ * @param notation The base: 8, 10 or 16 with lowercase digits
+ * @return int The number of characters written, excluding the null-terminator
+ */
+int s21_emit_unsigned(char *str, unsigned long value, unsigned notation) {
+  char digits_buf[S21_INT_DIGITS_SIZE];
+  char *end = digits_buf + S21_INT_DIGITS_SIZE;
+  char *digits = s21_unsigned_digits(value, notation, 0, end);
+  return s21_emit_span(str, digits, end - digits);
+}
+/**
+ * @brief Writes a character, the route of "%c"
+ *
+ * @param str Pointer to the buffer where the character will be stored
+ * @param symbol The character, '\0' included
+ * @return int 1
+ */
+int s21_emit_char(char *str, char symbol) {
+  return s21_emit_span(str, &symbol, 1);
+}
+/**
+ * @brief Copies a string, the route of "%s"
+ *
+ * @param str Pointer to the buffer where the string will be stored
+ * @param string The string to copy
+ * @return int The number of characters written, excluding the null-terminator
+ */
+int s21_emit_string(char *str, const char *string) {
+  return s21_emit_span(str, string, s21_strlen(string));
+}
+/**
+ * @brief Writes a string, a separator and a signed integer, the route of
+ * "%s:%d", "%s=%d" and "%s %d"
+ *
+ * @param str Pointer to the buffer where the result will be stored
+ * @param string The string
+ * @param separator The character between the string and the value
+ * @param value The value
+ * @return int The number of characters written, excluding the null-terminator
+ */
+int s21_emit_pair(char *str, const char *string, char separator, long value) {
+  char digits_buf[S21_INT_DIGITS_SIZE + 1];
+  char *end = digits_buf + S21_INT_DIGITS_SIZE + 1;
+  char *digits = s21_signed_digits(value, end);
+  s21_size_t len = s21_strlen(string);
+  *--digits = separator;
+  s21_memcpy(str, string, len);
+  S21_STAT_ADD(bytes_emitted, len);
+  return (int)len + s21_emit_span(str + len, digits, end - digits);
+}
+/**
+ * @brief Writes a double in fixed-point notation, the route of "%f" and
+ * "%.0f" to "%.9f"
+ *
+ * The digits come from the exact decimal engine of s21_float_specifiers,
+ * only the parsing of the format and the reading of the argument are skipped.
+ *
+ * @param str Pointer to the buffer where the result will be stored
+ * @param value The value to write
+ * @param precision The number of digits after the decimal point
+ * @return int The number of characters written, excluding the null-terminator,
+ * or -1 on error
+ */
+int s21_emit_fixed(char *str, double value, int precision) {
+  cursor_type cursor = {str, (s21_size_t)-1, 0, 0, s21_NULL, 0};
+  opt options;
+  var variables;
+  int n = 0;
+  s21_initialize_options(&options);
+  options.format_spec = FLOAT_SPECIFIER;
+  options.precision = precision;
+  s21_scratch_init(&variables);
+  s21_float_specifiers(&cursor, options, value, &variables);
+  s21_scratch_release(&variables);
+  s21_cursor_finish(&cursor);
+  S21_STAT_ADD(sprintf_calls, 1);
+  S21_STAT_ADD(bytes_emitted, cursor.length);
+  if (variables.error_flag || cursor.length > INT_MAX) {
+    n = -1;
+  } else {
+    n = (int)cursor.length;
+  }
+  return n;
+}
+/**
+ * @brief Writes the decimal digits of a signed integer, with a '-' if it is
+ * negative, right to left so that the last digit lands just before 'end'
+ *
+ * @param value The value to write
+ * @param end Pointer just past the buffer, the buffer must hold
+ * S21_INT_DIGITS_SIZE characters
+ * @return Pointer to the first character
+ */
+char *s21_signed_digits(long value, char *end) {
+  int is_negative = 0;
+  char *digits = s21_unsigned_digits(s21_signed_magnitude(value, &is_negative),
+                                     10, 0, end);
+  if (is_negative < 0) {
+    *--digits = '-';
+  }
+  return digits;
+}
+/**
+ * @brief Copies the output of a routed conversion and null-terminates it
+ *
+ * @param str Pointer to the buffer where the output will be stored
+ * @param span The characters to copy
+ * @param len Number of characters
+ * @return int len
+ */
+int s21_emit_span(char *str, const char *span, s21_size_t len) {
+  s21_memcpy(str, span, len);
+  str[len] = '\0';
+  S21_STAT_ADD(sprintf_calls, 1);
+  S21_STAT_ADD(bytes_emitted, len);
+  return (int)len;
+}
 // __Initialization__
 /**
  * @brief Initializes the format options structure with default values
@@ -80,12 +736,11 @@ void s21_initialize_options(opt *options) {
  * @param format Pointer to the format string (updated as options are read)
  * @param options Pointer to the options structure to store the extracted
  * options
- * @param var_arg Variable argument list containing the additional arguments
  */
-void s21_options(const char **format, opt *options, va_list var_arg) {
+void s21_options(const char **format, opt *options) {
   s21_set_format_flags(format, options);
-  s21_min_width(format, options, var_arg);
-  s21_precision(format, options, var_arg);
+  s21_min_width(format, options);
+  s21_precision(format, options);
   s21_length_spec(format, options);
   s21_format_spec(format, options);
 }
@@ -127,20 +782,15 @@ void s21_set_format_flags(const char **format, opt *options) {
  *
  * @param format Pointer to the format string (updated to skip processed width
  * field)
- * @param options Pointer to the options struct where min_width is set
- * @param var_arg va_list for retrieving arguments (used when width is specified
- * as '*')
+ * @param options Pointer to the options struct where min_width is set,
+ * S21_FROM_ARGUMENT when width is specified as '*'
  */
-void s21_min_width(const char **format, opt *options, va_list var_arg) {
+void s21_min_width(const char **format, opt *options) {
   int min_width = -1;
   if ((**format > 47) && (**format < 58)) {
     min_width = s21_atoi(format);
   } else if (**format == '*') {
-    min_width = va_arg(var_arg, int);
-    if (min_width < 0) {
-      min_width *= -1;
-      options->flags.MINUS = 1;
-    }
+    min_width = S21_FROM_ARGUMENT;
     *format += 1;
   }
   options->min_width = min_width;
@@ -151,18 +801,17 @@ void s21_min_width(const char **format, opt *options, va_list var_arg) {
  *
  * @param format Pointer to the format string (updated to skip processed
  * precision field)
- * @param options Pointer to the options struct where precision is set
- * @param var_arg va_list for retrieving arguments (used when precision is
- * specified as '*')
+ * @param options Pointer to the options struct where precision is set,
+ * S21_FROM_ARGUMENT when precision is specified as '*'
  */
-void s21_precision(const char **format, opt *options, va_list var_arg) {
+void s21_precision(const char **format, opt *options) {
   int precision = -1;
   if ((**format == '.') && *(*format + 1)) {
     *format += 1;
     if ((**format > 47) && (**format < 58)) {
       precision = s21_atoi(format);
     } else if (**format == '*') {
-      precision = va_arg(var_arg, int);
+      precision = S21_FROM_ARGUMENT;
       *format += 1;
     } else {
       precision = 0;
@@ -224,77 +873,257 @@ int s21_atoi(const char **str) {
   }
   return res;
 }
+// __Cursor__
+/**
+ * @brief Calculates how many characters can still be stored by the cursor.
+ *
+ * Without a sink one byte stays reserved for the null-terminator. With a sink
+ * the buffer is a staging area and can be filled completely.
+ *
+ * @param cursor Pointer to the output cursor.
+ * @return The number of characters that still fit into the buffer.
+ */
+s21_size_t s21_cursor_room(const cursor_type *cursor) {
+  s21_size_t used = cursor->length - cursor->flushed;
+  s21_size_t room = 0;
+  if (!cursor->sink) used += 1;  // the null-terminator
+  if (cursor->capacity > used) {
+    room = cursor->capacity - used;
+  }
+  return room;
+}
+/**
+ * @brief Hands the staged characters to the sink and empties the staging
+ * buffer.
+ *
+ * @param cursor Pointer to the output cursor, does nothing without a sink.
+ */
+void s21_cursor_drain(cursor_type *cursor) {
+  s21_size_t used = cursor->length - cursor->flushed;
+  if (cursor->sink && used) {
+    if (!cursor->error &&
+        cursor->sink->write(cursor->sink->context, cursor->buffer, used)) {
+      cursor->error = 1;
+    }
+    cursor->flushed = cursor->length;
+  }
+}
+/**
+ * @brief Writes one character through the cursor.
+ *
+ * @param cursor Pointer to the output cursor (length is always advanced).
+ * @param symbol The character to write.
+ */
+void s21_cursor_put(cursor_type *cursor, char symbol) {
+  if (!s21_cursor_room(cursor)) s21_cursor_drain(cursor);
+  if (s21_cursor_room(cursor)) {
+    cursor->buffer[cursor->length - cursor->flushed] = symbol;
+  }
+  cursor->length += 1;
+}
+/**
+ * @brief Writes a span of characters through the cursor, storing only the part
+ * that fits into the buffer.
+ *
+ * A span that does not fit into an empty staging buffer goes to the sink in
+ * one call instead of being copied piece by piece.
+ *
+ * @param cursor Pointer to the output cursor (length is always advanced).
+ * @param span Pointer to the characters to write.
+ * @param len Number of characters to write.
+ */
+void s21_cursor_write(cursor_type *cursor, const char *span, s21_size_t len) {
+  s21_size_t room = s21_cursor_room(cursor);
+  if (cursor->sink && len > room) {
+    s21_cursor_drain(cursor);
+    room = s21_cursor_room(cursor);
+  }
+  if (cursor->sink && len > room) {
+    if (!cursor->error && cursor->sink->write(cursor->sink->context, span, len))
+      cursor->error = 1;
+    cursor->flushed += len;
+  } else if (room) {
+    s21_memcpy(cursor->buffer + cursor->length - cursor->flushed, span,
+               len < room ? len : room);
+  }
+  cursor->length += len;
+}
+/**
+ * @brief Writes 'count' copies of the filler character through the cursor.
+ *
+ * @param cursor Pointer to the output cursor (length is always advanced).
+ * @param filler The character to repeat.
+ * @param count Number of characters to write.
+ */
+void s21_cursor_fill(cursor_type *cursor, char filler, s21_size_t count) {
+  while (count) {
+    if (!s21_cursor_room(cursor)) s21_cursor_drain(cursor);
+    s21_size_t room = s21_cursor_room(cursor);
+    s21_size_t chunk = count < room ? count : room;
+    if (chunk) {
+      s21_memset(cursor->buffer + cursor->length - cursor->flushed, filler,
+                 chunk);
+    }
+    if (!cursor->sink) chunk = count;  // the rest does not fit anyway
+    cursor->length += chunk;
+    count -= chunk;
+  }
+}
+/**
+ * @brief Null-terminates the stored part of the output, or drains and flushes
+ * the sink.
+ *
+ * @param cursor Pointer to the output cursor.
+ */
+void s21_cursor_finish(cursor_type *cursor) {
+  if (cursor->sink) {
+    s21_cursor_drain(cursor);
+    if (cursor->sink->flush && cursor->sink->flush(cursor->sink->context))
+      cursor->error = 1;
+  } else if (cursor->capacity) {
+    if (cursor->length < cursor->capacity) {
+      cursor->buffer[cursor->length] = '\0';
+    } else {
+      cursor->buffer[cursor->capacity - 1] = '\0';
+    }
+  }
+}
+// __Layout__
+/**
+ * @brief Describes an unpadded value: sign, prefix and body.
+ *
+ * @param layout Pointer to the layout to initialize.
+ * @param sign The sign character, '\0' for none.
+ * @param prefix The base prefix, s21_NULL for none.
+ * @param body The digits or text of the value.
+ * @param body_len Length of the body.
+ */
+void s21_layout_init(layout_type *layout, char sign, const char *prefix,
+                     const char *body, s21_size_t body_len) {
+  layout->left_pad = 0;
+  layout->sign = sign;
+  layout->prefix = prefix ? prefix : "";
+  layout->prefix_len = s21_strlen(layout->prefix);
+  layout->zeros = 0;
+  layout->body = body;
+  layout->body_len = body_len;
+  layout->right_pad = 0;
+}
+/**
+ * @brief Computes the padding that brings a value to the minimum width.
+ *
+ * @param layout Pointer to the layout, its zeros already hold the precision.
+ * @param options The format options containing minimum width and flags.
+ * @param zero_pad 1 if the ZERO flag pads with zeros after the sign and
+ * prefix, 0 if the value is always padded with spaces.
+ */
+void s21_layout_pad(layout_type *layout, opt options, int zero_pad) {
+  s21_size_t used = (layout->sign != '\0') + layout->prefix_len +
+                    layout->zeros + layout->body_len;
+  s21_size_t n_fillers = s21_width_fillers(used, options);
+  if (options.flags.MINUS) {
+    layout->right_pad = n_fillers;
+  } else if (zero_pad && options.flags.ZERO) {
+    layout->zeros += n_fillers;
+  } else {
+    layout->left_pad = n_fillers;
+  }
+}
+/**
+ * @brief Writes a laid out value through the cursor in one pass.
+ *
+ * @param cursor Pointer to the output cursor.
+ * @param layout Pointer to the layout of the value.
+ */
+void s21_layout_emit(cursor_type *cursor, const layout_type *layout) {
+  s21_cursor_fill(cursor, ' ', layout->left_pad);
+  if (layout->sign != '\0') {
+    s21_cursor_put(cursor, layout->sign);
+  }
+  s21_cursor_write(cursor, layout->prefix, layout->prefix_len);
+  s21_cursor_fill(cursor, '0', layout->zeros);
+  s21_cursor_write(cursor, layout->body, layout->body_len);
+  s21_cursor_fill(cursor, ' ', layout->right_pad);
+}
 // __Process__
 /**
- * @brief Processes the format specifier and updates the output string and
- * character count
+ * @brief Processes the format specifier and writes the formatted output
+ * through the cursor
  *
- * @param str Pointer to the output string (updated as formatted output is
+ * @param cursor Pointer to the output cursor (advanced as formatted output is
  * written)
  * @param options Struct containing the parsed format options
- * @param var_arg Variable argument list containing the additional arguments
- * @param n Pointer to the character count (updated as formatted output is
- * written)
+ * @param var_arg Pointer to the variable argument list containing the
+ * additional arguments
  * @param variables Struct containing additional variables used in formatting
  */
-void s21_process_format_specifier(char **str, opt options, va_list var_arg,
-                                  int *n, var *variables) {
-  if (options.format_spec == CHAR_SPECIFIER) {
-    *n += s21_c_specifier(str, options, var_arg, variables);
+void s21_process_format_specifier(cursor_type *cursor, opt options,
+                                  va_list *var_arg, var *variables) {
+  S21_STAT_COUNT(sprintf_specifiers, options.format_spec, S21_STATS_SPECIFIERS);
+  S21_STAT_COUNT(sprintf_widths, s21_stats_width(options.min_width),
+                 S21_STATS_WIDTHS);
+  if (options.format_spec == CHAR_SPECIFIER &&
+      options.length_spec == LONG_LOWERCASE_LEN_SPECIFIER) {
+    s21_lc_specifier(cursor, options, s21_char_variable(options, var_arg));
+  } else if (options.format_spec == CHAR_SPECIFIER) {
+    s21_c_specifier(cursor, options, (char)s21_char_variable(options, var_arg),
+                    variables);
   } else if (options.format_spec == STRING_SPECIFIER) {
-    *n += s21_s_specifier(str, options, var_arg, variables);
+    s21_s_specifier(cursor, options, s21_string_variable(options, var_arg));
   } else if (s21_is_spec_int(options.format_spec)) {
-    *n += s21_int_specifiers(str, options, var_arg, variables);
+    int is_negative = 0;
+    long unsigned u_var = s21_unsigned_variable(options, var_arg, &is_negative);
+    s21_int_specifiers(cursor, options, u_var, is_negative);
   } else if (s21_is_spec_float(options.format_spec)) {
     long double double_var = 0L;
     double_var = s21_double_variable(options, var_arg);
-    if (options.format_spec == FLOAT_SPECIFIER) {
-      *n += s21_f_specifier(str, options, double_var, variables);
-    } else if (options.format_spec == FLOAT_EXP_LOW_SPECIFIER ||
-               options.format_spec == FLOAT_EXP_UP_SPECIFIER) {
-      *n += s21_e_specifiers(str, options, double_var, variables);
-    } else {
-      *n += s21_g_specifiers(str, &options, double_var, variables);
-    }
+    s21_float_specifiers(cursor, options, double_var, variables);
   } else if (options.format_spec == PERCENT_SPECIFIER) {
-    *n += s21_perc_specifier(str, options, variables);
+    s21_perc_specifier(cursor, options);
   } else if (options.format_spec == COUNT_SPECIFIER) {
-    s21_n_specifier(options, var_arg, *n);
-  } else {
-    **str = '\0';
+    s21_n_specifier(options, var_arg, (long int)cursor->length);
   }
 }
 /**
  * @brief Handles the %c format specifier for character in sprintf function.
  *
- * @param str Pointer to the destination string where the formatted output is
- * stored.
+ * @param cursor Pointer to the output cursor.
  * @param options Formatting options (flags, width, precision, etc.).
- * @param var_arg Arguments list containing the character argument.
+ * @param symbol The character to write.
  * @param variables Struct to hold intermediate values during formatting.
- * @return Number of characters written to the destination string.
  */
-int s21_c_specifier(char **str, opt options, va_list var_arg, var *variables) {
-  variables->char_buffer = calloc(2, sizeof(*variables->char_buffer));
-  s21_mem_check(variables->char_buffer, variables);
-  s21_handle_char_specifier(options, var_arg, variables);
-  s21_apply_width(&(variables->char_buffer), options, variables);
-  return (s21_buffer_to_string(str, variables));
+void s21_c_specifier(cursor_type *cursor, opt options, char symbol,
+                     var *variables) {
+  (variables->buffer)[0] = symbol;
+  (variables->buffer)[1] = '\0';
+  s21_apply_width(cursor, variables->buffer, 1, options);
+}
+/**
+ * @brief Handles the %lc format specifier, the character written as UTF-8.
+ *
+ * @param cursor Pointer to the output cursor.
+ * @param options Formatting options (flags, width, precision, etc.).
+ * @param symbol The wide character.
+ */
+void s21_lc_specifier(cursor_type *cursor, opt options, wchar_t symbol) {
+  char sequence[S21_UTF8_MAX];
+  int size = s21_utf8_encode((unsigned long)symbol, sequence);
+  if (size == 0) {
+    cursor->error = 1;
+    errno = EILSEQ;
+  } else {
+    s21_apply_width(cursor, sequence, size, options);
+  }
 }
 /**
  * @brief Handles the %s format specifier for string in sprintf function.
  *
- * @param str Pointer to the destination string where the formatted output is
- * stored.
+ * @param cursor Pointer to the output cursor.
  * @param options Formatting options (flags, width, precision, etc.).
- * @param var_arg Arguments list containing the string argument.
- * @param variables Struct to hold intermediate values during formatting.
- * @return Number of characters written to the destination string.
+ * @param string The char or, with the 'l' modifier, wchar_t string.
  */
-int s21_s_specifier(char **str, opt options, va_list var_arg, var *variables) {
-  s21_handle_format_specifier(options, var_arg, variables);
-  s21_apply_width(&(variables->char_buffer), options, variables);
-  return (s21_buffer_to_string(str, variables));
+void s21_s_specifier(cursor_type *cursor, opt options, const void *string) {
+  s21_handle_format_specifier(cursor, options, string);
 }
 /**
  * @brief Checks if the given specifier type is an integer specifier.
@@ -313,51 +1142,74 @@ int s21_is_spec_int(specifier_type spec) {
   return res;
 }
 /**
- * @brief Handles integer specifiers in formatted output.
+ * @brief Handles integer specifiers (%d, %i, %u, %o, %x, %X, %p): the digits
+ * are written right to left into a stack buffer and laid out with the sign,
+ * prefix and padding, so they reach the output without being copied first.
  *
- * @param str Pointer to the output string.
- * @param options Formatting options.
- * @param var_arg Variable argument list.
- * @param variables Additional variables for tracking.
- * @return Length of the formatted string.
+ * @param cursor Pointer to the output cursor.
+ * @param options Format options containing flags, width, precision, etc.
+ * @param u_var The magnitude of the value.
+ * @param is_negative -1 if a signed value is negative.
  */
-int s21_int_specifiers(char **str, opt options, va_list var_arg,
-                       var *variables) {
-  long unsigned u_var = 0;
-  int len = 0, is_negative = 0, notation = 10;
-  char *buf = s21_NULL;
-  char sign = '\0';
-  u_var = s21_unsigned_variable(options, var_arg, &is_negative);
-  if (options.format_spec == OCTAL_SPECIFIER) {
-    notation = 8;
-  } else if (options.format_spec == HEX_LOW_SPECIFIER ||
-             options.format_spec == HEX_UP_SPECIFIER ||
-             options.format_spec == POINTER_SPECIFIER) {
-    notation = 16;
-  }
+void s21_int_specifiers(cursor_type *cursor, opt options, long unsigned u_var,
+                        int is_negative) {
+  char digits_buf[S21_INT_DIGITS_SIZE], sign = '\0';
+  char *end = digits_buf + S21_INT_DIGITS_SIZE, *digits = s21_NULL;
+  s21_size_t len = 0;
+  layout_type layout;
   s21_char_sign(is_negative, &sign, options);
-  buf = s21_unsigned_to_str(u_var, notation,
-                            options.format_spec == HEX_UP_SPECIFIER);
-  if (options.precision != -1) {
-    s21_apply_num_precision(&buf, options.precision);
-  } else if (options.flags.ZERO && !options.flags.MINUS &&
-             options.min_width > 0) {
-    s21_apply_num_precision(&buf, options.min_width - (sign != '\0'));
+  digits = s21_unsigned_digits(u_var, s21_notation(options.format_spec),
+                               options.format_spec == HEX_UP_SPECIFIER, end);
+  len = end - digits;
+  if (options.precision == 0 && u_var == 0) {
+    len = 0;
   }
-  if (u_var != 0 || options.format_spec == POINTER_SPECIFIER ||
-      (u_var == 0 && options.format_spec == OCTAL_SPECIFIER &&
-       options.precision == 0)) {
-    s21_add_notation(&buf, options);
+  s21_layout_init(&layout, sign, s21_notation_prefix(options, u_var), digits,
+                  len);
+  if (options.precision > 0 && (s21_size_t)options.precision > len) {
+    layout.zeros = options.precision - len;
   }
-  s21_add_sign(&buf, sign);
-  if (options.flags.MINUS || !options.flags.ZERO) {
-    s21_apply_width(&buf, options, variables);
+  if (options.format_spec == OCTAL_SPECIFIER && options.flags.SHARP &&
+      layout.zeros == 0 && (u_var != 0 || len == 0)) {
+    layout.zeros = 1;  // the leading zero of %#o is part of the number
   }
-  if (buf) {
-    variables->char_buffer = buf;
-    len = s21_buffer_to_string(str, variables);
+  s21_layout_pad(&layout, options, options.precision == -1);
+  s21_layout_emit(cursor, &layout);
+}
+/**
+ * @brief Returns the base of an integer specifier.
+ *
+ * @param spec The specifier type.
+ * @return 8 for %o, 16 for %x, %X and %p, otherwise 10.
+ */
+unsigned s21_notation(specifier_type spec) {
+  unsigned notation = 10;
+  if (spec == OCTAL_SPECIFIER) {
+    notation = 8;
+  } else if (spec == HEX_LOW_SPECIFIER || spec == HEX_UP_SPECIFIER ||
+             spec == POINTER_SPECIFIER) {
+    notation = 16;
   }
-  return len;
+  return notation;
+}
+/**
+ * @brief Returns the base prefix of a hexadecimal conversion.
+ *
+ * @param options Formatting options that dictate which notation to add.
+ * @param u_var The value being converted, %#x adds no prefix to zero.
+ * @return "0x", "0X" or an empty string.
+ */
+const char *s21_notation_prefix(opt options, long unsigned u_var) {
+  const char *prefix = "";
+  if (options.format_spec == POINTER_SPECIFIER ||
+      (options.format_spec == HEX_LOW_SPECIFIER && options.flags.SHARP &&
+       u_var != 0)) {
+    prefix = "0x";
+  } else if (options.format_spec == HEX_UP_SPECIFIER && options.flags.SHARP &&
+             u_var != 0) {
+    prefix = "0X";
+  }
+  return prefix;
 }
 /**
  * @brief Checks if the specifier type is a floating point specifier.
@@ -379,365 +1231,362 @@ int s21_is_spec_float(specifier_type spec) {
  * specifier.
  *
  * @param options The format options containing length specifier.
- * @param var_arg The va_list containing the variable arguments.
+ * @param var_arg Pointer to the va_list containing the variable arguments.
  * @return The extracted double or long double variable.
  */
-long double s21_double_variable(opt options, va_list var_arg) {
+long double s21_double_variable(opt options, va_list *var_arg) {
   long double double_var = 0;
   if (options.length_spec == LONG_UPPERCASE_LEN_SPECIFIER) {
-    double_var = va_arg(var_arg, long double);
+    double_var = va_arg(*var_arg, long double);
   } else {
-    double_var = va_arg(var_arg, double);
+    double_var = va_arg(*var_arg, double);
   }
   return double_var;
 }
 /**
- * @brief Handles the %f specifier for floating-point numbers in the custom
- * printf function.
+ * @brief Handles the %f, %e, %E, %g and %G specifiers: converts the value to an
+ * exact decimal once and lays out its digits.
  *
- * @param str Pointer to the output string.
+ * @param cursor Pointer to the output cursor.
  * @param options Format options containing flags, width, precision, etc.
  * @param double_var The floating-point variable to format.
- * @param variables Structure holding temporary variables and buffers.
- * @return The number of characters written to the output string.
- */
-int s21_f_specifier(char **str, opt options, long double double_var,
-                    var *variables) {
-  int is_negative = 1, len = 0;
-  long double tens = 0.;  // tens - старшие разряды числа (десятки и выше),
-  long double ones = 0.;  // ones - младшие (единицы и ниже)
-  char *ones_buf = s21_NULL, *tens_buf = s21_NULL, *buf = s21_NULL;
-  char sign = '\0';
-  is_negative = (double_var < 0) ? -1 : 1;
-  s21_char_sign(is_negative, &sign, options);
-  double_var = double_var * is_negative;
+ * @param variables Structure holding the error flag and the scratch buffers.
+ */
+void s21_float_specifiers(cursor_type *cursor, opt options,
+                          long double double_var, var *variables) {
+  int overflow = 0, finite = 0;
+  char *buf = variables->buffer, sign = '\0';
+  layout_type layout;
+  s21_char_sign(signbit(double_var) ? -1 : 1, &sign, options);
+  double_var = fabsl(double_var);
   if (double_var <= LDBL_MAX) {
-    int next_digit = 0;
-    s21_split_float(double_var, &ones, &tens);
-    tens_buf = s21_float_to_str(tens);
-    ones_buf = s21_mantissa_to_str(ones, &next_digit, options);
-    buf = s21_sum_and_free_strings(tens_buf, ones_buf);
-    s21_math_rounding(&buf, next_digit, s21_NULL, s21_NULL);
-    s21_delete_trailing_zeros(&buf, options);
-    if (options.flags.ZERO && !options.flags.MINUS && options.min_width > 0) {
-      s21_apply_num_precision(&buf, options.min_width - (sign != '\0'));
+    finite = 1;
+    s21_decimal_from_float(double_var, &variables->decimal);
+    overflow = s21_scratch_reserve(
+        variables, s21_float_scratch_size(&variables->decimal, options));
+    buf = variables->buffer;
+    if (!overflow) {
+      overflow = s21_float_layout(&variables->decimal, options, buf,
+                                  variables->buffer_size);
     }
   } else {
-    buf = s21_nan_inf(double_var, &sign, options.format_spec);
+    s21_nan_inf(double_var, &sign, options.format_spec, buf);
   }
-  s21_add_sign(&buf, sign);
-  if (options.flags.MINUS || !options.flags.ZERO) {
-    s21_apply_width(&buf, options, variables);
-  }
-  if (buf) {
-    variables->char_buffer = buf;
-    len = s21_buffer_to_string(str, variables);
+  if (overflow) {
+    variables->error_flag = 1;
+  } else {
+    s21_layout_init(&layout, sign, s21_NULL, buf, s21_strlen(buf));
+    s21_layout_pad(&layout, options, finite);  // inf and nan pad with spaces
+    s21_layout_emit(cursor, &layout);
   }
-  return len;
 }
 /**
- * @brief Handles the %e and %E specifiers for scientific notation in the custom
- * printf function.
+ * @brief Lays out a decimal with the notation of the specifier.
  *
- * @param str Pointer to the output string.
- * @param options Format options containing flags, width, precision, etc.
- * @param double_var The floating-point variable to format.
- * @param variables Structure holding temporary variables and buffers.
- * @return The number of characters written to the output string.
+ * @param decimal Pointer to the exact decimal value.
+ * @param options Format options containing flags, precision and specifier.
+ * @param buf The buffer where the digits are stored.
+ * @param size Size of the buffer.
+ * @return 0 on success, 1 if the number does not fit into the buffer.
  */
-int s21_e_specifiers(char **str, opt options, long double double_var,
-                     var *variables) {
-  int is_negative = 1, len = 0;
-  char *buf = s21_NULL, sign = '\0';
-  is_negative = (double_var < 0) ? -1 : 1;
-  s21_char_sign(is_negative, &sign, options);
-  double_var = double_var * is_negative;
-  if ((double_var <= LDBL_MAX &&
-       options.length_spec == LONG_UPPERCASE_LEN_SPECIFIER) ||
-      (double_var <= DBL_MAX &&
-       options.length_spec != LONG_UPPERCASE_LEN_SPECIFIER)) {
-    unsigned u_exponent = 0;
-    long double mantissa = 0.;
-    int next_digit = 0;
-    char *mant_buf = s21_NULL, *exp_buf = s21_NULL, exp_sign = '\0',
-         e_char = '\0';
-    e_char = (options.format_spec == FLOAT_EXP_UP_SPECIFIER ||
-              options.format_spec == EXP_UP_SPECIFIER)
-                 ? 'E'
-                 : 'e';
-    mantissa = double_var;
-    exp_sign = (mantissa < 1. && mantissa >= LDBL_TRUE_MIN) ? '-' : '+';
-    u_exponent = s21_exponent(&mantissa);
-    mant_buf = s21_mantissa_to_str(mantissa, &next_digit, options);
-    s21_math_rounding(&mant_buf, next_digit, &exp_sign, &u_exponent);
-    s21_delete_trailing_zeros(&mant_buf, options);
-    exp_buf = s21_unsigned_to_str(u_exponent, 10, 0);
-    s21_apply_num_precision(&exp_buf, 2);
-    s21_add_sign(&exp_buf, exp_sign);
-    s21_add_sign(&exp_buf, e_char);
-    buf = s21_sum_and_free_strings(mant_buf, exp_buf);
-    if (options.flags.ZERO && !options.flags.MINUS && options.min_width > 0) {
-      s21_apply_num_precision(&buf, options.min_width - (sign != '\0'));
-    }
+int s21_float_layout(const decimal_type *decimal, opt options, char *buf,
+                     s21_size_t size) {
+  int overflow = 0;
+  if (options.format_spec == FLOAT_SPECIFIER) {
+    overflow = s21_f_specifier(decimal, options, buf, size);
+  } else if (options.format_spec == FLOAT_EXP_LOW_SPECIFIER ||
+             options.format_spec == FLOAT_EXP_UP_SPECIFIER) {
+    overflow = s21_e_specifiers(decimal, options, buf, size);
   } else {
-    buf = s21_nan_inf(double_var, &sign, options.format_spec);
+    overflow = s21_g_specifiers(decimal, options, buf, size);
   }
-  s21_add_sign(&buf, sign);
-  if (options.flags.MINUS || !options.flags.ZERO) {
-    s21_apply_width(&buf, options, variables);
+  return overflow;
+}
+/**
+ * @brief Returns the scratch size a float conversion needs.
+ *
+ * @param decimal Pointer to the exact decimal value.
+ * @param options Format options containing flags, width and precision.
+ * @return Bytes for the integer digits, the precision, %g switching to fixed
+ * notation and S21_BUFFER_RESERVE; the width padding is never stored.
+ */
+s21_size_t s21_float_scratch_size(const decimal_type *decimal, opt options) {
+  int exponent = s21_decimal_exponent(decimal);
+  s21_size_t precision = (options.precision >= 0) ? options.precision : 6;
+  s21_size_t size = (exponent > 0) ? (s21_size_t)exponent + 1 : 1;
+  size += precision + S21_BUFFER_RESERVE + 8;
+  return size;
+}
+/**
+ * @brief Lays out a decimal in fixed-point notation for the %f specifier.
+ *
+ * @param decimal Pointer to the exact decimal value.
+ * @param options Format options containing flags and precision.
+ * @param buf The buffer where the digits are stored.
+ * @param size Size of the buffer.
+ * @return 0 on success, 1 if the number does not fit into the buffer.
+ */
+int s21_f_specifier(const decimal_type *decimal, opt options, char *buf,
+                    s21_size_t size) {
+  int precision = (options.precision >= 0) ? options.precision : 6;
+  int exponent = s21_decimal_exponent(decimal), overflow = 0;
+  s21_size_t int_len = (exponent > 0) ? (s21_size_t)exponent + 1 : 1;
+  if (int_len + (s21_size_t)precision + S21_BUFFER_RESERVE < size) {
+    int length = s21_decimal_round(decimal, exponent + 1 + precision, buf,
+                                   &exponent);
+    s21_fixed_layout(buf, length, exponent, precision, options.flags.SHARP);
+  } else {
+    overflow = 1;
   }
-  if (buf) {
-    variables->char_buffer = buf;
-    len = s21_buffer_to_string(str, variables);
+  return overflow;
+}
+/**
+ * @brief Lays out a decimal in scientific notation for the %e and %E
+ * specifiers.
+ *
+ * @param decimal Pointer to the exact decimal value.
+ * @param options Format options containing flags, precision and specifier.
+ * @param buf The buffer where the digits are stored.
+ * @param size Size of the buffer.
+ * @return 0 on success, 1 if the number does not fit into the buffer.
+ */
+int s21_e_specifiers(const decimal_type *decimal, opt options, char *buf,
+                     s21_size_t size) {
+  int precision = (options.precision >= 0) ? options.precision : 6;
+  int overflow = 0;
+  if ((s21_size_t)precision + S21_BUFFER_RESERVE < size) {
+    int exponent = 0, length = 0;
+    char e_char = (options.format_spec == FLOAT_EXP_UP_SPECIFIER ||
+                   options.format_spec == EXP_UP_SPECIFIER)
+                      ? 'E'
+                      : 'e';
+    length = s21_decimal_round(decimal, precision + 1, buf, &exponent);
+    s21_exp_layout(buf, length, options.flags.SHARP);
+    s21_add_exponent(buf, exponent, e_char);
+  } else {
+    overflow = 1;
   }
-  return len;
+  return overflow;
 }
 /**
  * @brief Handles the %g and %G specifiers for formatting floating-point numbers
  *        in either fixed-point or scientific notation, based on the value and
  * precision.
  *
- * @param str Pointer to the output string.
- * @param options Pointer to the format options containing flags, width,
- * precision, etc.
- * @param double_var The floating-point variable to format.
- * @param variables Structure holding temporary variables and buffers.
- * @return The number of characters written to the output string.
+ * The digits are rounded once and laid out straight in the chosen notation,
+ * without the '#' flag their trailing zeros are dropped before the layout.
+ *
+ * @param decimal Pointer to the exact decimal value.
+ * @param options Format options containing flags, precision and specifier.
+ * @param buf The buffer where the digits are stored.
+ * @param size Size of the buffer.
+ * @return 0 on success, 1 if the number does not fit into the buffer.
  */
-int s21_g_specifiers(char **str, opt *options, long double double_var,
-                     var *variables) {
-  int len = 0, exp_check = 0;
-  long double double_var_temporary_buffer = 0;
-
-  double_var_temporary_buffer = (double_var >= 0) ? double_var : -double_var;
-  exp_check = s21_exponent(&double_var_temporary_buffer);
-  double_var_temporary_buffer = fabsl(double_var);
-  exp_check *= (double_var_temporary_buffer < 1. &&
-                double_var_temporary_buffer >= LDBL_TRUE_MIN)
-                   ? -1
-                   : 1;
-
-  if (options->precision < 0) {
-    options->precision = 6;
-  } else if (options->precision == 0) {
-    options->precision = 1;
-  }
-  if ((-4 <= exp_check) && (exp_check < options->precision)) {
-    options->precision = options->precision - 1 - exp_check;
-    len = s21_f_specifier(str, *options, double_var, variables);
-
+int s21_g_specifiers(const decimal_type *decimal, opt options, char *buf,
+                     s21_size_t size) {
+  int precision = options.precision, overflow = 0;
+  if (precision < 0) {
+    precision = 6;
+  } else if (precision == 0) {
+    precision = 1;
+  }
+  if ((s21_size_t)precision + S21_BUFFER_RESERVE < size) {
+    int exponent = 0, length = 0;
+    // both notations show the same 'precision' significant digits, so one
+    // rounding serves either, and its exponent picks the notation
+    length = s21_decimal_round(decimal, precision, buf, &exponent);
+    if (!options.flags.SHARP) {
+      while (length > 1 && buf[length - 1] == '0') {
+        length -= 1;
+      }
+      buf[length] = '\0';
+    }
+    if ((-4 <= exponent) && (exponent < precision)) {
+      int fraction = length - 1 - exponent;
+      s21_fixed_layout(buf, length, exponent, (fraction > 0) ? fraction : 0,
+                       options.flags.SHARP);
+    } else {
+      s21_exp_layout(buf, length, options.flags.SHARP);
+      s21_add_exponent(buf, exponent,
+                       (options.format_spec == EXP_UP_SPECIFIER) ? 'E' : 'e');
+    }
   } else {
-    options->precision = options->precision - 1;
-    len = s21_e_specifiers(str, *options, double_var, variables);
+    overflow = 1;
   }
-  return len;
+  return overflow;
 }
 /**
  * @brief Handles the % specifier for formatting a percent sign in the output
  * string.
  *
- * @param str Pointer to the output string.
+ * @param cursor Pointer to the output cursor.
  * @param options The format options containing flags, width, precision, etc.
- * @param variables Structure holding temporary variables and buffers.
- * @return The number of characters written to the output string.
- */
-int s21_perc_specifier(char **str, opt options, var *variables) {
-  char *buf = s21_NULL;
-  int len = 0;
-  buf = (char *)malloc(sizeof(char) * 3);
-  if (buf) {
-    buf[0] = '\0';
-    s21_strcat(buf, "%");
-    if (options.flags.ZERO && !options.flags.MINUS && options.min_width > 0) {
-      s21_apply_num_precision(&buf, options.min_width);
-    }
-    if (options.flags.MINUS || !options.flags.ZERO) {
-      s21_apply_width(&buf, options, variables);
-    }
-    if (buf) {
-      variables->char_buffer = buf;
-      len = s21_buffer_to_string(str, variables);
-    }
-  }
-  return len;
+ */
+void s21_perc_specifier(cursor_type *cursor, opt options) {
+  layout_type layout;
+  s21_layout_init(&layout, '\0', s21_NULL, "%", 1);
+  s21_layout_pad(&layout, options, 1);
+  s21_layout_emit(cursor, &layout);
 }
 /**
  * @brief Handles the %n specifier for writing the number of characters written
  * so far.
  *
  * @param options The format options containing length specifier.
- * @param var_arg The va_list containing the variable arguments.
+ * @param var_arg Pointer to the va_list containing the variable arguments.
  * @param n The number of characters written so far.
  */
-void s21_n_specifier(opt options, va_list var_arg, long int n) {
+void s21_n_specifier(opt options, va_list *var_arg, long int n) {
   if (options.length_spec == SHORT_LEN_SPECIFIER) {
     short int *variable = s21_NULL;
-    variable = va_arg(var_arg, short int *);
+    variable = va_arg(*var_arg, short int *);
     *variable = n;
   } else if (options.length_spec == LONG_LOWERCASE_LEN_SPECIFIER) {
     long int *variable = s21_NULL;
-    variable = va_arg(var_arg, long int *);
+    variable = va_arg(*var_arg, long int *);
     *variable = n;
   } else {
     int *variable = s21_NULL;
-    variable = va_arg(var_arg, int *);
+    variable = va_arg(*var_arg, int *);
     *variable = n;
   }
 }
 // __Additional__
 /**
- * @brief Checks for memory allocation errors and handles them.
+ * @brief Calculates how many filler characters are needed to reach the minimum
+ * width.
  *
- * @param str The pointer to the allocated memory.
- * @param variables The structure containing program variables and error flag.
+ * @param len Length of the formatted value.
+ * @param options The format options containing minimum width.
+ * @return The number of filler characters.
  */
-void s21_mem_check(char *str, var *variables) {
-  if (str == s21_NULL) {
-    variables->error_flag = 1;
-    s21_free_at_exit(variables);
-    exit(1);
+s21_size_t s21_width_fillers(s21_size_t len, opt options) {
+  s21_size_t n_fillers = 0;
+  if (options.min_width > 0 && len < (s21_size_t)options.min_width) {
+    n_fillers = options.min_width - len;
   }
+  return n_fillers;
 }
 /**
- * @brief Frees allocated memory at program exit.
+ * @brief Writes a formatted value through the cursor, padded to the minimum
+ * width with spaces.
  *
- * @param variables The structure containing program variables and allocated
- * memory pointers.
+ * @param cursor Pointer to the output cursor.
+ * @param buf The formatted value.
+ * @param len Length of the formatted value.
+ * @param options The format options containing minimum width and flags.
  */
-void s21_free_at_exit(var *variables) {
-  if (variables->char_buffer) {
-    free(variables->char_buffer);
-    variables->char_buffer = s21_NULL;
-  }
-  if (variables->temporary_buffer) {
-    free(variables->temporary_buffer);
-    variables->temporary_buffer = s21_NULL;
-  }
-  if (variables->char_buffer) {
-    free(variables->char_buffer);
-    variables->temporary_buffer = s21_NULL;
-  }
+void s21_apply_width(cursor_type *cursor, const char *buf, s21_size_t len,
+                     opt options) {
+  layout_type layout;
+  s21_layout_init(&layout, '\0', s21_NULL, buf, len);
+  s21_layout_pad(&layout, options, 0);
+  s21_layout_emit(cursor, &layout);
 }
 /**
- * @brief Applies minimum width formatting to a buffer string.
+ * @brief Extracts the argument of the %c specifier.
  *
- * @param buf The buffer string to be formatted.
- * @param options The format options containing minimum width and flags.
- * @param variables The structure containing temporary buffers for memory
- * management.
- */
-void s21_apply_width(char **buf, opt options, var *variables) {
-  if (*buf && ((int)s21_strlen(*buf) < options.min_width)) {
-    char filler = ' ';
-    int n_fillers = 0;
-    n_fillers = options.min_width - s21_strlen(*buf);
-    if (!options.flags.MINUS && options.flags.ZERO) {
-      filler = ' ';
-    }
-    variables->temporary_buffer = calloc((options.min_width + 2), sizeof(char));
-    s21_mem_check(variables->temporary_buffer, variables);
-    for (int i = 0; i < n_fillers; i++) {
-      (variables->temporary_buffer)[i] = filler;
-    }
-    (variables->temporary_buffer)[n_fillers] = '\0';
-    variables->temporary_pointer =
-        (char *)realloc(*buf, sizeof(char) * (options.min_width + 2));
-    s21_mem_check(variables->temporary_pointer, variables);
-    if (variables->temporary_pointer) {
-      *buf = variables->temporary_pointer;
-      if (options.flags.MINUS) {
-        s21_strcat(*buf, variables->temporary_buffer);
-      } else {
-        s21_strcat(variables->temporary_buffer, *buf);
-        s21_strcpy(*buf, variables->temporary_buffer);
-      }
-    }
-    free(variables->temporary_buffer);
-    variables->temporary_buffer = s21_NULL;
+ * @param options The format options containing length specifier.
+ * @param var_arg Pointer to the va_list containing the variable arguments.
+ * @return The character, or with the 'l' modifier the wint_t as a wchar_t.
+ */
+wchar_t s21_char_variable(opt options, va_list *var_arg) {
+  wchar_t sym = L'\0';
+  if (options.length_spec == LONG_LOWERCASE_LEN_SPECIFIER) {
+    sym = (wchar_t)va_arg(*var_arg, wint_t);
+  } else {
+    sym = (char)va_arg(*var_arg, int);
   }
+  return sym;
 }
 /**
- * @brief Handles the conversion and formatting for the %c specifier.
+ * @brief Extracts the argument of the %s specifier.
  *
  * @param options The format options containing length specifier.
- * @param var_arg The va_list containing the variable arguments.
- * @param variables The structure containing the char_buffer for storing
- * formatted output.
+ * @param var_arg Pointer to the va_list containing the variable arguments.
+ * @return The char string, or the wchar_t string with the 'l' modifier.
  */
-void s21_handle_char_specifier(opt options, va_list var_arg, var *variables) {
+const void *s21_string_variable(opt options, va_list *var_arg) {
+  const void *string = s21_NULL;
   if (options.length_spec == LONG_LOWERCASE_LEN_SPECIFIER) {
-    wchar_t wchar = va_arg(var_arg, wchar_t);
-    wchar_t wstr[2] = {0};
-    wstr[0] = wchar;
-    s21_concatenate_wide_chars(variables->char_buffer, wstr, 1);
+    string = va_arg(*var_arg, wchar_t *);
   } else {
-    char sym = (char)va_arg(var_arg, int);
-    (variables->char_buffer)[0] = sym;
-    (variables->char_buffer)[1] = '\0';
+    string = va_arg(*var_arg, char *);
   }
+  return string;
 }
 /**
- * @brief Handles the conversion and formatting for the %s specifier.
+ * @brief Handles the conversion and formatting for the %s specifier. The
+ * argument is written through the cursor without an intermediate copy.
  *
+ * @param cursor Pointer to the output cursor.
  * @param options The format options containing length specifier.
- * @param var_arg The va_list containing the variable arguments.
- * @param variables The structure containing the char_buffer for storing
- * formatted output.
+ * @param string The char or, with the 'l' modifier, wchar_t string.
  */
-void s21_handle_format_specifier(opt options, va_list var_arg, var *variables) {
+void s21_handle_format_specifier(cursor_type *cursor, opt options,
+                                 const void *string) {
   if (options.length_spec == LONG_LOWERCASE_LEN_SPECIFIER) {
-    int wlen = 0;
-    wchar_t *wstr = s21_NULL;
-    wstr = va_arg(var_arg, wchar_t *);
-    wlen = s21_wchar_string_length(wstr);
-    s21_apply_precision_limit(&wlen, options);
-    variables->char_buffer = calloc(wlen + 1, sizeof(*variables->char_buffer));
-    s21_mem_check(variables->char_buffer, variables);
-    s21_concatenate_wide_chars(variables->char_buffer, wstr, wlen);
+    // the precision is a budget of bytes, never a cut through a character
+    s21_size_t budget = (options.precision >= 0) ? (s21_size_t)options.precision
+                                                  : (s21_size_t)-1;
+    s21_size_t len = 0;
+    int error = 0;
+    if (options.min_width > 0 && !options.flags.MINUS) {
+      len = s21_put_utf8(s21_NULL, string, budget, &error);
+      s21_cursor_fill(cursor, ' ', s21_width_fillers(len, options));
+    }
+    len = s21_put_utf8(cursor, string, budget, &error);
+    if (options.flags.MINUS) {
+      s21_cursor_fill(cursor, ' ', s21_width_fillers(len, options));
+    }
+    if (error) {
+      cursor->error = 1;
+      errno = EILSEQ;
+    }
   } else {
     int len = 0;
-    char *Usstr = s21_NULL;
-    Usstr = va_arg(var_arg, char *);
+    const char *Usstr = string;
     len = s21_strlen(Usstr);
     s21_apply_precision_limit(&len, options);
-    variables->char_buffer = calloc(len + 1, sizeof(*variables->char_buffer));
-    s21_mem_check(variables->char_buffer, variables);
-    for (int i = 0; i < len; i++) {
-      (variables->char_buffer)[i] = Usstr[i];
-    }
+    s21_apply_width(cursor, Usstr, len, options);
   }
 }
 /**
- * @brief Calculates the length of a wide string (wchar_t *) excluding the
- * null-terminator.
+ * @brief Writes a wchar_t string through the cursor as UTF-8.
  *
- * @param wstr The wide string for which length needs to be calculated.
- * @return The length of the wide string, excluding the null-terminator.
- */
-size_t s21_wchar_string_length(wchar_t *wstr) {
-  wchar_t *p = s21_NULL;
-  p = wstr;
-  for (; *p; p++)
-    ;
-  return p - wstr;
-}
-/**
- * @brief Copies wide characters from wchar_t string to the end of a char
- * string.
+ * The characters are encoded straight into the buffer of the cursor while it
+ * has room for a whole sequence, otherwise through a small staging area.
  *
- * @param str The destination char string where wide characters are copied.
- * @param wstr The source wchar_t string containing wide characters to copy.
- * @param len The number of wide characters to copy from wstr to str.
+ * @param cursor Pointer to the output cursor, s21_NULL to only count the bytes.
+ * @param wstr The wchar_t string.
+ * @param budget The most bytes to write, only whole characters are written.
+ * @param error Pointer set to 1 when a character has no UTF-8 form, the
+ * string ends before it.
+ * @return The number of bytes written.
  */
-void s21_concatenate_wide_chars(char *str, wchar_t *wstr, int len) {
-  int buflen = 0;
-  char *p = s21_NULL;
-  buflen = s21_strlen(str);
-  p = str + buflen;
-  for (int i = 0; i < len; i++) {
-    *(p++) = (char)*(wstr++);
-  }
-  *p = '\0';
+s21_size_t s21_put_utf8(cursor_type *cursor, const wchar_t *wstr,
+                        s21_size_t budget, int *error) {
+  char stage[S21_UTF8_STAGE_SIZE];
+  s21_size_t total = 0, length = 0;
+  do {
+    char *out = stage;
+    s21_size_t room = S21_UTF8_STAGE_SIZE;
+    if (cursor && s21_cursor_room(cursor) < S21_UTF8_MAX) {
+      s21_cursor_drain(cursor);
+    }
+    if (cursor && s21_cursor_room(cursor) >= S21_UTF8_MAX) {
+      out = cursor->buffer + cursor->length - cursor->flushed;
+      room = s21_cursor_room(cursor);
+    }
+    length = s21_utf8_encode_string(&wstr, &budget, out, room, error);
+    if (out != stage) {
+      cursor->length += length;
+    } else if (cursor) {
+      s21_cursor_write(cursor, stage, length);
+    }
+    total += length;
+  } while (length);
+  return total;
 }
 /**
  * @brief Adjusts the length of a string based on precision settings.
@@ -767,46 +1616,55 @@ void s21_apply_precision_limit(int *wlen, opt options) {
  *
  * @param options The format options specifying the format and length
  * specifiers.
- * @param var_arg The va_list containing the variable arguments.
+ * @param var_arg Pointer to the va_list containing the variable arguments.
  * @param is_negative Pointer to an integer flag indicating if the variable is
  * negative.
  * @return The unsigned integer variable extracted from var_arg.
  */
-long unsigned s21_unsigned_variable(opt options, va_list var_arg,
+long unsigned s21_unsigned_variable(opt options, va_list *var_arg,
                                     int *is_negative) {
   long unsigned u_var = 0;
   if (options.format_spec == INT_DEC_SPECIFIER ||
       options.format_spec == INT_HEX_SPECIFIER) {
     long int int_var = 0;
     if (options.length_spec == LONG_LOWERCASE_LEN_SPECIFIER) {
-      int_var = va_arg(var_arg, long int);
-      u_var = labs(int_var);
+      int_var = va_arg(*var_arg, long int);
     } else if (options.length_spec == SHORT_LEN_SPECIFIER) {
-      int_var = (short)va_arg(var_arg, int);
-      u_var = labs(int_var);
+      int_var = (short)va_arg(*var_arg, int);
     } else {
-      int_var = va_arg(var_arg, int);
-      u_var = labs(int_var);
+      int_var = va_arg(*var_arg, int);
     }
-    *is_negative = (int_var < 0) ? -1 : 1;
+    u_var = s21_signed_magnitude(int_var, is_negative);
   } else if (options.format_spec == UNSIGNED_SPECIFIER ||
              options.format_spec == OCTAL_SPECIFIER ||
              options.format_spec == HEX_LOW_SPECIFIER ||
              options.format_spec == HEX_UP_SPECIFIER) {
     if (options.length_spec == LONG_LOWERCASE_LEN_SPECIFIER) {
-      u_var = (unsigned long int)va_arg(var_arg, unsigned long int);
+      u_var = (unsigned long int)va_arg(*var_arg, unsigned long int);
     } else if (options.length_spec == SHORT_LEN_SPECIFIER) {
-      u_var = (unsigned short int)va_arg(var_arg, unsigned int);
+      u_var = (unsigned short int)va_arg(*var_arg, unsigned int);
     } else {
-      u_var = (unsigned int)va_arg(var_arg, unsigned int);
+      u_var = (unsigned int)va_arg(*var_arg, unsigned int);
     }
   } else if (options.format_spec == POINTER_SPECIFIER) {
     void *ptr = s21_NULL;
-    ptr = va_arg(var_arg, void *);
+    ptr = va_arg(*var_arg, void *);
     u_var = (unsigned long)ptr;
   }
   return u_var;
 }
+/**
+ * @brief Splits a signed integer into its magnitude and sign.
+ *
+ * @param int_var The value.
+ * @param is_negative Pointer set to -1 if the value is negative, otherwise 1.
+ * @return The magnitude, negated in unsigned arithmetic so LONG_MIN does not
+ * overflow.
+ */
+long unsigned s21_signed_magnitude(long int int_var, int *is_negative) {
+  *is_negative = (int_var < 0) ? -1 : 1;
+  return (int_var < 0) ? 0UL - (long unsigned)int_var : (long unsigned)int_var;
+}
 /**
  * @brief Determines the sign character for a formatted output based on
  * formatting options.
@@ -835,136 +1693,69 @@ void s21_char_sign(int is_negative, char *sign, opt options) {
   }
 }
 /**
- * @brief Splits a long double into its fractional and integer parts.
+ * @brief Spreads digits over the fixed-point layout in place: integer part,
+ * decimal point and 'precision' fractional digits.
  *
- * @param double_var The long double value to split.
- * @param ones Pointer to a long double where the fractional part will be
- * stored.
- * @param tens Pointer to a long double where the integer part will be stored.
- */
-void s21_split_float(long double double_var, long double *ones,
-                     long double *tens) {
-  *ones = fmodl(double_var, 10.L);
-  *tens = (double_var - *ones) / 10.L;
-}
-/**
- * @brief Converts a long double number into a string representation.
- *
- * @param num The long double number to convert.
- * @return A dynamically allocated string containing the ASCII representation of
- * `num`. The caller is responsible for freeing this memory.
- */
-char *s21_float_to_str(long double num) {
-  char *ascii_str = s21_NULL, *reverse_str = s21_NULL;
-  int buf_len = 0;
-  int length = 0;
-  long double tmp_num = 0;
-  num *= (num < 0) ? -1 : 1;
-  tmp_num = num;
-  while (tmp_num > 1) {
-    buf_len += 1;
-    tmp_num /= 10;
-  }
-  buf_len = (buf_len > 0) ? buf_len : 2;
-  ascii_str = (char *)calloc((buf_len + 5), sizeof(char));
-  reverse_str = (char *)calloc((buf_len + 5), sizeof(char));
-  if (ascii_str && reverse_str) {
-    while (num >= 1L) {
-      int digit = 0;
-      digit = (int)fmodl(num, 10);
-      num /= 10;
-      reverse_str[length] = s21_convert_digit_to_char(digit, 0);
-      length += 1;
+ * @param buf The buffer holding the significant digits, the layout is written
+ * over them from the end, so every digit is read before it is overwritten.
+ * @param length The number of significant digits in buf.
+ * @param exponent The power of ten of the first digit.
+ * @param precision The number of fractional digits.
+ * @param sharp Keep the decimal point even without fractional digits.
+ */
+void s21_fixed_layout(char *buf, int length, int exponent, int precision,
+                      int sharp) {
+  int int_len = (exponent >= 0) ? exponent + 1 : 1;
+  int point = (precision > 0 || sharp) ? 1 : 0;
+  int total = int_len + point + precision;
+  buf[total] = '\0';
+  for (int position = total - 1; position >= 0; position--) {
+    int index = -1;
+    if (position < int_len) {
+      index = (exponent >= 0) ? position : -1;
+    } else if (position > int_len) {
+      index = exponent + 1 + (position - int_len - point);
+    }
+    if (point && position == int_len) {
+      buf[position] = '.';
+    } else {
+      buf[position] = (index >= 0 && index < length) ? buf[index] : '0';
     }
-    reverse_str[length] = '\0';
-    s21_invert_str(reverse_str, ascii_str);
-  }
-  if (reverse_str) {
-    free(reverse_str);
   }
-  return ascii_str;
 }
 /**
- * @brief Rounds the given numeric string based on the next digit and adjusts
- * for exponent notation.
+ * @brief Inserts the decimal point after the first digit of a mantissa.
  *
- * @param num_string Pointer to the numeric string to be rounded and possibly
- * modified.
- * @param next_digit The digit that determines whether rounding is necessary.
- * @param exp_sign Pointer to the sign of the exponent (if applicable).
- * @param u_exp Pointer to the exponent value (if applicable).
+ * @param buf The buffer holding the significant digits, it must have room for
+ * one more character.
+ * @param length The number of significant digits in buf.
+ * @param sharp Keep the decimal point even without further digits.
  */
-void s21_math_rounding(char **num_string, int next_digit, char *exp_sign,
-                       unsigned *u_exp) {
-  if (*num_string && next_digit >= 5) {
-    int not_rounded = 1, position = 0;
-    position = s21_strlen(*num_string) - 1;
-    while (position >= 0 && not_rounded) {
-      if ((*num_string)[position] == '.') {
-        position -= 1;
-      }
-      if ((*num_string)[position] == '9') {
-        (*num_string)[position] = '0';
-        position -= 1;
-      } else {
-        (*num_string)[position] = (char)((*num_string)[position] + 1);
-        not_rounded = 0;
-      }
-    }
-    if (position == -1) {
-      char *tmp_ptr = s21_NULL, *tmp_array = s21_NULL;
-      int num_string_len = 0;
-      num_string_len = s21_strlen(*num_string);
-      tmp_array = (char *)calloc(num_string_len + 1, sizeof(char));
-      if (tmp_array) {
-        s21_strcpy(tmp_array, *num_string);
-        tmp_ptr =
-            (char *)realloc(*num_string, sizeof(char) * (num_string_len + 5));
-        if (tmp_ptr) {
-          tmp_ptr[0] = '1';
-          tmp_ptr[1] = '\0';
-          s21_strcat(tmp_ptr, tmp_array);
-          if (u_exp) {
-            if (*exp_sign == '-') {
-              *u_exp = *u_exp - 1;
-              if (*u_exp == 0) {
-                *exp_sign = '+';
-              }
-            } else {
-              *u_exp = *u_exp + 1;
-            }
-            tmp_ptr[2] = tmp_ptr[1];
-            tmp_ptr[1] = '.';
-            tmp_ptr[s21_strlen(tmp_ptr) - 1] = '\0';
-          }
-          *num_string = tmp_ptr;
-        }
-        free(tmp_array);
-      }
+void s21_exp_layout(char *buf, int length, int sharp) {
+  if (length > 1 || sharp) {
+    for (int i = length; i >= 1; i--) {
+      buf[i + 1] = buf[i];
     }
+    buf[1] = '.';
   }
 }
 /**
- * @brief Deletes trailing zeros and decimal point from the numeric string if
- * specified conditions are met.
+ * @brief Appends the exponent part of scientific notation, at least two
+ * digits with a sign.
  *
- * @param num_string Pointer to the numeric string where trailing zeros and
- * decimal point need to be removed.
- * @param options Formatting options that determine the conditions under which
- * trailing zeros are deleted.
+ * @param buf The numeric string, it must have room for S21_BUFFER_RESERVE more
+ * characters.
+ * @param exponent The decimal exponent.
+ * @param e_char The exponent character, 'e' or 'E'.
  */
-void s21_delete_trailing_zeros(char **num_string, opt options) {
-  if (*num_string && options.flags.SHARP == 0 &&
-      (options.format_spec == EXP_UP_SPECIFIER ||
-       options.format_spec == EXP_LOW_SPECIFIER)) {
-    int position = 0;
-    position = s21_strlen(*num_string) - 1;
-    while ((position > 0) && ((*num_string)[position] == '0' ||
-                              ((*num_string)[position] == '.'))) {
-      (*num_string)[position] = '\0';
-      position -= 1;
-    }
-  }
+void s21_add_exponent(char *buf, int exponent, char e_char) {
+  char exp_buf[S21_BUFFER_RESERVE] = {0};
+  s21_unsigned_to_str((unsigned long)(exponent < 0 ? -exponent : exponent), 10,
+                      0, exp_buf);
+  s21_apply_num_precision(exp_buf, S21_BUFFER_RESERVE, 2);
+  s21_add_sign(exp_buf, (exponent < 0) ? '-' : '+');
+  s21_add_sign(exp_buf, e_char);
+  s21_strcat(buf, exp_buf);
 }
 /**
  * @brief Generates a string representation for NaN (Not a Number) or Infinity
@@ -975,306 +1766,135 @@ void s21_delete_trailing_zeros(char **num_string, opt options) {
  * be stored.
  * @param format_spec The specifier type indicating the format requested for NaN
  * or Infinity representation.
- * @return A dynamically allocated string buffer containing "NAN" or "INF", or
- * NULL if allocation fails.
- */
-char *s21_nan_inf(long double variable, char *sign,
-                  specifier_type format_spec) {
-  char *buf = s21_NULL;
-  buf = (char *)calloc(5, sizeof(char));
-  if (buf) {
-    if (variable != variable) {
-      if (format_spec == EXP_UP_SPECIFIER ||
-          format_spec == FLOAT_EXP_UP_SPECIFIER) {
-        s21_strcpy(buf, "NAN");
-      } else {
-        s21_strcpy(buf, "nan");
-      }
-      *sign = '\0';
-    } else {
-      if (format_spec == EXP_UP_SPECIFIER ||
-          format_spec == FLOAT_EXP_UP_SPECIFIER) {
-        s21_strcpy(buf, "INF");
-      } else {
-        s21_strcpy(buf, "inf");
-      }
-    }
-  }
-  return buf;
-}
-/**
- * @brief Concatenates two strings and frees the memory allocated for them.
- *
- * @param string1 The first string to concatenate.
- * @param string2 The second string to concatenate.
- * @return A dynamically allocated string buffer containing the concatenated
- * `string1` and `string2`, or NULL if memory allocation fails.
+ * @param buf The buffer where "NAN" or "INF" is stored.
  */
-char *s21_sum_and_free_strings(char *string1, char *string2) {
-  char *buf = s21_NULL;
-  if (string1 && string2) {
-    buf = (char *)calloc((s21_strlen(string1) + s21_strlen(string2) + 2),
-                         sizeof(char));
-    if (buf) {
-      s21_strcat(buf, string1);
-      s21_strcat(buf, string2);
+void s21_nan_inf(long double variable, char *sign, specifier_type format_spec,
+                 char *buf) {
+  if (variable != variable) {
+    if (format_spec == EXP_UP_SPECIFIER ||
+        format_spec == FLOAT_EXP_UP_SPECIFIER) {
+      s21_strcpy(buf, "NAN");
+    } else {
+      s21_strcpy(buf, "nan");
     }
-  }
-  if (string1) {
-    free(string1);
-  }
-  if (string2) {
-    free(string2);
-  }
-  return buf;
-}
-/**
- * @brief Converts a digit to a character based on specified text case.
- *
- * @param digit The digit to convert (0-35).
- * @param text_case Determines whether to convert to lowercase (0) or uppercase
- * (non-zero).
- * @return The corresponding character representation of the digit.
- */
-char s21_convert_digit_to_char(int digit, int text_case) {
-  char ch = '\0';
-  if (digit >= 0 && digit < 10) {
-    ch = (char)(digit + 48);  // 0 - 9
-  } else if (digit >= 10 && digit < 36) {
-    if (text_case == 0) {
-      ch = (char)(digit + 87);  // a - z
+    *sign = '\0';
+  } else {
+    if (format_spec == EXP_UP_SPECIFIER ||
+        format_spec == FLOAT_EXP_UP_SPECIFIER) {
+      s21_strcpy(buf, "INF");
     } else {
-      ch = (char)(digit + 55);  // A - Z
+      s21_strcpy(buf, "inf");
     }
   }
-  return ch;
 }
 /**
  * @brief Converts an unsigned long integer to a string representation in the
  * specified notation.
  *
  * @param num The unsigned long integer to convert to string.
- * @param notation The notation (base) to use for the conversion (e.g., 10 for
- * decimal).
+ * @param notation The notation (base) to use for the conversion: 8, 10 or 16.
  * @param text_case Determines whether the output should be in uppercase (1) or
  * lowercase (0).
- * @return A dynamically allocated string buffer containing the converted string
- * representation of `num` in the specified `notation`, or NULL if memory
- * allocation fails.
- */
-char *s21_unsigned_to_str(unsigned long int num, unsigned int notation,
-                          int text_case) {
-  char *ascii_str = s21_NULL, *reverse_str = s21_NULL;
-  int length = 0;
-  ascii_str = (char *)malloc(sizeof(char) * 50);
-  reverse_str = (char *)malloc(sizeof(char) * 50);
-  if (reverse_str && ascii_str) {
-    if (num == 0) {
-      reverse_str[0] = '0';
-      length += 1;
-    }
-    while (num != 0) {
-      int digit = num % notation;
-      num /= notation;
-      reverse_str[length] = s21_convert_digit_to_char(digit, text_case);
-      length += 1;
-    }
-    reverse_str[length] = '\0';
-    s21_invert_str(reverse_str, ascii_str);
-  }
-  if (reverse_str) {
-    free(reverse_str);
-  }
-  return ascii_str;
+ * @param buf The buffer (at least S21_INT_DIGITS_SIZE bytes) where the
+ * converted string representation of `num` in the specified `notation` is
+ * stored.
+ * @return The number of digits written.
+ */
+int s21_unsigned_to_str(unsigned long int num, unsigned int notation,
+                        int text_case, char *buf) {
+  char digits_buf[S21_INT_DIGITS_SIZE];
+  char *end = digits_buf + S21_INT_DIGITS_SIZE;
+  char *digits = s21_unsigned_digits(num, notation, text_case, end);
+  int length = end - digits;
+  s21_memcpy(buf, digits, length);
+  buf[length] = '\0';
+  return length;
 }
 /**
- * @brief Converts the mantissa of a long double number to a string
- * representation.
+ * @brief Writes the digits of an unsigned long integer right to left so that
+ * the last digit lands just before 'end'.
  *
- * @param num The long double number whose mantissa needs to be converted.
- * @param next_digit Pointer to an integer where the next significant digit will
- * be stored.
- * @param options Formatting options that include precision and flags.
- * @return A dynamically allocated string buffer containing the converted
- * mantissa in string representation, or NULL if memory allocation fails.
- */
-char *s21_mantissa_to_str(long double num, int *next_digit, opt options) {
-  char *ascii_str = s21_NULL;
-  int length = 0, digit = 0, precision = -1;
-  precision = (options.precision >= 0) ? options.precision : 6;
-
-  num *= (num < 0) ? -1 : 1;
-  digit = floorl(num);
-  num = (num - digit) * 10;
-
-  ascii_str = (char *)malloc(sizeof(char) * (precision + 5));
-  if (ascii_str) {
-    ascii_str[length++] = s21_convert_digit_to_char(digit, 0);
-    if (precision > 0 || options.flags.SHARP) {
-      ascii_str[length++] = '.';
-    }
-    for (int i = 0; i < precision; i++) {
-      digit = (floorl(num) >= 0) ? (int)floorl(num) : 0;
-      num = (num - digit) * 10;
-      ascii_str[length++] = s21_convert_digit_to_char(digit, 0);
-    }
-    ascii_str[length] = '\0';
-    *next_digit = (int)floorl(num);
-  }
-  return ascii_str;
-}
-/**
- * @brief Inverts the contents of a string and stores the result in another
- * string.
+ * Base 10 emits two digits per division from a "00".."99" table, bases 8 and
+ * 16 take the digits with shifts and masks.
  *
- * @param origin The original string whose content will be inverted.
- * @param inverted The string where the inverted content will be stored.
+ * @param num The unsigned long integer to convert.
+ * @param notation The notation (base): 8, 10 or 16.
+ * @param text_case Uppercase hexadecimal digits when non-zero.
+ * @param end Pointer just past the buffer, the buffer must hold
+ * S21_INT_DIGITS_SIZE characters.
+ * @return Pointer to the first digit.
  */
-void s21_invert_str(char *origin, char *inverted) {
-  if (origin && inverted) {
-    int length = 0;
-    length = s21_strlen(origin);
-    for (int i = 0; i < length; i++) {
-      inverted[i] = origin[length - 1 - i];
+char *s21_unsigned_digits(unsigned long int num, unsigned int notation,
+                          int text_case, char *end) {
+  static const char pairs[201] =
+      "00010203040506070809101112131415161718192021222324252627282930313233343"
+      "53637383940414243444546474849505152535455565758596061626364656667686970"
+      "7172737475767778798081828384858687888990919293949596979899";
+  const char *hex = text_case ? "0123456789ABCDEF" : "0123456789abcdef";
+  char *digits = end;
+  if (notation == 10) {
+    while (num >= 100) {
+      unsigned pair = (unsigned)(num % 100) * 2;
+      num /= 100;
+      *--digits = pairs[pair + 1];
+      *--digits = pairs[pair];
     }
-    inverted[length] = '\0';
-  }
-}
-/**
- * @brief Computes the exponent of a floating point number and normalizes the
- * mantissa.
- *
- * @param mantissa Pointer to the mantissa of the floating point number, which
- * will be normalized.
- * @return The absolute value of the exponent calculated during normalization.
- */
-unsigned s21_exponent(long double *mantissa) {
-  unsigned exponent = 0;
-  while (*mantissa >= 10. && *mantissa <= LDBL_MAX) {
-    *mantissa = *mantissa / 10.;
-    exponent += 1;
-  }
-  while (*mantissa < 1. && *mantissa >= LDBL_TRUE_MIN) {
-    *mantissa = *mantissa * 10.;
-    exponent += 1;
+    if (num >= 10) {
+      *--digits = pairs[num * 2 + 1];
+      *--digits = pairs[num * 2];
+    } else {
+      *--digits = (char)('0' + num);
+    }
+  } else {
+    unsigned shift = (notation == 16) ? 4 : 3;
+    unsigned long mask = notation - 1;
+    do {
+      *--digits = hex[num & mask];
+      num >>= shift;
+    } while (num);
   }
-  return exponent;
+  return digits;
 }
 /**
- * @brief Applies numerical precision to a string representation of a number.
+ * @brief Applies numerical precision to a string representation of a number in
+ * place.
  *
- * @param buf Pointer to a pointer to the string where precision will be
- * applied.
+ * @param buf The string where precision will be applied.
+ * @param size Size of the buffer holding the string.
  * @param precision The desired precision to be applied.
+ * @return 0 on success, 1 if the padded number does not fit into the buffer.
  */
-void s21_apply_num_precision(char **buf, int precision) {
-  if (*buf) {
-    int len_buf = 0;
-    len_buf = s21_strlen(*buf);
-    if ((precision == 0) && (s21_strcmp(*buf, "0") == 0)) {
-      *buf[0] = '\0';
-    } else if (len_buf < precision) {
+int s21_apply_num_precision(char *buf, s21_size_t size, int precision) {
+  int len_buf = 0, overflow = 0;
+  len_buf = s21_strlen(buf);
+  if ((precision == 0) && (s21_strcmp(buf, "0") == 0)) {
+    buf[0] = '\0';
+  } else if (len_buf < precision) {
+    if ((s21_size_t)precision + S21_BUFFER_RESERVE / 2 < size) {
       int n_zeros = 0;
-      char *temporary_buffer = s21_NULL;
       n_zeros = precision - len_buf;
-      temporary_buffer = (char *)malloc(sizeof(char) * (precision + 1));
-      if (temporary_buffer) {
-        char *tmp_ptr = s21_NULL;
-        for (int i = 0; i < n_zeros; i++) {
-          temporary_buffer[i] = '0';
-        }
-        temporary_buffer[n_zeros] = '\0';
-        s21_strcat(temporary_buffer, *buf);
-        tmp_ptr = (char *)realloc(*buf, sizeof(char) * (precision + 1));
-        if (tmp_ptr) {
-          *buf = tmp_ptr;
-          s21_strcpy(*buf, temporary_buffer);
-        }
-        free(temporary_buffer);
+      for (int i = len_buf; i >= 0; i--) {
+        buf[i + n_zeros] = buf[i];
       }
+      s21_memset(buf, '0', n_zeros);
+    } else {
+      overflow = 1;
     }
   }
+  return overflow;
 }
 /**
- * @brief Adds a sign character to the beginning of a string.
+ * @brief Adds a sign character to the beginning of a string in place.
  *
- * @param buf Pointer to a pointer to the string where the sign will be added.
+ * @param buf The string where the sign will be added, it must have room for
+ * one more character.
  * @param sign The sign character to be added ('+', '-' or ' ').
  */
-void s21_add_sign(char **buf, char sign) {
-  if (sign && *buf) {
-    int len_buf = 0;
-    char *temporary_buffer = s21_NULL;
-    len_buf = s21_strlen(*buf);
-    temporary_buffer = (char *)malloc(sizeof(char) * (len_buf + 2));
-    if (temporary_buffer) {
-      char *tmp_ptr = s21_NULL;
-      temporary_buffer[0] = sign;
-      temporary_buffer[1] = '\0';
-      s21_strcat(temporary_buffer, *buf);
-      tmp_ptr = (char *)realloc(*buf, sizeof(char) * (len_buf + 2));
-      if (tmp_ptr) {
-        *buf = tmp_ptr;
-        s21_strcpy(*buf, temporary_buffer);
-      }
-      free(temporary_buffer);
+void s21_add_sign(char *buf, char sign) {
+  if (sign) {
+    for (int i = s21_strlen(buf); i >= 0; i--) {
+      buf[i + 1] = buf[i];
     }
+    buf[0] = sign;
   }
 }
-/**
- * @brief Adds notation prefixes (like "0x" for hexadecimal) to a string.
- *
- * @param buf Pointer to a pointer to the string where notation will be added.
- * @param options Formatting options that dictate which notation to add.
- */
-void s21_add_notation(char **buf, opt options) {
-  if (*buf &&
-      ((options.flags.SHARP && (options.format_spec == OCTAL_SPECIFIER ||
-                                options.format_spec == HEX_LOW_SPECIFIER ||
-                                options.format_spec == HEX_UP_SPECIFIER)) ||
-       options.format_spec == POINTER_SPECIFIER)) {
-    int len_buf = 0;
-    char *temporary_buffer = s21_NULL;
-    len_buf = s21_strlen(*buf);
-    temporary_buffer = (char *)malloc(sizeof(char) * (len_buf + 3));
-    if (temporary_buffer) {
-      char *tmp_ptr = s21_NULL;
-      temporary_buffer[0] = '\0';
-      if ((options.format_spec == OCTAL_SPECIFIER) && (**buf != '0')) {
-        s21_strcat(temporary_buffer, "0");
-      }
-      if (options.format_spec == HEX_LOW_SPECIFIER ||
-          options.format_spec == POINTER_SPECIFIER) {
-        s21_strcat(temporary_buffer, "0x");
-      }
-      if (options.format_spec == HEX_UP_SPECIFIER) {
-        s21_strcat(temporary_buffer, "0X");
-      }
-      s21_strcat(temporary_buffer, *buf);
-      tmp_ptr = (char *)realloc(*buf, sizeof(char) * (len_buf + 3));
-      if (tmp_ptr) {
-        *buf = tmp_ptr;
-        s21_strcpy(*buf, temporary_buffer);
-      }
-      free(temporary_buffer);
-    }
-  }
-}
-/**
- * @brief Records the content of variables->char_buffer into *str and frees the
- * buffer.
- *
- * @param str Pointer to a pointer where the content will be copied.
- * @param variables Pointer to the structure holding the char_buffer and other
- * variables.
- * @return Length of the recorded string.
- */
-int s21_buffer_to_string(char **str, var *variables) {
-  int length = 0;
-  s21_strcpy(*str, variables->char_buffer);
-  length = s21_strlen(variables->char_buffer);
-  *str = *str + length;
-  free(variables->char_buffer);
-  variables->char_buffer = s21_NULL;
-  return (length);
-}
\ No newline at end of file
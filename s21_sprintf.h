@@ -16,20 +16,35 @@
  * - opt: Structure containing formatting options (flags, width, precision,
  * length specifier, format specifier).
  * - var: Structure holding variables used during string formatting (error flag,
- * buffers).
+ * per-call scratch buffer, exact decimal of the current float). The scratch
+ * buffer lives on the stack and moves to the heap only for widths and
+ * precisions that do not fit into it.
+ * - cursor_type: Bounded output cursor every conversion writes through. It
+ * counts the would-be length even after the destination is full, or stages
+ * the output for a sink.
+ * - layout_type: Lengths of the pieces of one padded value, computed before
+ * anything is written so the value goes out in a single pass.
+ * - step_type: One parsed piece of a format string: a literal span followed by
+ * a conversion described by opt.
+ * - plan_type: Compiled format string, a sequence of steps that can be executed
+ * any number of times with s21_sprintf_plan, or once per row of column arrays
+ * with s21_sprintf_batch.
  *
  * Included functionalities:
  *
  * This header file provides a interface for handling formatted string output,
- * implementing various format specifiers and ensuring proper memory management
- * during operation. It is intended to be included in source files where
- * formatted string handling is required, ensuring compatibility and
- * functionality similar to standard sprintf functions.
+ * implementing various format specifiers without any heap allocation during
+ * operation, unless a width or precision exceeds S21_BUFFER_SIZE. It is
+ * intended to be included in source files where formatted string handling is
+ * required, ensuring compatibility and functionality similar to standard
+ * sprintf functions.
  */
 #ifndef SRC_S21_SPRINTF_H_
 #define SRC_S21_SPRINTF_H_
 
+#include "s21_decimal.h"
 #include "s21_string.h"
+#include "s21_utf8.h"
 
 typedef struct flags {
   int MINUS;
@@ -68,81 +83,181 @@ typedef enum len_specifier {
 
 typedef struct options {
   flag_type flags;
-  int min_width;  // -1: undefined
-  int precision;  // -1: undefined
+  int min_width;  // -1: undefined, S21_FROM_ARGUMENT: '*'
+  int precision;  // -1: undefined, S21_FROM_ARGUMENT: '*'
   len_type length_spec;
   specifier_type format_spec;
 } opt;
 
+#define S21_FROM_ARGUMENT -2
+
+#define S21_BUFFER_SIZE 8192
+#define S21_BUFFER_RESERVE 16  // sign, base prefix, rounding carry, exponent
+#define S21_INT_DIGITS_SIZE 24  // octal digits of a 64-bit value and '\0'
+
 typedef struct variables {
-  int error_flag;
-  char *char_buffer;
-  char *temporary_buffer;
-  char *temporary_pointer;
+  int error_flag;          // set when the scratch buffer cannot grow
+  char *buffer;            // scratch of the conversion, char_buffer or heap
+  s21_size_t buffer_size;  // bytes available in buffer
+  char char_buffer[S21_BUFFER_SIZE];  // the stack part of the scratch
+  decimal_type decimal;  // exact value of the current float conversion
 } var;
 
+typedef struct cursor {
+  char *buffer;           // destination, or staging area of the sink
+  s21_size_t capacity;    // bytes available in buffer including the '\0'
+  s21_size_t length;      // characters produced so far, may exceed capacity
+  s21_size_t flushed;     // characters already handed to the sink
+  const sink_type *sink;  // s21_NULL to store into buffer only
+  int error;              // set when the sink fails or a character has no
+                          // UTF-8 form
+} cursor_type;
+
+#define S21_SINK_STAGING_SIZE 4096
+#define S21_UTF8_STAGE_SIZE 64  // %ls bytes encoded ahead of a full cursor
+
+typedef struct layout {
+  s21_size_t left_pad;    // spaces before the value
+  char sign;              // '\0' when the value has no sign
+  const char *prefix;     // "0x" and the like, never s21_NULL
+  s21_size_t prefix_len;  // length of the prefix
+  s21_size_t zeros;       // zeros between the prefix and the body
+  const char *body;       // the digits or text of the value
+  s21_size_t body_len;    // length of the body
+  s21_size_t right_pad;   // spaces after the value, for the '-' flag
+} layout_type;
+
+#define S21_PLAN_MAX_STEPS 32
+// a step consumes at most a width, a precision and a value
+#define S21_BATCH_MAX_COLUMNS (3 * S21_PLAN_MAX_STEPS)
+
+typedef struct step {
+  const char *literal;     // text copied verbatim before the conversion
+  s21_size_t literal_len;  // length of the literal span
+  opt options;             // NO_SPECIFIER when the step is a bare literal
+} step_type;
+
+typedef struct plan {
+  int steps_count;
+  step_type steps[S21_PLAN_MAX_STEPS];
+} plan_type;
+
+// __Formatting core__
+int s21_format(cursor_type *cursor, const char *format, const plan_type *plan,
+               va_list var_arg);
+// __Plans__
+int s21_compile_format(plan_type *plan, const char *format);
+int s21_sprintf_plan(char *str, const plan_type *plan, ...);
+int s21_vsnprintf_plan(char *str, s21_size_t size, const plan_type *plan,
+                       va_list var_arg);
+void s21_parse_step(const char **format, step_type *step);
+void s21_execute_step(cursor_type *cursor, const step_type *step,
+                      va_list *var_arg, var *variables);
+void s21_resolve_arguments(opt *options, va_list *var_arg);
+// __Batches__
+int s21_sprintf_batch(char *str, s21_size_t size, const char *format,
+                      int rows, s21_size_t *offsets, ...);
+int s21_batch_columns_count(const plan_type *plan);
+int s21_format_batch(cursor_type *cursor, const plan_type *plan, int rows,
+                     void *const *columns, s21_size_t *offsets);
+void s21_execute_batch_step(cursor_type *cursor, const step_type *step,
+                            void *const *columns, int *column, int row,
+                            s21_size_t row_start, var *variables);
+void s21_process_column_specifier(cursor_type *cursor, opt options,
+                                  void *column, int row, long int n,
+                                  var *variables);
+long unsigned s21_unsigned_column(opt options, const void *column, int row,
+                                  int *is_negative);
+// __Scratch__
+void s21_scratch_init(var *variables);
+int s21_scratch_reserve(var *variables, s21_size_t size);
+void s21_scratch_release(var *variables);
+// __Sinks__
+int s21_buffer_write(void *context, const char *span, s21_size_t len);
+int s21_file_write(void *context, const char *span, s21_size_t len);
+int s21_fd_write(void *context, const char *span, s21_size_t len);
+// __Format routes__
+char *s21_signed_digits(long value, char *end);
+int s21_emit_span(char *str, const char *span, s21_size_t len);
 // __Initialization__
 void s21_initialize_options(opt *options);
 // __Options__
-void s21_options(const char **format, opt *options, va_list var_arg);
+void s21_options(const char **format, opt *options);
 void s21_set_format_flags(const char **format, opt *options);
-void s21_min_width(const char **format, opt *options, va_list var_arg);
-void s21_precision(const char **format, opt *options, va_list var_arg);
+void s21_min_width(const char **format, opt *options);
+void s21_precision(const char **format, opt *options);
 void s21_length_spec(const char **format, opt *options);
 void s21_format_spec(const char **format, opt *options);
 // __Add conversions__
 int s21_atoi(const char **str);
+// __Cursor__
+s21_size_t s21_cursor_room(const cursor_type *cursor);
+void s21_cursor_drain(cursor_type *cursor);
+void s21_cursor_put(cursor_type *cursor, char symbol);
+void s21_cursor_write(cursor_type *cursor, const char *span, s21_size_t len);
+void s21_cursor_fill(cursor_type *cursor, char filler, s21_size_t count);
+void s21_cursor_finish(cursor_type *cursor);
+// __Layout__
+void s21_layout_init(layout_type *layout, char sign, const char *prefix,
+                     const char *body, s21_size_t body_len);
+void s21_layout_pad(layout_type *layout, opt options, int zero_pad);
+void s21_layout_emit(cursor_type *cursor, const layout_type *layout);
 // __Process__
-void s21_process_format_specifier(char **str, opt options, va_list var_arg,
-                                  int *n_smb, var *variables);
-int s21_int_specifiers(char **str, opt options, va_list var_arg,
-                       var *variables);
-int s21_e_specifiers(char **str, opt options, long double double_var,
-                     var *variables);
-int s21_f_specifier(char **str, opt options, long double double_var,
-                    var *variables);
-int s21_g_specifiers(char **str, opt *options, long double double_var,
+void s21_process_format_specifier(cursor_type *cursor, opt options,
+                                  va_list *var_arg, var *variables);
+void s21_int_specifiers(cursor_type *cursor, opt options, long unsigned u_var,
+                        int is_negative);
+void s21_float_specifiers(cursor_type *cursor, opt options,
+                          long double double_var, var *variables);
+int s21_float_layout(const decimal_type *decimal, opt options, char *buf,
+                     s21_size_t size);
+s21_size_t s21_float_scratch_size(const decimal_type *decimal, opt options);
+int s21_f_specifier(const decimal_type *decimal, opt options, char *buf,
+                    s21_size_t size);
+int s21_e_specifiers(const decimal_type *decimal, opt options, char *buf,
+                     s21_size_t size);
+int s21_g_specifiers(const decimal_type *decimal, opt options, char *buf,
+                     s21_size_t size);
+void s21_perc_specifier(cursor_type *cursor, opt options);
+void s21_n_specifier(opt options, va_list *var_arg, long int n_smb);
+void s21_c_specifier(cursor_type *cursor, opt options, char symbol,
                      var *variables);
-int s21_perc_specifier(char **str, opt options, var *variables);
-void s21_n_specifier(opt options, va_list var_arg, long int n_smb);
-int s21_c_specifier(char **str, opt options, va_list var_arg, var *variables);
-int s21_s_specifier(char **str, opt options, va_list var_arg, var *variables);
-//  __Mem__
-void s21_free_at_exit(var *variables);
-void s21_mem_check(char *str, var *variables);
+void s21_lc_specifier(cursor_type *cursor, opt options, wchar_t symbol);
+void s21_s_specifier(cursor_type *cursor, opt options, const void *string);
 // conversions
-char s21_convert_digit_to_char(int digit, int text_case);
-char *s21_unsigned_to_str(unsigned long int num, unsigned int notation,
-                          int text_case);
-char *s21_mantissa_to_str(long double num, int *next_digit, opt options);
-char *s21_float_to_str(long double num);
-void s21_concatenate_wide_chars(char *str, wchar_t *wstr, int len);
-void s21_invert_str(char *origin, char *inverted);
+int s21_unsigned_to_str(unsigned long int num, unsigned int notation,
+                        int text_case, char *buf);
+char *s21_unsigned_digits(unsigned long int num, unsigned int notation,
+                          int text_case, char *end);
+unsigned s21_notation(specifier_type spec);
+const char *s21_notation_prefix(opt options, long unsigned u_var);
+s21_size_t s21_put_utf8(cursor_type *cursor, const wchar_t *wstr,
+                        s21_size_t budget, int *error);
 // obtainig values
-void s21_split_float(long double double_var, long double *ones,
-                     long double *tens);
-long double s21_double_variable(opt options, va_list var_arg);
-long unsigned s21_unsigned_variable(opt options, va_list var_arg,
+long double s21_double_variable(opt options, va_list *var_arg);
+long unsigned s21_unsigned_variable(opt options, va_list *var_arg,
                                     int *is_negative);
-unsigned s21_exponent(long double *mantissa);
+long unsigned s21_signed_magnitude(long int int_var, int *is_negative);
+wchar_t s21_char_variable(opt options, va_list *var_arg);
+const void *s21_string_variable(opt options, va_list *var_arg);
 void s21_char_sign(int is_negative, char *sign, opt options);
 void s21_apply_precision_limit(int *wlen, opt options);
 // output formatting
-void s21_apply_num_precision(char **buf, int precision);
-void s21_add_notation(char **buf, opt options);
-void s21_add_sign(char **buf, char sign);
-void s21_apply_width(char **buf, opt options, var *variables);
-void s21_delete_trailing_zeros(char **num_string, opt options);
-void s21_math_rounding(char **num_string, int next_digit, char *exp_sign,
-                       unsigned *u_exp);
+int s21_apply_num_precision(char *buf, s21_size_t size, int precision);
+void s21_add_sign(char *buf, char sign);
+s21_size_t s21_width_fillers(s21_size_t len, opt options);
+void s21_apply_width(cursor_type *cursor, const char *buf, s21_size_t len,
+                     opt options);
+void s21_fixed_layout(char *buf, int length, int exponent, int precision,
+                      int sharp);
+void s21_exp_layout(char *buf, int length, int sharp);
+void s21_add_exponent(char *buf, int exponent, char e_char);
 // others
-size_t s21_wchar_string_length(wchar_t *wstr);
-int s21_buffer_to_string(char **str, var *variables);
-char *s21_nan_inf(long double variable, char *sign, specifier_type format_spec);
-char *s21_sum_and_free_strings(char *string1, char *string2);
+void s21_nan_inf(long double variable, char *sign, specifier_type format_spec,
+                 char *buf);
 int s21_is_spec_int(specifier_type spec);
 int s21_is_spec_float(specifier_type spec);
-void s21_handle_char_specifier(opt options, va_list var_arg, var *variables);
-void s21_handle_format_specifier(opt options, va_list var_arg, var *variables);
+void s21_handle_format_specifier(cursor_type *cursor, opt options,
+                                 const void *string);
 
 #endif  // SRC_S21_SPRINTF_H_
\ No newline at end of file
@@ -1827,6 +1827,605 @@ START_TEST(test_sprintf41) {
 }
 END_TEST
 
+START_TEST(snprintf_truncation) {
+  char str1[BUFFERSIZE];
+  char str2[BUFFERSIZE];
+  char *format = "%+08d|%-6s|%.3f|%#x";
+  for (s21_size_t size = 0; size < 40; ++size) {
+    s21_memset(str1, '#', sizeof(str1));
+    memset(str2, '#', sizeof(str2));
+    int a = s21_snprintf(str1, size, format, 123, "ab", 3.14159, 255u);
+    int b = snprintf(str2, size, format, 123, "ab", 3.14159, 255u);
+    ck_assert_int_eq(a, b);
+    ck_assert_int_eq(memcmp(str1, str2, 40), 0);
+  }
+}
+END_TEST
+
+START_TEST(snprintf_null_buffer) {
+  ck_assert_int_eq(s21_snprintf(s21_NULL, 0, "%d %s", 4242, "abc"),
+                   snprintf(NULL, 0, "%d %s", 4242, "abc"));
+  ck_assert_int_eq(s21_snprintf(s21_NULL, 0, "%30.10e", 1.5),
+                   snprintf(NULL, 0, "%30.10e", 1.5));
+}
+END_TEST
+
+START_TEST(snprintf_wide_padding) {
+  char str1[16];
+  char str2[16];
+  char *formats[] = {"%-500d|", "%500d|", "%+0500d|"};
+  for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); ++i) {
+    int a = s21_snprintf(str1, sizeof(str1), formats[i], -7);
+    int b = snprintf(str2, sizeof(str2), formats[i], -7);
+    ck_assert_int_eq(a, b);
+    ck_assert_str_eq(str1, str2);
+  }
+  char *string_formats[] = {"%500s", "%-500s", "%.2s"};
+  for (size_t i = 0; i < sizeof(string_formats) / sizeof(char *); ++i) {
+    int a = s21_snprintf(str1, sizeof(str1), string_formats[i], "tail");
+    int b = snprintf(str2, sizeof(str2), string_formats[i], "tail");
+    ck_assert_int_eq(a, b);
+    ck_assert_str_eq(str1, str2);
+  }
+}
+END_TEST
+
+static int vsnprintf_wrapper(char *str, s21_size_t size, const char *format,
+                             ...) {
+  va_list var_arg;
+  va_start(var_arg, format);
+  int n = s21_vsnprintf(str, size, format, var_arg);
+  va_end(var_arg);
+  return n;
+}
+
+START_TEST(vsnprintf_basic) {
+  char str1[BUFFERSIZE];
+  char str2[BUFFERSIZE];
+  s21_size_t sizes[] = {1, 5, 10, BUFFERSIZE};
+  for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+    int n1 = 0, n2 = 0;
+    int a = vsnprintf_wrapper(str1, sizes[i], "%s=%ld%n", "key", 1234567L,
+                              &n1);
+    int b = snprintf(str2, sizes[i], "%s=%ld%n", "key", 1234567L, &n2);
+    ck_assert_int_eq(a, b);
+    ck_assert_int_eq(n1, n2);
+    ck_assert_str_eq(str1, str2);
+  }
+}
+END_TEST
+
+static int vsnprintf_plan_wrapper(char *str, s21_size_t size,
+                                  const plan_type *plan, ...) {
+  va_list var_arg;
+  va_start(var_arg, plan);
+  int n = s21_vsnprintf_plan(str, size, plan, var_arg);
+  va_end(var_arg);
+  return n;
+}
+
+START_TEST(sprintf_plan_reuse) {
+  char str1[BUFFERSIZE];
+  char str2[BUFFERSIZE];
+  const char *format = "id=%-6d name=%.3s val=%+.2f hex=%#x end";
+  plan_type plan;
+  ck_assert_int_eq(s21_compile_format(&plan, format), 0);
+  for (int i = -3; i < 300; i += 37) {
+    int a = s21_sprintf_plan(str1, &plan, i, "abcdef", i / 7.0, i);
+    int b = sprintf(str2, format, i, "abcdef", i / 7.0, i);
+    ck_assert_int_eq(a, b);
+    ck_assert_str_eq(str1, str2);
+  }
+}
+END_TEST
+
+START_TEST(sprintf_plan_star) {
+  char str1[BUFFERSIZE];
+  char str2[BUFFERSIZE];
+  const char *format = "[%*.*f] [%-*s] [%*d]";
+  plan_type plan;
+  int widths[] = {0, 5, -9, 12};
+  ck_assert_int_eq(s21_compile_format(&plan, format), 0);
+  for (size_t i = 0; i < sizeof(widths) / sizeof(widths[0]); ++i) {
+    int a = s21_sprintf_plan(str1, &plan, widths[i], 3, 3.14159, widths[i],
+                             "str", widths[i], 42);
+    int b = sprintf(str2, format, widths[i], 3, 3.14159, widths[i], "str",
+                    widths[i], 42);
+    ck_assert_int_eq(a, b);
+    ck_assert_str_eq(str1, str2);
+  }
+}
+END_TEST
+
+START_TEST(sprintf_plan_bounded) {
+  char str1[BUFFERSIZE];
+  char str2[BUFFERSIZE];
+  const char *format = "literal only %% and %c";
+  plan_type plan;
+  ck_assert_int_eq(s21_compile_format(&plan, format), 0);
+  for (s21_size_t size = 1; size < 30; ++size) {
+    int a = vsnprintf_plan_wrapper(str1, size, &plan, 'z');
+    int b = snprintf(str2, size, format, 'z');
+    ck_assert_int_eq(a, b);
+    ck_assert_str_eq(str1, str2);
+  }
+}
+END_TEST
+
+START_TEST(sprintf_plan_limits) {
+  char str[BUFFERSIZE];
+  char format[S21_PLAN_MAX_STEPS * 2 + 3] = {0};
+  plan_type plan;
+  ck_assert_int_eq(s21_compile_format(&plan, ""), 0);
+  ck_assert_int_eq(plan.steps_count, 0);
+  ck_assert_int_eq(s21_sprintf_plan(str, &plan), 0);
+  ck_assert_str_eq(str, "");
+  for (int i = 0; i < S21_PLAN_MAX_STEPS; ++i) {
+    format[2 * i] = '%';
+    format[2 * i + 1] = 'c';
+  }
+  ck_assert_int_eq(s21_compile_format(&plan, format), 0);
+  format[2 * S21_PLAN_MAX_STEPS] = '!';
+  ck_assert_int_eq(s21_compile_format(&plan, format), 1);
+}
+END_TEST
+
+START_TEST(float_exact_digits) {
+  char str1[BUFFERSIZE * 8];
+  char str2[BUFFERSIZE * 8];
+  const char *formats[] = {"%.40f", "%.30e", "%.25g", "%f", "%.0e"};
+  double values[] = {0.1, 1e300, 5e-324, DBL_MAX, 123456789.123456789, 1e23};
+  for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); ++i) {
+    for (size_t j = 0; j < sizeof(values) / sizeof(values[0]); ++j) {
+      int a = s21_sprintf(str1, formats[i], values[j]);
+      int b = sprintf(str2, formats[i], values[j]);
+      ck_assert_int_eq(a, b);
+      ck_assert_str_eq(str1, str2);
+    }
+  }
+}
+END_TEST
+
+START_TEST(float_exact_long_double) {
+  char str1[BUFFERSIZE * 8];
+  char str2[BUFFERSIZE * 8];
+  const char *formats[] = {"%.35Le", "%.2Lf", "%.21Lg", "%Le"};
+  long double values[] = {LDBL_MAX, LDBL_MIN, LDBL_TRUE_MIN, 1.0L / 3.0L,
+                          0x1.fffffffffffffffep-1L};
+  for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); ++i) {
+    for (size_t j = 0; j < sizeof(values) / sizeof(values[0]); ++j) {
+      int a = s21_sprintf(str1, formats[i], values[j]);
+      int b = sprintf(str2, formats[i], values[j]);
+      ck_assert_int_eq(a, b);
+      ck_assert_str_eq(str1, str2);
+    }
+  }
+}
+END_TEST
+
+START_TEST(float_round_half_even) {
+  char str1[BUFFERSIZE];
+  char str2[BUFFERSIZE];
+  const char *formats[] = {"%.0f", "%.1f", "%.0e", "%.1g", "%g", "%#.3g"};
+  double values[] = {0.5, 1.5, 2.5, -0.5, 0.25, 0.125, 999999.5, 9.9999996,
+                     -0.0, 0.0, 1e-5};
+  for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); ++i) {
+    for (size_t j = 0; j < sizeof(values) / sizeof(values[0]); ++j) {
+      int a = s21_sprintf(str1, formats[i], values[j]);
+      int b = sprintf(str2, formats[i], values[j]);
+      ck_assert_int_eq(a, b);
+      ck_assert_str_eq(str1, str2);
+    }
+  }
+}
+END_TEST
+
+START_TEST(dtoa_shortest) {
+  char str[S21_DTOA_SIZE];
+  const char *expected[] = {"0.1",
+                            "-0",
+                            "1e+21",
+                            "5e-324",
+                            "0.3333333333333333",
+                            "100",
+                            "inf",
+                            "1.7976931348623157e+308",
+                            "0.0001",
+                            "1.5e-05"};
+  double values[] = {0.1,   -0.0,       1e21,    5e-324, 1.0 / 3.0,
+                     100.0, 1.0 / 0.0, DBL_MAX, 0.0001, 0.000015};
+  for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i) {
+    int n = s21_dtoa(str, values[i]);
+    ck_assert_str_eq(str, expected[i]);
+    ck_assert_int_eq(n, (int)strlen(expected[i]));
+  }
+}
+END_TEST
+
+START_TEST(dtoa_round_trip) {
+  char str[S21_DTOA_SIZE];
+  double value = 1e-300;
+  for (int i = 0; i < 600; ++i) {
+    s21_dtoa(str, value);
+    ck_assert(strtod(str, NULL) == value);
+    value *= 3.0;
+  }
+}
+END_TEST
+
+START_TEST(int_engine_limits) {
+  char str1[BUFFERSIZE];
+  char str2[BUFFERSIZE];
+  long values[] = {0, 1, -1, 9, 10, 99, 100, -12345, LONG_MAX, LONG_MIN};
+  const char *formats[] = {"%ld", "%+ld", "% 25ld", "%-25ld", "%025ld",
+                           "%.30ld", "%.0ld", "%lx", "%#lX", "%#lo"};
+  for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); ++i) {
+    for (size_t j = 0; j < sizeof(values) / sizeof(values[0]); ++j) {
+      int a = s21_sprintf(str1, formats[i], values[j]);
+      int b = sprintf(str2, formats[i], values[j]);
+      ck_assert_int_eq(a, b);
+      ck_assert_str_eq(str1, str2);
+    }
+  }
+}
+END_TEST
+
+START_TEST(int_engine_prefix_padding) {
+  char str1[BUFFERSIZE];
+  char str2[BUFFERSIZE];
+  unsigned values[] = {0, 7, 8, 255, 4096, UINT_MAX};
+  const char *formats[] = {"%#010x", "%#010X", "%#06o", "%#.0o",
+                           "%#o",    "%+06d",  "%#x",   "%.0u"};
+  for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); ++i) {
+    for (size_t j = 0; j < sizeof(values) / sizeof(values[0]); ++j) {
+      int a = s21_sprintf(str1, formats[i], values[j]);
+      int b = sprintf(str2, formats[i], values[j]);
+      ck_assert_int_eq(a, b);
+      ck_assert_str_eq(str1, str2);
+    }
+  }
+}
+END_TEST
+
+typedef struct counting_sink {
+  char data[3 * S21_SINK_STAGING_SIZE];
+  size_t length;
+  int writes;
+  int flushes;
+} counting_sink;
+
+static int counting_write(void *context, const char *span, s21_size_t len) {
+  counting_sink *sink = context;
+  memcpy(sink->data + sink->length, span, len);
+  sink->length += len;
+  sink->writes++;
+  return 0;
+}
+
+static int counting_flush(void *context) {
+  ((counting_sink *)context)->flushes++;
+  return 0;
+}
+
+static int failing_write(void *context, const char *span, s21_size_t len) {
+  (void)context;
+  (void)span;
+  (void)len;
+  return -1;
+}
+
+START_TEST(sink_callback) {
+  static counting_sink target;
+  static char expected[sizeof(target.data)];
+  sink_type sink = {counting_write, counting_flush, &target};
+  memset(&target, 0, sizeof(target));
+  int n = s21_sprintf_sink(&sink, "%d|%5000d|%s", 42, 7, "end");
+  int m = sprintf(expected, "%d|%5000d|%s", 42, 7, "end");
+  ck_assert_int_eq(n, m);
+  ck_assert_int_eq((int)target.length, m);
+  ck_assert_int_eq(memcmp(target.data, expected, target.length), 0);
+  ck_assert_int_eq(target.writes, 2);
+  ck_assert_int_eq(target.flushes, 1);
+  sink_type broken = {failing_write, s21_NULL, s21_NULL};
+  ck_assert_int_eq(s21_sprintf_sink(&broken, "%s", "lost"), -1);
+}
+END_TEST
+
+START_TEST(sink_buffers) {
+  char fixed[8];
+  sink_buffer_type buffer = {fixed, 0, sizeof(fixed), 0};
+  sink_type sink = s21_sink_buffer(&buffer);
+  ck_assert_int_eq(s21_sprintf_sink(&sink, "%s=%d", "value", 12345), 11);
+  ck_assert_str_eq(fixed, "value=1");
+  ck_assert_uint_eq(buffer.length, 7);
+  static char long_str[2 * S21_SINK_STAGING_SIZE + 1];
+  static char expected[3 * S21_SINK_STAGING_SIZE];
+  memset(long_str, 'z', sizeof(long_str) - 1);
+  char *out = s21_NULL;
+  int n = s21_asprintf(&out, "[%s|%-300.2f]", long_str, 2.5);
+  int m = sprintf(expected, "[%s|%-300.2f]", long_str, 2.5);
+  ck_assert_int_eq(n, m);
+  ck_assert_str_eq(out, expected);
+  free(out);
+  ck_assert_int_eq(s21_asprintf(&out, "%s", ""), 0);
+  ck_assert_str_eq(out, "");
+  free(out);
+}
+END_TEST
+
+START_TEST(sink_streams) {
+  FILE *stream = tmpfile();
+  char line[64] = {0};
+  ck_assert_ptr_nonnull(stream);
+  ck_assert_int_eq(s21_fprintf(stream, "%s-%03d-%.2e\n", "id", 7, 31.5), 16);
+  rewind(stream);
+  ck_assert_ptr_nonnull(fgets(line, sizeof(line), stream));
+  ck_assert_str_eq(line, "id-007-3.15e+01\n");
+  fclose(stream);
+  ck_assert_int_eq(s21_dprintf(-1, "%s", "nowhere"), -1);
+}
+END_TEST
+
+START_TEST(sprintf_batch_rows) {
+  char str1[BUFFERSIZE];
+  char str2[BUFFERSIZE];
+  const char *format = "%-4d|%+.2f|%*s|%hx|%c|%p|%Lg%n\n";
+  int ids[] = {1, -22, 333};
+  double values[] = {0.5, -1e10, 3.14159};
+  int widths[] = {6, -6, 0};
+  const char *names[] = {"a", "bc", "def"};
+  short masks[] = {0x7f, -1, 0};
+  char marks[] = {'x', 'y', 'z'};
+  void *pointers[] = {(void *)0x1, (void *)ids, (void *)0x10};
+  long double exact[] = {1e-5L, 123456789.0L, 0.0L};
+  int counts[3] = {0};
+  s21_size_t offsets[4] = {0};
+  int a = s21_sprintf_batch(str1, BUFFERSIZE, format, 3, offsets, ids, values,
+                            widths, names, masks, marks, pointers, exact,
+                            counts);
+  int b = 0;
+  for (int i = 0; i < 3; i++) {
+    int n = 0;
+    ck_assert_uint_eq(offsets[i], (s21_size_t)b);
+    b += sprintf(str2 + b, format, ids[i], values[i], widths[i], names[i],
+                 masks[i], marks[i], pointers[i], exact[i], &n);
+    ck_assert_int_eq(counts[i], n);
+  }
+  ck_assert_int_eq(a, b);
+  ck_assert_uint_eq(offsets[3], (s21_size_t)b);
+  ck_assert_str_eq(str1, str2);
+}
+END_TEST
+
+START_TEST(sprintf_batch_bounded) {
+  char str1[16];
+  char str2[BUFFERSIZE];
+  int ids[] = {10, 20, 30, 40, 50};
+  s21_size_t offsets[6] = {0};
+  int a = s21_sprintf_batch(str1, sizeof(str1), "id=%d;", 5, offsets, ids);
+  int b = sprintf(str2, "id=%d;id=%d;id=%d;id=%d;id=%d;", 10, 20, 30, 40, 50);
+  ck_assert_int_eq(a, b);
+  ck_assert_uint_eq(offsets[4], 24);
+  ck_assert_uint_eq(offsets[5], (s21_size_t)b);
+  str2[sizeof(str1) - 1] = '\0';
+  ck_assert_str_eq(str1, str2);
+  ck_assert_int_eq(s21_sprintf_batch(s21_NULL, 0, "%%%d", 0, s21_NULL, ids),
+                   0);
+}
+END_TEST
+
+START_TEST(sprintf_scratch_spill) {
+  const s21_size_t size = 60000;
+  char *str1 = malloc(size);
+  char *str2 = malloc(size);
+  ck_assert_ptr_nonnull(str1);
+  ck_assert_ptr_nonnull(str2);
+  int a = s21_sprintf(str1, "%.20000f|%030000d", 1.0 / 3, -42);
+  int b = sprintf(str2, "%.20000f|%030000d", 1.0 / 3, -42);
+  ck_assert_int_eq(a, b);
+  ck_assert_str_eq(str1, str2);
+  a = s21_sprintf(str1, "%#.12000g|%+020000.9000e|%09000u", 1e300, -2.5, 7u);
+  b = sprintf(str2, "%#.12000g|%+020000.9000e|%09000u", 1e300, -2.5, 7u);
+  ck_assert_int_eq(a, b);
+  ck_assert_str_eq(str1, str2);
+  a = s21_snprintf(str1, 16, "%.*Lf", 30000, 1e4000L);
+  b = snprintf(str2, size, "%.*Lf", 30000, 1e4000L);
+  str2[15] = '\0';
+  ck_assert_int_eq(a, b);
+  ck_assert_str_eq(str1, str2);
+  free(str1);
+  free(str2);
+}
+END_TEST
+
+START_TEST(sprintf_scratch_overflow) {
+  char str[16];
+  // a constant precision would trip -Wformat-overflow
+  volatile int precision = INT_MAX;
+  errno = 0;
+  ck_assert_int_eq(s21_snprintf(str, sizeof(str), "%.*f", precision, 1.0), -1);
+  ck_assert_int_eq(errno, EOVERFLOW);
+  ck_assert_int_eq(s21_snprintf(str, sizeof(str), "%.3f", 1.0), 5);
+  ck_assert_str_eq(str, "1.000");
+}
+END_TEST
+
+START_TEST(sprintf_layout_zero_precision) {
+  char str1[128];
+  char str2[128];
+  // a precision turns the '0' flag off, the literal would trip -Wformat
+  const char *format = "%08.3d|%08.0d|%-8.3x|%#08.3o|%+08.3i";
+  int a = s21_sprintf(str1, format, 5, 0, 255u, 8u, 42);
+  int b = sprintf(str2, format, 5, 0, 255u, 8u, 42);
+  ck_assert_int_eq(a, b);
+  ck_assert_str_eq(str1, str2);
+  a = s21_sprintf(str1, "%#010x|%010d|% 06d|%-6d|", 255u, -42, 7, -3);
+  b = sprintf(str2, "%#010x|%010d|% 06d|%-6d|", 255u, -42, 7, -3);
+  ck_assert_int_eq(a, b);
+  ck_assert_str_eq(str1, str2);
+}
+END_TEST
+
+START_TEST(sprintf_layout_inf) {
+  char str1[128];
+  char str2[128];
+  int a = s21_sprintf(str1, "%010f|%010e|%+010g|%-10E|%010.2f", -INFINITY,
+                      INFINITY, INFINITY, -INFINITY, -1.5);
+  int b = sprintf(str2, "%010f|%010e|%+010g|%-10E|%010.2f", -INFINITY,
+                  INFINITY, INFINITY, -INFINITY, -1.5);
+  ck_assert_int_eq(a, b);
+  ck_assert_str_eq(str1, str2);
+}
+END_TEST
+
+START_TEST(sprintf_g_notation) {
+  char str1[128];
+  char str2[128];
+  const char *formats[] = {"%g", "%.3g", "%#g", "%.10G", "%#.1g", "%-+12.4g"};
+  double values[] = {0.0,   100000.0,  999999.4, 1e-4,      0.00012345,
+                     123.45, 1e9,       1e-300,   999999999, 2.5e15,
+                     1e100,  -0.000125, 1.5};
+  for (s21_size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); i++) {
+    for (s21_size_t j = 0; j < sizeof(values) / sizeof(values[0]); j++) {
+      int a = s21_sprintf(str1, formats[i], values[j]);
+      int b = sprintf(str2, formats[i], values[j]);
+      ck_assert_int_eq(a, b);
+      ck_assert_str_eq(str1, str2);
+    }
+  }
+  // rounding carries into the next power of ten and may switch notation
+  ck_assert_int_eq(s21_sprintf(str1, "%g|%g|%.2g", 999999.5, 9.99995e-5, 99.9),
+                   sprintf(str2, "%g|%g|%.2g", 999999.5, 9.99995e-5, 99.9));
+  ck_assert_str_eq(str1, str2);
+}
+END_TEST
+
+START_TEST(sprintf_format_routes) {
+  char str1[128];
+  char str2[128];
+  char name[] = "port";
+  char symbol = 'x';
+  int calls = 0;
+  ck_assert_int_eq(s21_sprintf(str1, "%d", INT_MIN),
+                   sprintf(str2, "%d", INT_MIN));
+  ck_assert_str_eq(str1, str2);
+  ck_assert_int_eq(s21_sprintf(str1, "%li", LONG_MIN),
+                   sprintf(str2, "%li", LONG_MIN));
+  ck_assert_str_eq(str1, str2);
+  ck_assert_int_eq(s21_sprintf(str1, "%lu", ULONG_MAX),
+                   sprintf(str2, "%lu", ULONG_MAX));
+  ck_assert_str_eq(str1, str2);
+  ck_assert_int_eq(s21_sprintf(str1, "%x", 0xbeefu), 4);
+  ck_assert_str_eq(str1, "beef");
+  ck_assert_int_eq(s21_sprintf(str1, "%c", symbol), 1);
+  ck_assert_str_eq(str1, "x");
+  ck_assert_int_eq(s21_sprintf(str1, "%s", name), 4);
+  ck_assert_str_eq(str1, "port");
+  ck_assert_int_eq(s21_sprintf(str1, "%s:%d", name, -8080),
+                   sprintf(str2, "%s:%d", name, -8080));
+  ck_assert_str_eq(str1, str2);
+  ck_assert_int_eq(s21_sprintf(str1, "%.3f", 2.0005),
+                   sprintf(str2, "%.3f", 2.0005));
+  ck_assert_str_eq(str1, str2);
+  ck_assert_int_eq(s21_sprintf(str1, "%f", -1e20), sprintf(str2, "%f", -1e20));
+  ck_assert_str_eq(str1, str2);
+  ck_assert_int_eq(s21_sprintf(str1, "%.0f", 2.5f),
+                   sprintf(str2, "%.0f", 2.5f));
+  ck_assert_str_eq(str1, str2);
+  ck_assert_int_eq(s21_sprintf(str1, "plain"), 5);
+  ck_assert_str_eq(str1, "plain");
+  // a type the route does not take goes through s21_vsnprintf
+  ck_assert_int_eq(s21_sprintf(str1, "%x", 255), 2);
+  ck_assert_str_eq(str1, "ff");
+  ck_assert_int_eq(s21_sprintf(str1, "%d|%d", 1, 2), 3);
+  ck_assert_str_eq(str1, "1|2");
+  // both paths evaluate the arguments once
+  ck_assert_int_eq(s21_sprintf(str1, "%d", ++calls), 1);
+  ck_assert_int_eq(s21_sprintf(str1, "%d%%", ++calls), 2);
+  ck_assert_int_eq(calls, 2);
+  ck_assert_str_eq(str1, "2%");
+}
+END_TEST
+
+START_TEST(sprintf_wide_utf8) {
+  char str1[128];
+  char long_ascii[64];
+  wchar_t wide_ascii[64];
+  const wchar_t word[] = {L'\x41f', L'\x440', L'\x438', L'W', 0};
+  const wchar_t emoji[] = {L'a', (wchar_t)0x1F600, L'b', 0};
+  const wchar_t surrogate[] = {L'a', (wchar_t)0xD800, 0};
+  ck_assert_int_eq(s21_sprintf(str1, "%ls", word), 7);
+  ck_assert_str_eq(str1, "\xd0\x9f\xd1\x80\xd0\xb8W");
+  ck_assert_int_eq(s21_sprintf(str1, "%ls", emoji), 6);
+  ck_assert_str_eq(str1, "a\xf0\x9f\x98\x80" "b");
+  // the precision is a byte budget that never splits a character
+  ck_assert_int_eq(s21_sprintf(str1, "%.3ls|%.4ls", word, word), 7);
+  ck_assert_str_eq(str1, "\xd0\x9f|\xd0\x9f\xd1\x80");
+  ck_assert_int_eq(s21_sprintf(str1, "%.4ls", emoji), 1);
+  ck_assert_str_eq(str1, "a");
+  // the width counts bytes too
+  ck_assert_int_eq(s21_sprintf(str1, "[%9ls][%-9ls]", word, word), 22);
+  ck_assert_str_eq(str1, "[  \xd0\x9f\xd1\x80\xd0\xb8W]"
+                         "[\xd0\x9f\xd1\x80\xd0\xb8W  ]");
+  ck_assert_int_eq(s21_sprintf(str1, "%lc|%3lc|%lc", (wint_t)0xE9, (wint_t)'x',
+                               (wint_t)0x20AC),
+                   10);
+  ck_assert_str_eq(str1, "\xc3\xa9|  x|\xe2\x82\xac");
+  // runs of ASCII take the block path
+  for (int i = 0; i < 63; i++) {
+    long_ascii[i] = (char)('a' + i % 26);
+    wide_ascii[i] = (wchar_t)long_ascii[i];
+  }
+  long_ascii[63] = '\0';
+  wide_ascii[63] = L'\0';
+  ck_assert_int_eq(s21_sprintf(str1, "%ls", wide_ascii), 63);
+  ck_assert_str_eq(str1, long_ascii);
+  ck_assert_int_eq(s21_sprintf(str1, "%.20ls", wide_ascii), 20);
+  ck_assert_int_eq(s21_strncmp(str1, long_ascii, 20), 0);
+  // code points without a UTF-8 form fail
+  errno = 0;
+  ck_assert_int_eq(s21_sprintf(str1, "%ls", surrogate), -1);
+  ck_assert_int_eq(errno, EILSEQ);
+  errno = 0;
+  ck_assert_int_eq(s21_sprintf(str1, "%lc", (wint_t)0x110000), -1);
+  ck_assert_int_eq(errno, EILSEQ);
+}
+END_TEST
+
+// a negative '*' precision counts as omitted, so the '0' flag applies
+START_TEST(sprintf_negative_star_precision) {
+  char str1[BUFFERSIZE];
+  char str2[BUFFERSIZE];
+  const char *format = "[%0*.*d] [%0*.*x] [%0*.*u] [%.*s] [%0*.*f]";
+  int precisions[] = {-3, -1, 0, 2};
+  plan_type plan;
+  ck_assert_int_eq(s21_compile_format(&plan, format), 0);
+  for (size_t i = 0; i < sizeof(precisions) / sizeof(precisions[0]); ++i) {
+    int p = precisions[i];
+    int b = sprintf(str2, format, 8, p, 5, 8, p, 255u, 8, p, 42u, p, "abcdef",
+                    10, p, 3.25);
+    ck_assert_int_eq(s21_sprintf(str1, format, 8, p, 5, 8, p, 255u, 8, p, 42u,
+                                 p, "abcdef", 10, p, 3.25),
+                     b);
+    ck_assert_str_eq(str1, str2);
+    ck_assert_int_eq(s21_sprintf_plan(str1, &plan, 8, p, 5, 8, p, 255u, 8, p,
+                                      42u, p, "abcdef", 10, p, 3.25),
+                     b);
+    ck_assert_str_eq(str1, str2);
+  }
+  const char *zero = "%0*.*d";
+  ck_assert_int_eq(s21_sprintf(str1, zero, 8, -3, 5), 8);
+  ck_assert_str_eq(str1, "00000005");
+  int widths[] = {8, 6, 4};
+  int values[] = {5, -7, 123};
+  s21_size_t offsets[4] = {0};
+  ck_assert_int_eq(s21_sprintf_batch(str1, BUFFERSIZE, "%0*.*d\n", 3, offsets,
+                                     widths, precisions, values),
+                   21);
+  ck_assert_str_eq(str1, "00000005\n-00007\n 123\n");
+}
+END_TEST
+
 Suite *s21_suite_sprintf(void) {
   Suite *s;
   TCase *tc;
@@ -1917,6 +2516,35 @@ Suite *s21_suite_sprintf(void) {
   tcase_add_test(tc, test_sprintf29);
   tcase_add_test(tc, test_sprintf41);
   tcase_add_test(tc, test_sprintf42);
+
+  tcase_add_test(tc, snprintf_truncation);
+  tcase_add_test(tc, snprintf_null_buffer);
+  tcase_add_test(tc, snprintf_wide_padding);
+  tcase_add_test(tc, vsnprintf_basic);
+  tcase_add_test(tc, sprintf_plan_reuse);
+  tcase_add_test(tc, sprintf_plan_star);
+  tcase_add_test(tc, sprintf_plan_bounded);
+  tcase_add_test(tc, sprintf_plan_limits);
+  tcase_add_test(tc, float_exact_digits);
+  tcase_add_test(tc, float_exact_long_double);
+  tcase_add_test(tc, float_round_half_even);
+  tcase_add_test(tc, dtoa_shortest);
+  tcase_add_test(tc, dtoa_round_trip);
+  tcase_add_test(tc, int_engine_limits);
+  tcase_add_test(tc, int_engine_prefix_padding);
+  tcase_add_test(tc, sink_callback);
+  tcase_add_test(tc, sink_buffers);
+  tcase_add_test(tc, sink_streams);
+  tcase_add_test(tc, sprintf_batch_rows);
+  tcase_add_test(tc, sprintf_batch_bounded);
+  tcase_add_test(tc, sprintf_scratch_spill);
+  tcase_add_test(tc, sprintf_scratch_overflow);
+  tcase_add_test(tc, sprintf_layout_zero_precision);
+  tcase_add_test(tc, sprintf_layout_inf);
+  tcase_add_test(tc, sprintf_format_routes);
+  tcase_add_test(tc, sprintf_g_notation);
+  tcase_add_test(tc, sprintf_wide_utf8);
+  tcase_add_test(tc, sprintf_negative_star_precision);
   suite_add_tcase(s, tc);
   return s;
 }
\ No newline at end of file
@@ -10,6 +10,24 @@
  * Function Overview:
  * - `sscanf`: Reads data from a string based on the provided format string and
  * stores the results in the specified variables.
+ * - `s21_vsscanf`: The same with a va_list of the arguments.
+ * - `s21_compile_scan_format`: Parses a format string once into a
+ * scan_plan_type.
+ * - `s21_sscanf_plan`: Reads data from a string according to a compiled plan.
+ * - `s21_sscanf_batch`: Reads newline-separated records of one format into
+ * column arrays.
+ * - `s21_scan`, `s21_fscanf`: The same steps over chunked input, see
+ * s21_source.c.
+ *
+ * Both entry points run the same steps: `s21_parse_scan_step` splits the format
+ * into literal text and a conversion, `s21_execute_scan_step` matches the
+ * literal and handles the conversion. A plan keeps the parsed steps so the
+ * '*', width and length modifier are read only once per format.
+ *
+ * Beyond the standard conversions, %[set] and %[^set] read the longest run of
+ * characters inside or outside a set that is compiled once per step into a
+ * 256-bit charset_type, and the 'v' modifier makes %vs, %vc and %v[set] store
+ * a strview_type that points into the input instead of copying the token.
  *
  * @param str String to read data from
  * @param format Format string that controls how data is interpreted
@@ -24,6 +42,17 @@
  * lead to undefined behavior.
  */
 #include "s21_sscanf.h"
+#include "s21_stats.h"
+
+static const charset_type s21_whitespace = S21_CHARSET_WHITESPACE;
+// " \t\v\f\r", the whitespace that does not end a record
+static const charset_type s21_record_whitespace = {{0x100003A00ULL, 0, 0, 0}};
+// everything but '\0' and s21_whitespace, the characters of a %s token
+static const charset_type s21_token_chars = {
+    {0xFFFFFFFEFFFFC1FEULL, ~0ULL, ~0ULL, ~0ULL}};
+static const float_format_type s21_float_format = S21_FLOAT_FORMAT;
+static const float_format_type s21_double_format = S21_DOUBLE_FORMAT;
+static const float_format_type s21_long_double_format = S21_LONG_DOUBLE_FORMAT;
 /**
  * @brief The s21_sscanf function performs formatted input from a string
  *   according to the format specifications.
@@ -34,48 +63,514 @@
  * an error occurred.
  */
 int s21_sscanf(const char *str, const char *format, ...) {
-  int result = 0, parsing_status = 0, width = 0;
-  char *temp_str = (char *)str, *temp_format = (char *)format;
-  char whitespace[7] = " \f\n\r\t\v";
   va_list argument_pointer;
-  int processing_state = 1;
-  int missing_specs_count = 0;
   va_start(argument_pointer, format);
-  while (*temp_format && !parsing_status) {
-    parsing_status = s21_parse_and_match(&temp_str, &temp_format);
-    if ((processing_state && *temp_str) ||
-        (processing_state && *temp_format == '%'))
-      result = 0;
-
-    if (*temp_format == '%') {
-      temp_format++;
-      s21_asterisk(&temp_format, &missing_specs_count);
-      if (*temp_format >= '0' && *temp_format <= '9') {
-        width = s21_convert_string_to_unsigned_long_long(&temp_format, 0,
-                                                         &parsing_status, 117);
-      }
-      s21_asterisk(&temp_format, &missing_specs_count);
-    }
-    int assignment_target_type = 0;
-    s21_handle_length_modifier(&temp_format, &assignment_target_type);
-    if (!parsing_status) {
-      parsing_status = s21_handle_specifier(
-          &temp_str, &temp_format, argument_pointer, &result,
-          &missing_specs_count, &processing_state, &parsing_status, width,
-          assignment_target_type, whitespace, str);
-      width = 0;
+  int result = s21_vsscanf(str, format, argument_pointer);
+  va_end(argument_pointer);
+  return result;
+}
+/**
+ * @brief Performs formatted input from a string with a va_list of the
+ * arguments.
+ *
+ * @param str Pointer to the line to enter.
+ * @param format Pointer to the format string that defines the data entry.
+ * @param var_arg Variable argument list of the pointers to store to.
+ * @return Returns the number of successfully processed specifications, or 0 if
+ * an error occurred.
+ */
+int s21_vsscanf(const char *str, const char *format, va_list var_arg) {
+  char *temp_format = (char *)format;
+  scan_step_type step;
+  scan_state_type state = {(char *)str, 0, 0, 1, 0};
+  va_list argument_pointer;
+  va_copy(argument_pointer, var_arg);
+  while (*temp_format && !state.parsing_status) {
+    s21_parse_scan_step(&temp_format, &step);
+    s21_execute_scan_step(&state, &step, &argument_pointer, str);
+  }
+  va_end(argument_pointer);
+  S21_STAT_ADD(sscanf_calls, 1);
+  if (state.parsing_status) S21_STAT_ADD(parse_failures, 1);
+  return state.result;
+}
+/**
+ * @brief Compiles a format string into a plan that can be executed repeatedly
+ * with s21_sscanf_plan.
+ *
+ * @param plan Pointer to the plan to fill.
+ * @param format Pointer to the format string, must outlive the plan.
+ * @return 0 on success, 1 if the format has more than S21_SCAN_PLAN_MAX_STEPS
+ * steps.
+ */
+int s21_compile_scan_format(scan_plan_type *plan, const char *format) {
+  char *temp_format = (char *)format;
+  int status = 0;
+  plan->steps_count = 0;
+  while (*temp_format && !status) {
+    if (plan->steps_count == S21_SCAN_PLAN_MAX_STEPS) {
+      status = 1;
+    } else {
+      s21_parse_scan_step(&temp_format, &plan->steps[plan->steps_count++]);
     }
-    if (result) processing_state = 0;
-    if (processing_state != 2) processing_state = 0;
+  }
+  return status;
+}
+/**
+ * @brief Performs formatted input from a string according to a compiled plan.
+ *
+ * @param str Pointer to the line to enter.
+ * @param plan Pointer to a plan filled by s21_compile_scan_format.
+ * @return Returns the number of successfully processed specifications, or 0 if
+ * an error occurred.
+ */
+int s21_sscanf_plan(const char *str, const scan_plan_type *plan, ...) {
+  scan_state_type state = {(char *)str, 0, 0, 1, 0};
+  va_list argument_pointer;
+  va_start(argument_pointer, plan);
+  for (int i = 0; i < plan->steps_count && !state.parsing_status; i++) {
+    s21_execute_scan_step(&state, &plan->steps[i], &argument_pointer, str);
   }
   va_end(argument_pointer);
+  S21_STAT_ADD(sscanf_calls, 1);
+  if (state.parsing_status) S21_STAT_ADD(parse_failures, 1);
+  return state.result;
+}
+/**
+ * @brief Parses one step of the format string: the literal text up to the next
+ * '%' and the conversion that follows it.
+ *
+ * @param temp_format Pointer to current position in the format string, updated
+ * past the parsed step.
+ * @param step Pointer to the step to fill.
+ */
+void s21_parse_scan_step(char **temp_format, scan_step_type *step) {
+  int parsing_status = 0;
+  step->literal = *temp_format;
+  step->suppress = 0;
+  step->width = 0;
+  step->assignment_target_type = 0;
+  step->specifier = '\0';
+  while (**temp_format && **temp_format != '%') (*temp_format)++;
+  if (**temp_format == '%') {
+    (*temp_format)++;
+    s21_asterisk(temp_format, &step->suppress);
+    if (**temp_format >= '0' && **temp_format <= '9') {
+      step->width = s21_convert_string_to_unsigned_long_long(
+          temp_format, 0, &parsing_status, 117);
+    }
+    s21_asterisk(temp_format, &step->suppress);
+    s21_handle_length_modifier(temp_format, &step->assignment_target_type);
+    step->specifier = **temp_format;
+    if (**temp_format) (*temp_format)++;
+    if (step->specifier == '[') s21_parse_scan_set(temp_format, &step->set);
+  }
+}
+/**
+ * @brief Compiles the set of a '[' conversion into a bitmap.
+ *
+ * A ']' right after the opening '[' or '^' belongs to the set, and "a-z"
+ * stands for the bytes 'a' to 'z' unless the '-' comes first or last.
+ *
+ * @param temp_format Pointer to the position after '[', updated past the
+ * closing ']'.
+ * @param set Pointer to the set to fill. An unterminated set is left empty,
+ * so the conversion fails.
+ */
+void s21_parse_scan_set(char **temp_format, charset_type *set) {
+  const unsigned char *ptr = (const unsigned char *)*temp_format;
+  int negate = *ptr == '^';
+  if (negate) ptr++;
+  const unsigned char *first = ptr;
+  s21_charset_init(set, s21_NULL);
+  while (*ptr && (*ptr != ']' || ptr == first)) {
+    if (ptr[1] == '-' && ptr[2] && ptr[2] != ']' && ptr[0] <= ptr[2]) {
+      for (unsigned int c = ptr[0]; c <= ptr[2]; c++) s21_charset_add(set, c);
+      ptr += 3;
+    } else {
+      s21_charset_add(set, *ptr++);
+    }
+  }
+  if (*ptr == ']') {
+    if (negate) s21_charset_invert(set);
+    ptr++;
+  } else {
+    s21_charset_init(set, s21_NULL);
+  }
+  *temp_format = (char *)ptr;
+}
+/**
+ * @brief Matches the literal text of a step against the input and then
+ * handles its conversion.
+ *
+ * @param state Pointer to the state of the current s21_sscanf call.
+ * @param step Pointer to the step to execute.
+ * @param argument_pointer Pointer to va_list for variadic arguments.
+ * @param str The original input string.
+ */
+void s21_execute_scan_step(scan_state_type *state, const scan_step_type *step,
+                           va_list *argument_pointer, const char *str) {
+  s21_match_scan_literal(state, step);
+  s21_convert_scan_step(state, step, argument_pointer, str);
+}
+/**
+ * @brief Matches the literal text of a step against the input.
+ *
+ * @param state Pointer to the state of the current s21_sscanf call, its
+ * parsing_status is set when the literal does not match.
+ * @param step Pointer to the step.
+ */
+void s21_match_scan_literal(scan_state_type *state,
+                            const scan_step_type *step) {
+  char *temp_format = (char *)step->literal;
+  state->parsing_status =
+      s21_parse_and_match(&state->temp_str, &temp_format, &s21_whitespace);
+  if ((state->processing_state && *state->temp_str) ||
+      (state->processing_state && *temp_format == '%'))
+    state->result = 0;
+  if (step->suppress) state->missing_specs_count = 1;
+}
+/**
+ * @brief Handles the conversion of a step whose literal was matched.
+ *
+ * @param state Pointer to the state of the current s21_sscanf call.
+ * @param step Pointer to the step.
+ * @param argument_pointer Pointer to va_list for variadic arguments.
+ * @param str The original input string.
+ */
+void s21_convert_scan_step(scan_state_type *state, const scan_step_type *step,
+                           va_list *argument_pointer, const char *str) {
+  if (!state->parsing_status) {
+    if (step->specifier) {
+      S21_STAT_COUNT(sscanf_specifiers, (unsigned char)step->specifier,
+                     S21_STATS_SCAN_SPECIFIERS);
+    }
+    state->parsing_status = s21_handle_specifier(
+        &state->temp_str, step->specifier, argument_pointer, &state->result,
+        &state->missing_specs_count, &state->processing_state,
+        &state->parsing_status, step->width, step->assignment_target_type,
+        &step->set, &s21_whitespace, str);
+  }
+  if (state->result) state->processing_state = 0;
+  if (state->processing_state != 2) state->processing_state = 0;
+}
+// __Batches__
+/**
+ * @brief Reads newline-separated records of one format into column arrays.
+ *
+ * The format is compiled once and every record is read without a va_list:
+ * the k-th assigning conversion of a record is stored in row 'row' of the
+ * k-th column, and whitespace inside a record does not reach the next one.
+ *
+ * @param input Pointer to the records, each ended by '\n' or the end of the
+ * string.
+ * @param format Pointer to the format of one record.
+ * @param columns Array with one column for every conversion that assigns,
+ * %n included.
+ * @param status Array of 'rows' elements, set to the s21_sscanf result of
+ * every record read.
+ * @param rows Maximum number of records to read.
+ * @param end Pointer set to the first record not read, may be s21_NULL.
+ * @return Number of records read, or -1 if the format has more than
+ * S21_SCAN_PLAN_MAX_STEPS steps.
+ */
+int s21_sscanf_batch(const char *input, const char *format,
+                     const scan_column_type *columns, int *status, int rows,
+                     const char **end) {
+  scan_plan_type plan;
+  s21_size_t strides[S21_SCAN_PLAN_MAX_STEPS];
+  int row = s21_compile_scan_format(&plan, format) ? -1 : 0;
+  if (row == 0) s21_scan_batch_strides(&plan, columns, strides);
+  while (row >= 0 && row < rows && *input) {
+    const char *record_end = s21_strchr(input, '\n');
+    if (!record_end) record_end = input + s21_strlen(input);
+    status[row] = s21_scan_batch_record(&plan, input, record_end, columns,
+                                        strides, row);
+    input = *record_end ? record_end + 1 : record_end;
+    row++;
+  }
+  if (end) *end = input;
+  return row;
+}
+/**
+ * @brief Computes the distance between the rows of every column of a batch.
+ *
+ * @param plan Pointer to the compiled format of one record.
+ * @param columns Array of the columns, a stride of 0 means the size of the
+ * target type.
+ * @param strides Array set to the stride in bytes of every column.
+ */
+void s21_scan_batch_strides(const scan_plan_type *plan,
+                            const scan_column_type *columns,
+                            s21_size_t *strides) {
+  int column = 0;
+  for (int i = 0; i < plan->steps_count; i++) {
+    const scan_step_type *step = &plan->steps[i];
+    if (s21_scan_step_assigns(step)) {
+      strides[column] = columns[column].stride
+                            ? columns[column].stride
+                            : s21_scan_target_size(step);
+      column++;
+    }
+  }
+}
+/**
+ * @brief Reads one record of a batch.
+ *
+ * @param plan Pointer to the compiled format of the record.
+ * @param record Pointer to the first character of the record.
+ * @param record_end Pointer to the '\n' or the null character after it.
+ * @param columns Array of the columns.
+ * @param strides Array of the strides of the columns.
+ * @param row Index of the record.
+ * @return Number of assigned conversions, or -1 if the record ended before
+ * the first one.
+ */
+int s21_scan_batch_record(const scan_plan_type *plan, const char *record,
+                          const char *record_end,
+                          const scan_column_type *columns,
+                          const s21_size_t *strides, int row) {
+  char *temp_str = (char *)record;
+  int result = 0, parsing_status = 0, column = 0;
+  for (int i = 0; i < plan->steps_count && !parsing_status; i++) {
+    const scan_step_type *step = &plan->steps[i];
+    char *temp_format = (char *)step->literal;
+    parsing_status =
+        s21_parse_and_match(&temp_str, &temp_format, &s21_record_whitespace);
+    if (!parsing_status && step->specifier) {
+      void *target = s21_NULL;
+      if (s21_scan_step_assigns(step)) {
+        target = (char *)columns[column].data + row * strides[column];
+        column++;
+      }
+      parsing_status =
+          s21_scan_batch_field(&temp_str, record_end, step, target, record);
+      if (!parsing_status && target && step->specifier != 'n') result++;
+    }
+  }
+  if (parsing_status && !result && temp_str == record_end) result = -1;
+  S21_STAT_ADD(sscanf_calls, 1);
+  if (parsing_status) S21_STAT_ADD(parse_failures, 1);
   return result;
 }
+/**
+ * @brief Reads one conversion of a batch record and stores its value.
+ *
+ * @param temp_str Pointer to the current position in the record.
+ * @param record_end Pointer to the end of the record.
+ * @param step Pointer to the conversion.
+ * @param target Pointer to the element to store, s21_NULL to drop the value.
+ * @param record Pointer to the first character of the record, for %n.
+ * @return Parsing status (0: success, 1: failure).
+ */
+int s21_scan_batch_field(char **temp_str, const char *record_end,
+                         const scan_step_type *step, void *target,
+                         const char *record) {
+  int parsing_status = 0;
+  char specifier = step->specifier;
+  unsigned long long sum = 0;
+  long double converted_float = 0;
+  int length = 0;
+  S21_STAT_COUNT(sscanf_specifiers, (unsigned char)specifier,
+                 S21_STATS_SCAN_SPECIFIERS);
+  if (specifier != 'c' && specifier != 'n' && specifier != '[') {
+    *temp_str += s21_charset_span(*temp_str, &s21_record_whitespace);
+  }
+  switch (specifier) {
+    case 'c':
+      length = step->width ? step->width : 1;
+      if (step->assignment_target_type == 3) {
+        length = s21_scan_wide_length(*temp_str, step->width);
+      }
+      if (length > record_end - *temp_str) length = record_end - *temp_str;
+      if (length == 0) parsing_status = 1;
+      if (!parsing_status && target) {
+        if (step->assignment_target_type == S21_SCAN_VIEW) {
+          *(strview_type *)target = s21_strview_n(*temp_str, length);
+        } else if (step->assignment_target_type == 3) {
+          s21_utf8_decode_string(target, *temp_str, length);
+        } else {
+          s21_memcpy(target, *temp_str, length);
+        }
+      }
+      *temp_str += length;
+      break;
+    case 's':
+    case '[':
+      length = s21_scan_span(
+          *temp_str, specifier == 's' ? &s21_token_chars : &step->set,
+          step->width);
+      if (length > record_end - *temp_str) length = record_end - *temp_str;
+      if (step->assignment_target_type == 3 && step->width) {
+        length = (int)s21_utf8_boundary(*temp_str, length);
+      }
+      if (length == 0) parsing_status = 1;
+      if (!parsing_status && target) {
+        s21_store_token(target, *temp_str, length,
+                        step->assignment_target_type);
+      }
+      *temp_str += length;
+      break;
+    case 'd':
+    case 'u':
+      sum = s21_convert_string_to_unsigned_long_long(
+          temp_str, step->width, &parsing_status, specifier);
+      if (!parsing_status && target)
+        s21_store_integer(target, sum, step->assignment_target_type);
+      break;
+    case 'i':
+      sum = s21_convert_string_to_long_long(temp_str, step->width,
+                                            &parsing_status, 10);
+      if (!parsing_status && target)
+        s21_store_integer(target, sum, step->assignment_target_type);
+      break;
+    case 'o':
+    case 'x':
+    case 'X':
+    case 'p':
+      sum = s21_convert_string_to_unsigned_long_long_base(
+          temp_str, step->width, &parsing_status, specifier == 'o' ? 8 : 16);
+      if (!parsing_status && target)
+        s21_store_integer(target, sum,
+                          specifier == 'p' ? 3 : step->assignment_target_type);
+      break;
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'f':
+      converted_float = s21_parse_string_to_long_double_with_exponent(
+          temp_str, step->width, &parsing_status,
+          step->assignment_target_type == 3   ? &s21_double_format
+          : step->assignment_target_type == 5 ? &s21_long_double_format
+                                              : &s21_float_format);
+      if (!parsing_status && target)
+        s21_store_float(target, converted_float, step->assignment_target_type);
+      break;
+    case 'n':
+      if (target)
+        s21_store_integer(target, *temp_str - record,
+                          step->assignment_target_type);
+      break;
+    case '%':
+      if (**temp_str == '%')
+        (*temp_str)++;
+      else
+        parsing_status = 1;
+      break;
+    default:
+      parsing_status = 1;
+      break;
+  }
+  return parsing_status;
+}
+/**
+ * @brief Checks whether a step stores a value and so takes a column.
+ *
+ * @param step Pointer to the step.
+ * @return 1 for a conversion without '*' other than %%, otherwise 0.
+ */
+int s21_scan_step_assigns(const scan_step_type *step) {
+  return step->specifier && step->specifier != '%' && !step->suppress;
+}
+/**
+ * @brief Returns the size of the value a conversion stores.
+ *
+ * @param step Pointer to the conversion.
+ * @return Size in bytes, the field width for %c, 0 for %s and %[ and the size
+ * of strview_type for their 'v' forms.
+ */
+s21_size_t s21_scan_target_size(const scan_step_type *step) {
+  s21_size_t size = 0;
+  int type = step->assignment_target_type;
+  if (type == S21_SCAN_VIEW && s21_strchr("cs[", step->specifier)) {
+    size = sizeof(strview_type);
+  } else if (step->specifier == 'c') {
+    size = step->width ? step->width : 1;
+    if (type == 3) size *= sizeof(wchar_t);
+  } else if (step->specifier == 'p') {
+    size = sizeof(void *);
+  } else if (s21_strchr("eEgGf", step->specifier)) {
+    size = type == 3   ? sizeof(double)
+           : type == 5 ? sizeof(long double)
+                       : sizeof(float);
+  } else if (step->specifier != 's' && step->specifier != '[') {
+    size = type == 1   ? sizeof(char)
+           : type == 2 ? sizeof(short int)
+           : type == 3 ? sizeof(long int)
+           : type == 4 ? sizeof(long long int)
+                       : sizeof(int);
+  }
+  return size;
+}
+/**
+ * @brief Stores an integer to an element of the type of a length modifier.
+ *
+ * @param target Pointer to the element.
+ * @param value The value, truncated to the type.
+ * @param assignment_target_type See s21_handle_length_modifier.
+ */
+void s21_store_integer(void *target, unsigned long long value,
+                       int assignment_target_type) {
+  if (assignment_target_type == 1) {
+    *(unsigned char *)target = (unsigned char)value;
+  } else if (assignment_target_type == 2) {
+    *(unsigned short int *)target = (unsigned short int)value;
+  } else if (assignment_target_type == 3) {
+    *(unsigned long int *)target = (unsigned long int)value;
+  } else if (assignment_target_type == 4) {
+    *(unsigned long long int *)target = value;
+  } else {
+    *(unsigned int *)target = (unsigned int)value;
+  }
+}
+/**
+ * @brief Stores a floating-point value to an element of the type of a length
+ * modifier.
+ *
+ * @param target Pointer to the element.
+ * @param value The value.
+ * @param assignment_target_type See s21_handle_length_modifier, 4 ("ll")
+ * stores nothing like s21_format_long_double_result_with_width.
+ */
+void s21_store_float(void *target, long double value,
+                     int assignment_target_type) {
+  if (assignment_target_type == 3) {
+    *(double *)target = (double)value;
+  } else if (assignment_target_type == 5) {
+    *(long double *)target = value;
+  } else if (assignment_target_type != 4) {
+    *(float *)target = (float)value;
+  }
+}
+/**
+ * @brief Stores a token of %s, %c or %[ as a string or, with the 'v'
+ * modifier, as a view into the input.
+ *
+ * @param target Pointer to the char array or the strview_type.
+ * @param token Pointer to the token in the input.
+ * @param length Length of the token.
+ * @param assignment_target_type S21_SCAN_VIEW for a view, 3 ('l') to decode
+ * the token into a null-terminated wchar_t string, otherwise the token is
+ * copied and null-terminated.
+ */
+void s21_store_token(void *target, const char *token, s21_size_t length,
+                     int assignment_target_type) {
+  if (assignment_target_type == S21_SCAN_VIEW) {
+    *(strview_type *)target = s21_strview_n(token, length);
+  } else if (assignment_target_type == 3) {
+    wchar_t *wide = target;
+    wide[s21_utf8_decode_string(wide, token, length)] = L'\0';
+  } else {
+    s21_memcpy(target, token, length);
+    ((char *)target)[length] = '\0';
+  }
+}
 /**
  * @brief Handles various format specifiers for a custom formatting function.
  *
  * @param temp_str A pointer to the current position in the input string.
- * @param temp_format A pointer to the current position in the format string.
+ * @param specifier The conversion specifier character.
  * @param argument_pointer The list of arguments passed to the custom form.
  * function.
  * @param result A pointer to the variable storing the cumulative result of the
@@ -89,32 +584,32 @@ int s21_sscanf(const char *str, const char *format, ...) {
  * @param width The width specifier for formatting.
  * @param assignment_target_type Additional state or information used for
  * certain specifiers.
- * @param whitespace A string containing whitespace characters to be used in
- * formatting.
+ * @param scan_set Set of the characters of a '[' conversion.
+ * @param whitespace Set of the whitespace characters to skip.
  * @param str The original input string.
  * @return An integer indicating the parsing status
  */
-int s21_handle_specifier(char **temp_str, char **temp_format,
-                         va_list argument_pointer, int *result,
+int s21_handle_specifier(char **temp_str, char specifier,
+                         va_list *argument_pointer, int *result,
                          int *missing_specs_count, int *processing_state,
                          int *parsing_status, int width,
-                         int assignment_target_type, char *whitespace,
-                         const char *str) {
-  char temp_result[1024] = {0};
-  int s21_len = s21_strlen(*temp_str);
-  int lens = 0;
-  int e = 0;
-  switch (**temp_format) {
+                         int assignment_target_type,
+                         const charset_type *scan_set,
+                         const charset_type *whitespace, const char *str) {
+  switch (specifier) {
     case 'c':
-      s21_handle_char_conversion(temp_str, argument_pointer, result,
-                                 missing_specs_count, processing_state,
-                                 parsing_status, width, s21_len);
+      s21_handle_char_conversion(
+          temp_str, argument_pointer, result, missing_specs_count,
+          processing_state, parsing_status, width, assignment_target_type,
+          assignment_target_type == 3
+              ? s21_scan_wide_length(*temp_str, width)
+              : (int)s21_strnlen(*temp_str, width ? (s21_size_t)width : 1));
       break;
     case 'd':
     case 'u':
       s21_handle_int_conversion(temp_str, argument_pointer, result,
                                 missing_specs_count, processing_state,
-                                parsing_status, **temp_format, width,
+                                parsing_status, specifier, width,
                                 assignment_target_type, whitespace);
       break;
     case 'i':
@@ -123,7 +618,7 @@ int s21_handle_specifier(char **temp_str, char **temp_format,
     case 'X':
       s21_handle_base_conversion(temp_str, argument_pointer, result,
                                  missing_specs_count, processing_state,
-                                 parsing_status, **temp_format, width,
+                                 parsing_status, specifier, width,
                                  assignment_target_type, whitespace);
       break;
     case 'e':
@@ -133,14 +628,21 @@ int s21_handle_specifier(char **temp_str, char **temp_format,
     case 'f':
       s21_handle_float_conversion(temp_str, argument_pointer, result,
                                   missing_specs_count, processing_state,
-                                  parsing_status, **temp_format, width,
-                                  assignment_target_type, e, whitespace);
+                                  parsing_status, specifier, width,
+                                  assignment_target_type, whitespace);
       break;
     case 's':
       s21_handle_string_conversion(temp_str, argument_pointer, result,
                                    missing_specs_count, processing_state,
-                                   parsing_status, width, temp_result,
-                                   whitespace, lens);
+                                   parsing_status, width,
+                                   assignment_target_type, &s21_token_chars,
+                                   whitespace);
+      break;
+    case '[':
+      s21_handle_string_conversion(temp_str, argument_pointer, result,
+                                   missing_specs_count, processing_state,
+                                   parsing_status, width,
+                                   assignment_target_type, scan_set, s21_NULL);
       break;
     case 'p':
       s21_handle_pointer_conversion(temp_str, argument_pointer, result,
@@ -160,7 +662,6 @@ int s21_handle_specifier(char **temp_str, char **temp_format,
       *parsing_status = 1;
       break;
   }
-  if (**temp_format) (*temp_format)++;
   return *parsing_status;
 }
 /**
@@ -178,22 +679,36 @@ int s21_handle_specifier(char **temp_str, char **temp_format,
  * @param parsing_status A pointer to the variable indicating the parsing
  * status.
  * @param width The width specifier for formatting.
+ * @param assignment_target_type S21_SCAN_VIEW to store a strview_type of the
+ * characters read, 3 ('l') to decode them into wchar_t values.
  * @param s21_len The length of the current position in the input string
- * (*temp_str).
+ * (*temp_str), measured up to the width, or for 'l' the bytes of the
+ * characters to decode.
  */
-void s21_handle_char_conversion(char **temp_str, va_list argument_pointer,
+void s21_handle_char_conversion(char **temp_str, va_list *argument_pointer,
                                 int *result, int *missing_specs_count,
                                 int *processing_state, int *parsing_status,
-                                int width, int s21_len) {
-  if (*temp_str) {
+                                int width, int assignment_target_type,
+                                int s21_len) {
+  if (s21_len) {
     if (!(*missing_specs_count)) {
-      *va_arg(argument_pointer, char *) = **temp_str;
+      if (assignment_target_type == S21_SCAN_VIEW) {
+        *va_arg(*argument_pointer, strview_type *) =
+            s21_strview_n(*temp_str, s21_len);
+      } else if (assignment_target_type == 3) {
+        s21_utf8_decode_string(va_arg(*argument_pointer, wchar_t *), *temp_str,
+                               s21_len);
+      } else {
+        s21_memcpy(va_arg(*argument_pointer, char *), *temp_str, s21_len);
+      }
       (*result)++;
     } else {
       *missing_specs_count = 0;
       *processing_state = 2;
     }
-    if (width == 0)
+    if (assignment_target_type == 3)
+      (*temp_str) += s21_len;
+    else if (width == 0)
       (*temp_str) += 1;
     else if (width <= s21_len)
       (*temp_str) += width;
@@ -228,15 +743,17 @@ void s21_handle_char_conversion(char **temp_str, va_list argument_pointer,
  * @param assignment_target_type Integer used in conversion functions
  *                               `s21_assign_unsigned_result_by_width_specifier`
  * or `s21_assign_result_by_width_specifier`.
- * @param whitespace String of characters considered whitespace, used to skip
+ * @param whitespace Set of characters considered whitespace, used to skip
  * initial spaces.
  */
-void s21_handle_int_conversion(char **temp_str, va_list argument_pointer,
+void s21_handle_int_conversion(char **temp_str, va_list *argument_pointer,
                                int *result, int *missing_specs_count,
                                int *processing_state, int *parsing_status,
                                char specifier, int width,
-                               int assignment_target_type, char *whitespace) {
-  *temp_str += s21_strspn(*temp_str, whitespace);
+                               int assignment_target_type,
+                               const charset_type *whitespace) {
+  *temp_str += s21_charset_span(*temp_str, whitespace);
+  const char *start = *temp_str;  // a lone sign is a matching failure
   unsigned long long sum = s21_convert_string_to_unsigned_long_long(
       temp_str, width, parsing_status, specifier);
   if (!*parsing_status) {
@@ -253,7 +770,7 @@ void s21_handle_int_conversion(char **temp_str, va_list argument_pointer,
       *missing_specs_count = 0;
       *processing_state = 2;
     }
-  } else if (*processing_state && !**temp_str) {
+  } else if (*processing_state && !*start) {
     *result = -1;
     *processing_state = 0;
   }
@@ -271,13 +788,14 @@ void s21_handle_int_conversion(char **temp_str, va_list argument_pointer,
  * @param specifier Conversion specifier character ('i', 'o', 'x', 'X').
  * @param width Width specifier for parsing.
  * @param assignment_target_type Type specifier for assignment.
- * @param whitespace String containing whitespace characters to skip.
+ * @param whitespace Set of the whitespace characters to skip.
  */
-void s21_handle_base_conversion(char **temp_str, va_list argument_pointer,
+void s21_handle_base_conversion(char **temp_str, va_list *argument_pointer,
                                 int *result, int *missing_specs_count,
                                 int *processing_state, int *parsing_status,
                                 char specifier, int width,
-                                int assignment_target_type, char *whitespace) {
+                                int assignment_target_type,
+                               const charset_type *whitespace) {
   unsigned base = 0;
   if (specifier == 'i')
     base = 10;
@@ -285,7 +803,8 @@ void s21_handle_base_conversion(char **temp_str, va_list argument_pointer,
     base = 8;
   else
     base = 16;
-  *temp_str += s21_strspn(*temp_str, whitespace);
+  *temp_str += s21_charset_span(*temp_str, whitespace);
+  const char *start = *temp_str;  // a lone sign is a matching failure
   unsigned long long sum;
   if (specifier == 'i')
     sum =
@@ -307,7 +826,7 @@ void s21_handle_base_conversion(char **temp_str, va_list argument_pointer,
       *missing_specs_count = 0;
       *processing_state = 2;
     }
-  } else if (*processing_state && !**temp_str) {
+  } else if (*processing_state && !*start) {
     *result = -1;
     *processing_state = 0;
   }
@@ -316,6 +835,9 @@ void s21_handle_base_conversion(char **temp_str, va_list argument_pointer,
  * @brief Handles the floating-point conversion specifier ('f', 'F', 'e', 'E',
  * 'g', 'G') in a format string.
  *
+ * The number is rounded once, directly to the type of the target, so a float
+ * does not go through a double rounding.
+ *
  * @param temp_str Pointer to current position in the format string.
  * @param argument_pointer Pointer to va_list for variadic arguments.
  * @param result Pointer to result count.
@@ -326,19 +848,22 @@ void s21_handle_base_conversion(char **temp_str, va_list argument_pointer,
  * 'G').
  * @param width Width specifier for parsing.
  * @param assignment_target_type Type specifier for assignment.
- * @param e Flag indicating presence of exponent in format.
- * @param whitespace String containing whitespace characters to skip.
+ * @param whitespace Set of the whitespace characters to skip.
  */
-void s21_handle_float_conversion(char **temp_str, va_list argument_pointer,
+void s21_handle_float_conversion(char **temp_str, va_list *argument_pointer,
                                  int *result, int *missing_specs_count,
                                  int *processing_state, int *parsing_status,
                                  char specifier, int width,
-                                 int assignment_target_type, int e,
-                                 char *whitespace) {
+                                 int assignment_target_type,
+                                 const charset_type *whitespace) {
+  const float_format_type *format = &s21_float_format;
   (void)specifier;
-  *temp_str += s21_strspn(*temp_str, whitespace);
+  if (assignment_target_type == 3) format = &s21_double_format;
+  if (assignment_target_type == 5) format = &s21_long_double_format;
+  *temp_str += s21_charset_span(*temp_str, whitespace);
+  const char *start = *temp_str;  // a lone sign is a matching failure
   long double converted_float = s21_parse_string_to_long_double_with_exponent(
-      temp_str, width, parsing_status, e);
+      temp_str, width, parsing_status, format);
 
   if (!*parsing_status) {
     if (!*missing_specs_count) {
@@ -349,13 +874,17 @@ void s21_handle_float_conversion(char **temp_str, va_list argument_pointer,
       *missing_specs_count = 0;
       *processing_state = 2;
     }
-  } else if (*processing_state && !**temp_str) {
+  } else if (*processing_state && !*start) {
     *result = -1;
     *processing_state = 0;
   }
 }
 /**
- * @brief Handles the string conversion specifier ('s') in a format string.
+ * @brief Handles the string conversion specifiers ('s' and '[') in a format
+ * string.
+ *
+ * The token is measured in place and then copied once into the argument, or
+ * stored as a strview_type into the input with the 'v' modifier.
  *
  * @param temp_str Pointer to current position in the format string.
  * @param argument_pointer Pointer to va_list for variadic arguments.
@@ -364,28 +893,34 @@ void s21_handle_float_conversion(char **temp_str, va_list argument_pointer,
  * @param processing_state Pointer to processing state.
  * @param parsing_status Pointer to parsing status.
  * @param width Width specifier for parsing.
- * @param temp_result Buffer to store parsed string.
- * @param whitespace String containing whitespace characters to skip.
- * @param lens Length of parsed string.
+ * @param assignment_target_type See s21_store_token.
+ * @param token Set of the characters of the token.
+ * @param skip Set of the characters to skip before the token, s21_NULL to
+ * skip nothing.
  */
-void s21_handle_string_conversion(char **temp_str, va_list argument_pointer,
+void s21_handle_string_conversion(char **temp_str, va_list *argument_pointer,
                                   int *result, int *missing_specs_count,
                                   int *processing_state, int *parsing_status,
-                                  int width, char *temp_result,
-                                  char *whitespace, int lens) {
-  *temp_str += s21_strspn(*temp_str, whitespace);
-  s21_parse_and_copy(*temp_str, &lens, width, parsing_status, temp_result);
-  *temp_str += lens;
-  lens = 0;
+                                  int width, int assignment_target_type,
+                                  const charset_type *token,
+                                  const charset_type *skip) {
+  if (skip) *temp_str += s21_charset_span(*temp_str, skip);
+  int length = s21_scan_span(*temp_str, token, width);
+  if (assignment_target_type == 3 && width) {
+    length = (int)s21_utf8_boundary(*temp_str, length);
+  }
+  if (length == 0) *parsing_status = 1;
 
   if (!*parsing_status) {
     if (!*missing_specs_count) {
-      s21_strcpy(va_arg(argument_pointer, char *), temp_result);
+      s21_store_token(va_arg(*argument_pointer, void *), *temp_str, length,
+                      assignment_target_type);
       (*result)++;
     } else {
       *missing_specs_count = 0;
       *processing_state = 2;
     }
+    *temp_str += length;
   } else if (*processing_state && !**temp_str) {
     *result = -1;
     *processing_state = 0;
@@ -402,15 +937,15 @@ void s21_handle_string_conversion(char **temp_str, va_list argument_pointer,
  * @param parsing_status Pointer to parsing status.
  * @param width Width specifier for parsing.
  * @param assignment_target_type Type of assignment target.
- * @param whitespace String containing whitespace characters to skip.
+ * @param whitespace Set of the whitespace characters to skip.
  */
-void s21_handle_pointer_conversion(char **temp_str, va_list argument_pointer,
+void s21_handle_pointer_conversion(char **temp_str, va_list *argument_pointer,
                                    int *result, int *missing_specs_count,
                                    int *processing_state, int *parsing_status,
                                    int width, int assignment_target_type,
-                                   char *whitespace) {
+                                   const charset_type *whitespace) {
   unsigned base = 16;
-  *temp_str += s21_strspn(*temp_str, whitespace);
+  *temp_str += s21_charset_span(*temp_str, whitespace);
   unsigned long long sum = s21_convert_string_to_unsigned_long_long_base(
       temp_str, width, parsing_status, base);
 
@@ -439,7 +974,7 @@ void s21_handle_pointer_conversion(char **temp_str, va_list argument_pointer,
  * @param processing_state Pointer to processing state.
  * @param assignment_target_type Type of assignment target.
  */
-void s21_handle_n_conversion(char **temp_str, va_list argument_pointer,
+void s21_handle_n_conversion(char **temp_str, va_list *argument_pointer,
                              const char *str, int *missing_specs_count,
                              int *processing_state,
                              int assignment_target_type) {
@@ -458,11 +993,11 @@ void s21_handle_n_conversion(char **temp_str, va_list argument_pointer,
  * @param temp_str Pointer to current position in the format string.
  * @param parsing_status Pointer to integer storing parsing status (0: success,
  * 1: failure).
- * @param whitespace String containing characters considered as whitespace.
+ * @param whitespace Set of characters considered as whitespace.
  */
 void s21_handle_percent_conversion(char **temp_str, int *parsing_status,
-                                   char *whitespace) {
-  *temp_str += s21_strspn(*temp_str, whitespace);
+                                   const charset_type *whitespace) {
+  *temp_str += s21_charset_span(*temp_str, whitespace);
   if (**temp_str == '%')
     (*temp_str)++;
   else
@@ -471,6 +1006,9 @@ void s21_handle_percent_conversion(char **temp_str, int *parsing_status,
 /**
  * @brief Handles the length modifier in a format string.
  *
+ * "hh", "h", "l", "ll" and "L" give 1 to 5, the 'v' extension gives
+ * S21_SCAN_VIEW.
+ *
  * @param temp_format Pointer to current position in the format string.
  * @param assignment_target_type Pointer to integer storing the type based on
  * length modifier.
@@ -492,6 +1030,9 @@ void s21_handle_length_modifier(char **temp_format,
   } else if (**temp_format == 'L') {
     *assignment_target_type = 5;
     (*temp_format)++;
+  } else if (**temp_format == 'v') {
+    *assignment_target_type = S21_SCAN_VIEW;
+    (*temp_format)++;
   }
 }
 /**
@@ -499,19 +1040,20 @@ void s21_handle_length_modifier(char **temp_format,
  *
  * @param str Pointer to current position in the input string.
  * @param format Pointer to current position in the format string.
+ * @param whitespace Set of the input characters a format space skips.
  * @return Integer indicating parsing and matching status (0: success, 1:
  * failure).
  */
-int s21_parse_and_match(char **str, char **format) {
-  char whitespace[7] = " \f\n\r\t\v";
+int s21_parse_and_match(char **str, char **format,
+                        const charset_type *whitespace) {
   char del[8] = " \f\n\r\t\v\%";
   int parsing_status = 0;
   while ((**format && **format != 37) && !parsing_status) {
     int len = 0;
-    if (s21_strchr(whitespace, **format) != s21_NULL) {
-      len = (int)s21_strspn(*format, whitespace);
+    if (s21_charset_has(&s21_whitespace, (unsigned char)**format)) {
+      len = (int)s21_charset_span(*format, &s21_whitespace);
       *format += len;
-      len = (int)s21_strspn(*str, whitespace);
+      len = (int)s21_charset_span(*str, whitespace);
       *str += len;
     }
     len = (int)s21_strcspn(*format, del);
@@ -525,29 +1067,39 @@ int s21_parse_and_match(char **str, char **format) {
   return parsing_status;
 }
 /**
- * @brief Parses and copies a substring from `temp_str` into `temp_result`.
+ * @brief Measures the run of set members at the start of a string.
  *
- * @param temp_str Input string to parse from.
- * @param lens Pointer to an integer storing the length of copied substring.
- * @param width Maximum width of the substring to copy.
- * @param parsing_status Pointer to an integer indicating parsing success (0:
- * success, 1: failure).
- * @param temp_result Buffer to store the copied substring.
- * @return Pointer to `temp_result` containing the copied substring.
+ * @param str Input string to parse from.
+ * @param set Set of the characters of the run.
+ * @param width Maximum length of the run, 0: unlimited.
+ * @return Length of the run, it never covers the null character.
  */
-char *s21_parse_and_copy(char *temp_str, int *lens, int width,
-                         int *parsing_status, char *temp_result) {
-  char whitespace[7] = " \f\n\r\t\v";
-  int len = s21_strcspn(temp_str, whitespace);
-
+int s21_scan_span(const char *str, const charset_type *set, int width) {
+  const unsigned char *ptr = (const unsigned char *)str;
+  int length = 0;
   if (width == 0) width = INT_MAX;
-  int i = 0;
-  for (; *(temp_str + i) && i < len && i < width; i++, (*lens)++) {
-    *(temp_result + i) = *(temp_str + i);
+  while (length < width && ptr[length] && s21_charset_has(set, ptr[length])) {
+    length++;
+  }
+  return length;
+}
+/**
+ * @brief Measures the input of a %lc conversion.
+ *
+ * @param str Pointer to the input.
+ * @param width The field width in bytes, 0 for one character.
+ * @return The bytes of the whole UTF-8 characters within the width, or of one
+ * character when none fits, 0 at the end of the input.
+ */
+int s21_scan_wide_length(const char *str, int width) {
+  s21_size_t available =
+      s21_strnlen(str, width ? (s21_size_t)width : S21_UTF8_MAX);
+  s21_size_t length = width ? s21_utf8_boundary(str, available) : 0;
+  if (length == 0 && available) {
+    unsigned long code = 0;
+    length = s21_utf8_decode(str, available, &code);
   }
-  *(temp_result + i) = '\0';
-  if (i == 0) *parsing_status = 1;
-  return temp_result;
+  return (int)length;
 }
 /**
  * @brief Converts a sequence of s21_digits from a string to an integer based on
@@ -562,27 +1114,16 @@ char *s21_parse_and_copy(char *temp_str, int *lens, int width,
  */
 unsigned long long int s21_convert_string_to_unsigned_long_long(
     char **str, int width, int *parsing_status, int c) {
-  unsigned long long int result = 0;
-  int sign = 1, base = 10;
+  int sign = 1, count = 0, overflow = 0;
   if (width == 0) width = INT_MAX;
   s21_process_sign_character_in_input(str, &width, &sign);
-  int i = 0;
-  int full = 0;
-  for (; i < width && s21_digit(**str); (*str)++, i++) {
-    if (!full && ((c == 117 && result * base + (**str - 48) >= result) ||
-                  (c == 100 && result * base + (**str - 48) <= LONG_MAX)))
-      result = result * base + (**str - 48);
-    else if (!full) {
-      if (c == 117) {
-        result = ULONG_MAX;
-      } else if (c == 100) {
-        sign == 1 ? (result = LONG_MAX) : (result = LONG_MIN);
-      }
-      full = 1;
-    }
-  }
-  if (i == 0) *parsing_status = 1;
-  return full ? result : result * sign;
+  unsigned long long limit = c == 'u'    ? ULLONG_MAX
+                             : sign == 1 ? (unsigned long long)LLONG_MAX
+                                         : (unsigned long long)LLONG_MAX + 1;
+  unsigned long long result = s21_integer_scan(
+      (const char **)str, width, 10, limit, &count, &overflow);
+  if (count == 0) *parsing_status = 1;
+  return overflow && c == 'u' ? result : result * sign;
 }
 /**
  * @brief Converts a string to a long long integer based on a specified base.
@@ -597,8 +1138,7 @@ unsigned long long int s21_convert_string_to_unsigned_long_long(
  */
 long long int s21_convert_string_to_long_long(char **str, int width,
                                               int *parsing_status, int base) {
-  long long int result = 0;
-  int sign = 1, temp = 0;
+  int sign = 1, count = 0, overflow = 0;
 
   if (width == 0) width = INT_MAX;
   s21_process_sign_character_in_input(str, &width, &sign);
@@ -611,36 +1151,12 @@ long long int s21_convert_string_to_long_long(char **str, int width,
   else if (i == 2)
     base = 16;
 
-  int full = 0;
-  if (base != 16) {
-    for (; i < width && (**str >= 48 && **str <= 48 + base - 1);
-         (*str)++, i++) {
-      if (!full && result * base + (**str - 48) >= result)
-        result = result * base + (**str - 48);
-      else if (!full) {
-        sign == 1 ? (result = LONG_MAX) : (result = LONG_MIN);
-        full = 1;
-      }
-    }
-  } else {
-    for (; i < width && (s21_digit(**str) || s21_letter(**str));
-         (*str)++, i++) {
-      if (s21_digit(**str)) {
-        temp = (**str) - 48;
-      } else {
-        temp = (**str) % 32 + 9;
-      }
-
-      if (!full && result * base + temp >= result) {
-        result = result * base + temp;
-      } else if (!full) {
-        sign == 1 ? (result = LONG_MAX) : (result = LONG_MIN);
-        full = 1;
-      }
-    }
-  }
-  if (i == 0) *parsing_status = 1;
-  return full ? result : result * sign;
+  unsigned long long limit = sign == 1 ? (unsigned long long)LLONG_MAX
+                                       : (unsigned long long)LLONG_MAX + 1;
+  unsigned long long result = s21_integer_scan(
+      (const char **)str, width - i, base, limit, &count, &overflow);
+  if (i + count == 0) *parsing_status = 1;
+  return (long long int)(result * sign);
 }
 /**
  * @brief Converts a string to an unsigned long long integer based on a
@@ -656,8 +1172,7 @@ long long int s21_convert_string_to_long_long(char **str, int width,
  */
 unsigned long long int s21_convert_string_to_unsigned_long_long_base(
     char **str, int width, int *parsing_status, int base) {
-  unsigned long long int result = 0;
-  int sign = 1, temp = 0;
+  int sign = 1, count = 0, overflow = 0;
 
   if (width == 0) width = INT_MAX;
   s21_process_sign_character_in_input(str, &width, &sign);
@@ -670,149 +1185,42 @@ unsigned long long int s21_convert_string_to_unsigned_long_long_base(
   else if (i == 2)
     base = 16;
 
-  int full = 0;
+  unsigned long long result = s21_integer_scan(
+      (const char **)str, width - i, base, ULLONG_MAX, &count, &overflow);
+  if (i + count == 0) *parsing_status = 1;
 
-  if (base != 16) {
-    for (; i < width && (**str >= 48 && **str <= 48 + base - 1);
-         (*str)++, i++) {
-      if (!full && result * base + (**str - 48) >= result)
-        result = result * base + (**str - 48);
-      else if (!full) {
-        result = ULONG_MAX;
-        full = 1;
-      }
-    }
-  } else {
-    for (; i < width && (s21_digit(**str) || s21_letter(**str));
-         (*str)++, i++) {
-      if (s21_digit(**str)) {
-        temp = (**str) - 48;
-      } else {
-        temp = (**str) % 32 + 9;
-      }
-      if (!full && result * base + temp >= result) {
-        result = result * base + temp;
-      } else if (!full) {
-        result = ULONG_MAX;
-        full = 1;
-      }
-    }
-  }
-  if (i == 0) *parsing_status = 1;
-
-  return full ? result : result * sign;
+  return overflow ? result : result * sign;
 }
 /**
  * @brief Parses a string to a long double with exponent notation support.
  *
+ * Decimal and hexadecimal numbers are read by s21_float_scan and rounded by
+ * s21_float_convert to the nearest value of the target format.
+ *
  * @param str Pointer to the current position in the input string.
  * @param width Maximum width of the input string to parse.
  * @param parsing_status Pointer to an integer indicating parsing success (0:
  * success, 1: failure).
- * @param e Indicator for handling exponent notation (0: ignore, 1: handle).
- * @return Parsed long double value from the string.
+ * @param format Pointer to the format of the target type.
+ * @return Parsed value, exactly representable in the target type.
  */
-long double s21_parse_string_to_long_double_with_exponent(char **str, int width,
-                                                          int *parsing_status,
-                                                          int e) {
-  long double result = 0, del = 1;  // inf = 1.0/0.0, nan = 0.0/0.0;
-  int point = 0, sign = 1, base = 10, check = 0, temp = 0;
-  unsigned long long int p = 1;
+long double s21_parse_string_to_long_double_with_exponent(
+    char **str, int width, int *parsing_status,
+    const float_format_type *format) {
+  long double result = 0;
+  float_scan_type scan;
+  int sign = 1;
   if (width == 0) width = INT_MAX;
   s21_process_sign_character_in_input(str, &width, &sign);
-  check = s21_detect_and_handle_infinity_nan(str, &result, &width, &sign);
-  int i = 0;
-  if (!check) {
-    if (**str == '0' && width > 0) {
-      i = 1;
-      (*str)++;
-      if (s21_is_x(**str) && width - i > 0) {
-        i = 2;
-        base = 16;
-        e = 0;
-        if (width - i > 0 &&
-            (s21_letter(*(*str + 1)) || s21_digit(*(*str + 1)))) {
-          (*str)++;
-        } else if (width - i > 0 && *(*str + 1) == 46) {
-          point = 1, i = 3;
-          if (width - i > 0 &&
-              (s21_letter(*(*str + 2)) || s21_digit(*(*str + 2))))
-            (*str) += 2;
-        }
-      }
-    }
-    for (; i < width && (e == 0 || (e == 1 && !s21_is_e(**str))) &&
-           (((s21_digit(**str)) || (s21_letter(**str) && base == 16)) ||
-            (**str == 46 && point == 0));
-         i++, (*str)++) {
-      if (point < 2) {
-        if (**str != '.') {
-          if (s21_digit(**str)) {
-            temp = (**str) - 48;
-          } else {
-            temp = (**str) % 32 + 9;
-          }
-          result = result * base + temp;
-          if (point == 1) del *= base;
-        } else {
-          point++;
-        }
-      }
-    }
-    result /= del;
-    result *= sign;
-    if (point == 1 && i == 1) *parsing_status = 1;
-    if (i < width && s21_is_e(**str)) {
-      s21_handle_exponent(str, &width, &result, &i, &sign, &p);
+  if (!s21_detect_and_handle_infinity_nan(str, &result, &width, &sign)) {
+    if (s21_float_scan((const char **)str, width, &scan)) {
+      result = sign * s21_float_convert(&scan, format);
+    } else {
+      *parsing_status = 1;
     }
-    if (i == 0 && check == 0) *parsing_status = 1;
   }
   return result;
 }
-/**
- * @brief Handles exponent notation in a string and adjusts a long double
- * result.
- *
- * @param str Pointer to current position in the input string, may be updated to
- * skip patterns.
- * @param width Pointer to remaining width of the input string to process,
- * restricting pattern length.
- * @param result Pointer to a long double to be adjusted based on the exponent.
- * @param i Pointer to an integer tracking the current position in the string.
- * @param sign Pointer to the sign of the exponent: -1 if negative, 0 if none, 1
- * if positive.
- * @param p Pointer to an unsigned long long storing the exponent value.
- */
-void s21_handle_exponent(char **str, int *width, long double *result, int *i,
-                         int *sign, unsigned long long int *p) {
-  if (((*(*str + 1) == 43 || *(*str + 1) == 45) && s21_digit(*(*str + 2)) &&
-       *i + 2 < *width) ||
-      (*i + 1 < *width && s21_digit(*(*str + 1)))) {
-    (*str)++, (*i)++;  // исправлено: использование результата инкремента
-    *sign = 0;
-    s21_process_sign_character_in_input(str, width, sign);
-    if (*sign != 0)
-      (*i)++;
-    else
-      *sign = 1;
-
-    *p = 0;
-    for (; *i < *width && s21_digit(**str); (*str)++, (*i)++) {
-      *p = *p * 10 + (**str - 48);
-    }
-    for (; *p > 0;
-         (*p)--) {  // исправлено: использование результата выражения *p--
-      if (*sign == -1) {
-        *result /= 10;
-        if (*result == 0) *p = 1;
-      } else {
-        *result *= 10;
-        if (isinf(*result)) *p = 1;
-        if (*result == 0) *p = 1;
-      }
-    }
-  }
-}
 /**
  * @brief Formats and assigns a long double result to various floating-point
  * types.
@@ -824,16 +1232,16 @@ void s21_handle_exponent(char **str, int *width, long double *result, int *i,
  * type
  */
 void s21_format_long_double_result_with_width(long double *result,
-                                              va_list argument_pointer,
+                                              va_list *argument_pointer,
                                               int *assignment_target_type) {
   if (*assignment_target_type == 0 || *assignment_target_type == 2) {
-    *va_arg(argument_pointer, float *) = (float)*result;
+    *va_arg(*argument_pointer, float *) = (float)*result;
   } else if (*assignment_target_type == 3) {
-    *va_arg(argument_pointer, double *) = (double)*result;
+    *va_arg(*argument_pointer, double *) = (double)*result;
   } else if (*assignment_target_type == 4) {
-    va_arg(argument_pointer, float *);
+    va_arg(*argument_pointer, float *);
   } else if (*assignment_target_type == 5) {
-    *va_arg(argument_pointer, long double *) = *result;
+    *va_arg(*argument_pointer, long double *) = *result;
   }
   *assignment_target_type = 0;
 }
@@ -847,18 +1255,18 @@ void s21_format_long_double_result_with_width(long double *result,
  * type:
  */
 void s21_assign_result_by_width_specifier(unsigned long long int *result,
-                                          va_list argument_pointer,
+                                          va_list *argument_pointer,
                                           int *assignment_target_type) {
   if (*assignment_target_type == 0) {
-    *va_arg(argument_pointer, int *) = (int)*result;
+    *va_arg(*argument_pointer, int *) = (int)*result;
   } else if (*assignment_target_type == 1) {
-    *va_arg(argument_pointer, char *) = (char)*result;
+    *va_arg(*argument_pointer, char *) = (char)*result;
   } else if (*assignment_target_type == 2) {
-    *va_arg(argument_pointer, short int *) = (short int)*result;
+    *va_arg(*argument_pointer, short int *) = (short int)*result;
   } else if (*assignment_target_type == 3) {
-    *va_arg(argument_pointer, long int *) = (long int)*result;
+    *va_arg(*argument_pointer, long int *) = (long int)*result;
   } else if (*assignment_target_type == 4) {
-    *va_arg(argument_pointer, long long int *) = (long long int)*result;
+    *va_arg(*argument_pointer, long long int *) = (long long int)*result;
   }
   *assignment_target_type = 0;
 }
@@ -872,19 +1280,20 @@ void s21_assign_result_by_width_specifier(unsigned long long int *result,
  * type:
  */
 void s21_assign_unsigned_result_by_width_specifier(
-    unsigned long long int *result, va_list argument_pointer,
+    unsigned long long int *result, va_list *argument_pointer,
     int *assignment_target_type) {
   if (*assignment_target_type == 0) {
-    *va_arg(argument_pointer, unsigned int *) = (unsigned int)*result;
+    *va_arg(*argument_pointer, unsigned int *) = (unsigned int)*result;
   } else if (*assignment_target_type == 1) {
-    *va_arg(argument_pointer, unsigned char *) = (unsigned char)*result;
+    *va_arg(*argument_pointer, unsigned char *) = (unsigned char)*result;
   } else if (*assignment_target_type == 2) {
-    *va_arg(argument_pointer, unsigned short int *) =
+    *va_arg(*argument_pointer, unsigned short int *) =
         (unsigned short int)*result;
   } else if (*assignment_target_type == 3) {
-    *va_arg(argument_pointer, unsigned long int *) = (unsigned long int)*result;
+    *va_arg(*argument_pointer, unsigned long int *) =
+        (unsigned long int)*result;
   } else if (*assignment_target_type == 4) {
-    *va_arg(argument_pointer, unsigned long long int *) =
+    *va_arg(*argument_pointer, unsigned long long int *) =
         (unsigned long long int)*result;
   }
   *assignment_target_type = 0;
@@ -909,7 +1318,7 @@ int s21_detect_and_handle_infinity_nan(char **str, long double *res, int *width,
   s21_str_tolower(temp);
 
   if (*width > 2 && !s21_strncmp(temp, "nan", 3)) {
-    *res = 0.0 / 0.0;
+    *res = NAN;  // 0.0 / 0.0 is a negative NaN on x86
     *str += 3;
     *width -= 3;
   } else if (*width > 7 && !s21_strncmp(temp, "infinity", 8)) {
@@ -923,7 +1332,7 @@ int s21_detect_and_handle_infinity_nan(char **str, long double *res, int *width,
   } else {
     check = 0;
   }
-  if (check) *res *= *sign;
+  if (check && *sign < 0) *res = -*res;
 
   return check;
 }
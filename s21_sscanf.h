@@ -23,28 +23,121 @@
 #define SRC_S21_SSCANF_H_
 
 #include "s21_string.h"
+#include "s21_strtod.h"
+#include "s21_utf8.h"
+
+#define S21_SCAN_PLAN_MAX_STEPS 32
+// assignment_target_type of the 'v' modifier: %vs, %vc and %v[...] store a
+// strview_type into the input instead of copying the characters
+#define S21_SCAN_VIEW 6
+
+typedef struct scan_step {
+  const char *literal;         // format text matched before the conversion
+  int suppress;                // 1 when the conversion is marked with '*'
+  int width;                   // 0: undefined
+  int assignment_target_type;  // see s21_handle_length_modifier
+  char specifier;              // '\0' when the step is a bare literal
+  charset_type set;            // the characters of a '[' conversion
+} scan_step_type;
+
+typedef struct scan_plan {
+  int steps_count;
+  scan_step_type steps[S21_SCAN_PLAN_MAX_STEPS];
+} scan_plan_type;
+
+typedef struct scan_column {
+  void *data;         // the element of the first record
+  s21_size_t stride;  // bytes between records, 0: the size of the target,
+                      // must be set for %s and %[ without 'v'
+} scan_column_type;
+
+typedef struct scan_state {
+  char *temp_str;  // current position in the input string
+  int result;
+  int parsing_status;
+  int processing_state;
+  int missing_specs_count;
+} scan_state_type;
+
+// __Plans__
+int s21_compile_scan_format(scan_plan_type *plan, const char *format);
+int s21_sscanf_plan(const char *str, const scan_plan_type *plan, ...);
+void s21_parse_scan_step(char **temp_format, scan_step_type *step);
+void s21_parse_scan_set(char **temp_format, charset_type *set);
+void s21_execute_scan_step(scan_state_type *state, const scan_step_type *step,
+                           va_list *argument_pointer, const char *str);
+void s21_match_scan_literal(scan_state_type *state,
+                            const scan_step_type *step);
+void s21_convert_scan_step(scan_state_type *state, const scan_step_type *step,
+                           va_list *argument_pointer, const char *str);
+
+// __Batches__
+int s21_sscanf_batch(const char *input, const char *format,
+                     const scan_column_type *columns, int *status, int rows,
+                     const char **end);
+void s21_scan_batch_strides(const scan_plan_type *plan,
+                            const scan_column_type *columns,
+                            s21_size_t *strides);
+int s21_scan_batch_record(const scan_plan_type *plan, const char *record,
+                          const char *record_end,
+                          const scan_column_type *columns,
+                          const s21_size_t *strides, int row);
+int s21_scan_batch_field(char **temp_str, const char *record_end,
+                         const scan_step_type *step, void *target,
+                         const char *record);
+int s21_scan_step_assigns(const scan_step_type *step);
+s21_size_t s21_scan_target_size(const scan_step_type *step);
+void s21_store_integer(void *target, unsigned long long value,
+                       int assignment_target_type);
+void s21_store_float(void *target, long double value,
+                     int assignment_target_type);
+void s21_store_token(void *target, const char *token, s21_size_t length,
+                     int assignment_target_type);
+
+// __Sources__
+#define S21_SCANNER_CHUNK 65536  // room for every read of a source
+int s21_scanner_reserve(scanner_type *scanner, s21_size_t room);
+void s21_scanner_compact(scanner_type *scanner);
+long s21_scanner_fill(scanner_type *scanner);
+int s21_scanner_ensure(scanner_type *scanner, s21_size_t offset);
+long s21_file_read(void *context, char *span, s21_size_t size);
+long s21_fd_read(void *context, char *span, s21_size_t size);
+int s21_stream_getc(scanner_type *scanner, FILE *stream);
+int s21_stream_literal(scanner_type *scanner, FILE *stream,
+                       const char *literal);
+int s21_stream_token(scanner_type *scanner, FILE *stream,
+                     const scan_step_type *step);
+s21_size_t s21_stream_unread(scanner_type *scanner, FILE *stream,
+                             int lookahead);
+int s21_stream_viable(const scan_step_type *step, const char *token,
+                      s21_size_t length);
+int s21_integer_prefix(const char *token, s21_size_t length, int base);
+int s21_float_prefix(const char *token, s21_size_t length);
+int s21_word_prefix(const char *token, s21_size_t length, const char *word);
 
 // __Parsing functions__
-int s21_parse_and_match(char **str, char **format);
+int s21_parse_and_match(char **str, char **format,
+                        const charset_type *whitespace);
 unsigned long long int s21_convert_string_to_unsigned_long_long(char **, int,
                                                                 int *, int);
 long long int s21_convert_string_to_long_long(char **, int, int *, int);
 unsigned long long int s21_convert_string_to_unsigned_long_long_base(char **,
                                                                      int, int *,
                                                                      int);
-long double s21_parse_string_to_long_double_with_exponent(char **, int, int *,
-                                                          int);
-char *s21_parse_and_copy(char *temp_str, int *lens, int width,
-                         int *parsing_status, char *temp_result);
+long double s21_parse_string_to_long_double_with_exponent(
+    char **str, int width, int *parsing_status,
+    const float_format_type *format);
+int s21_scan_span(const char *str, const charset_type *set, int width);
+int s21_scan_wide_length(const char *str, int width);
 // Assignment functions
 void s21_assign_result_by_width_specifier(unsigned long long int *result,
-                                          va_list argument_pointer,
+                                          va_list *argument_pointer,
                                           int *assignment_target_type);
 void s21_assign_unsigned_result_by_width_specifier(
-    unsigned long long int *result, va_list argument_pointer,
+    unsigned long long int *result, va_list *argument_pointer,
     int *assignment_target_type);
 void s21_format_long_double_result_with_width(long double *result,
-                                              va_list argument_pointer,
+                                              va_list *argument_pointer,
                                               int *assignment_target_type);
 // Processing functions
 void s21_process_sign_character_in_input(char **str, int *width, int *sign);
@@ -62,47 +155,50 @@ void s21_parse_and_handle_base(char **, int *i, int width, int base);
 void s21_handle_length_modifier(char **temp_format,
                                 int *assignment_target_type);
 // Conversion specifier handling functions
-void s21_handle_char_conversion(char **temp_str, va_list argument_pointer,
+void s21_handle_char_conversion(char **temp_str, va_list *argument_pointer,
                                 int *result, int *missing_specs_count,
                                 int *processing_state, int *parsing_status,
-                                int width, int s21_len);
-void s21_handle_int_conversion(char **temp_str, va_list argument_pointer,
+                                int width, int assignment_target_type,
+                                int s21_len);
+void s21_handle_int_conversion(char **temp_str, va_list *argument_pointer,
                                int *result, int *missing_specs_count,
                                int *processing_state, int *parsing_status,
                                char specifier, int width,
-                               int assignment_target_type, char *whitespace);
-void s21_handle_base_conversion(char **temp_str, va_list argument_pointer,
+                               int assignment_target_type,
+                               const charset_type *whitespace);
+void s21_handle_base_conversion(char **temp_str, va_list *argument_pointer,
                                 int *result, int *missing_specs_count,
                                 int *processing_state, int *parsing_status,
                                 char specifier, int width,
-                                int assignment_target_type, char *whitespace);
-void s21_handle_float_conversion(char **temp_str, va_list argument_pointer,
+                                int assignment_target_type,
+                               const charset_type *whitespace);
+void s21_handle_float_conversion(char **temp_str, va_list *argument_pointer,
                                  int *result, int *missing_specs_count,
                                  int *processing_state, int *parsing_status,
                                  char specifier, int width,
-                                 int assignment_target_type, int e,
-                                 char *whitespace);
-void s21_handle_string_conversion(char **temp_str, va_list argument_pointer,
+                                 int assignment_target_type,
+                                 const charset_type *whitespace);
+void s21_handle_string_conversion(char **temp_str, va_list *argument_pointer,
                                   int *result, int *missing_specs_count,
                                   int *processing_state, int *parsing_status,
-                                  int width, char *temp_result,
-                                  char *whitespace, int lens);
-void s21_handle_pointer_conversion(char **temp_str, va_list argument_pointer,
+                                  int width, int assignment_target_type,
+                                  const charset_type *token,
+                                  const charset_type *skip);
+void s21_handle_pointer_conversion(char **temp_str, va_list *argument_pointer,
                                    int *result, int *missing_specs_count,
                                    int *processing_state, int *parsing_status,
                                    int width, int assignment_target_type,
-                                   char *whitespace);
-void s21_handle_n_conversion(char **temp_str, va_list argument_pointer,
+                                   const charset_type *whitespace);
+void s21_handle_n_conversion(char **temp_str, va_list *argument_pointer,
                              const char *str, int *missing_specs_count,
                              int *processing_state, int assignment_target_type);
 void s21_handle_percent_conversion(char **temp_str, int *parsing_status,
-                                   char *whitespace);
-int s21_handle_specifier(char **temp_str, char **temp_format,
-                         va_list argument_pointer, int *result,
+                                   const charset_type *whitespace);
+int s21_handle_specifier(char **temp_str, char specifier,
+                         va_list *argument_pointer, int *result,
                          int *missing_specs_count, int *processing_state,
                          int *parsing_status, int width,
-                         int assignment_target_type, char *whitespace,
-                         const char *str);
-void s21_handle_exponent(char **str, int *width, long double *result, int *i,
-                         int *sign, unsigned long long int *p);
+                         int assignment_target_type,
+                         const charset_type *scan_set,
+                         const charset_type *whitespace, const char *str);
 #endif  //  SRC_S21_SSCANF_H_
\ No newline at end of file
@@ -14,6 +14,9 @@
  * on test failures including line numbers, expected versus actual values, and
  * specific failure conditions.
  */
+#define _POSIX_C_SOURCE 200809L
+
+#include <unistd.h>
 
 #include "s21_tests.h"
 
@@ -3499,6 +3502,600 @@ START_TEST(additional) {
 }
 END_TEST
 
+START_TEST(sscanf_plan_reuse) {
+  const char *inputs[] = {"12 abc 3.5 ff", "-7 x 1e3 10", "  42\tword -0.25 Z",
+                          "8", ""};
+  const char fstr[] = "%hd %5s %lf %x";
+  scan_plan_type plan;
+  ck_assert_int_eq(s21_compile_scan_format(&plan, fstr), 0);
+  for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); ++i) {
+    short a1 = 0, a2 = 0;
+    char s1[BUFFERSIZE] = {0}, s2[BUFFERSIZE] = {0};
+    double d1 = 0, d2 = 0;
+    unsigned x1 = 0, x2 = 0;
+    int res1 = s21_sscanf_plan(inputs[i], &plan, &a1, s1, &d1, &x1);
+    int res2 = sscanf(inputs[i], fstr, &a2, s2, &d2, &x2);
+    ck_assert_int_eq(res1, res2);
+    ck_assert_int_eq(a1, a2);
+    ck_assert_str_eq(s1, s2);
+    ck_assert_double_eq(d1, d2);
+    ck_assert_uint_eq(x1, x2);
+  }
+}
+END_TEST
+
+START_TEST(sscanf_plan_literals) {
+  const char str[] = "key=15;skip=99;n";
+  const char fstr[] = "key=%d;skip=%*d;%c%n";
+  scan_plan_type plan;
+  int a1 = 0, a2 = 0, n1 = 0, n2 = 0;
+  char c1 = 0, c2 = 0;
+  ck_assert_int_eq(s21_compile_scan_format(&plan, fstr), 0);
+  int res1 = s21_sscanf_plan(str, &plan, &a1, &c1, &n1);
+  int res2 = sscanf(str, fstr, &a2, &c2, &n2);
+  ck_assert_int_eq(res1, res2);
+  ck_assert_int_eq(a1, a2);
+  ck_assert_int_eq(c1, c2);
+  ck_assert_int_eq(n1, n2);
+}
+END_TEST
+
+START_TEST(sscanf_plan_limits) {
+  char fstr[S21_SCAN_PLAN_MAX_STEPS * 2 + 2] = {0};
+  scan_plan_type plan;
+  int a = 0;
+  ck_assert_int_eq(s21_compile_scan_format(&plan, ""), 0);
+  ck_assert_int_eq(s21_sscanf_plan("1", &plan, &a), 0);
+  for (int i = 0; i < S21_SCAN_PLAN_MAX_STEPS; ++i) {
+    fstr[2 * i] = '%';
+    fstr[2 * i + 1] = 'c';
+  }
+  ck_assert_int_eq(s21_compile_scan_format(&plan, fstr), 0);
+  fstr[2 * S21_SCAN_PLAN_MAX_STEPS] = '!';
+  ck_assert_int_eq(s21_compile_scan_format(&plan, fstr), 1);
+}
+END_TEST
+
+START_TEST(sscanf_float_correct_rounding) {
+  const char *inputs[] = {
+      "0.1",
+      "2.2250738585072011e-308",
+      "1.7976931348623157e308",
+      "4.9e-324",
+      "9007199254740993",
+      "0.30000000000000004441",
+      "1.00000000000000011102230246251565404236316680908203125",
+      "1.00000000000000011102230246251565404236316680908203126",
+      "123456789012345678901234567890e-30",
+      "7.038531e-26",
+      "1e400",
+      "1e-400",
+  };
+  for (int i = 0; i < (int)(sizeof(inputs) / sizeof(inputs[0])); ++i) {
+    double d1 = 0, d2 = 0;
+    float f1 = 0, f2 = 0;
+    ck_assert_int_eq(s21_sscanf(inputs[i], "%lf", &d1),
+                     sscanf(inputs[i], "%lf", &d2));
+    ck_assert_int_eq(s21_sscanf(inputs[i], "%f", &f1),
+                     sscanf(inputs[i], "%f", &f2));
+    ck_assert_double_eq(d1, d2);
+    ck_assert_float_eq(f1, f2);
+  }
+}
+END_TEST
+
+START_TEST(sscanf_float_ties) {
+  char fstr[] = "%f %f %lf %lf";
+  char str[] =
+      "1.000000059604644775390625 1.000000059604644775390626 "
+      "9007199254740993 9007199254740995";
+  float a1 = 0, a2 = 0, b1 = 0, b2 = 0;
+  double c1 = 0, c2 = 0, d1 = 0, d2 = 0;
+  int res1 = s21_sscanf(str, fstr, &a1, &b1, &c1, &d1);
+  int res2 = sscanf(str, fstr, &a2, &b2, &c2, &d2);
+  ck_assert_int_eq(res1, res2);
+  ck_assert_float_eq(a1, a2);
+  ck_assert_float_eq(b1, b2);
+  ck_assert_double_eq(c1, c2);
+  ck_assert_double_eq(d1, d2);
+}
+END_TEST
+
+START_TEST(sscanf_float_long_double) {
+  char fstr[] = "%Lf %Lf %Lf %Lf %Lf";
+  char str[] =
+      "0.1 3.14159265358979323846264338327950288 1e-4950 "
+      "1.18973149535723176502e+4932 -2.5e-310";
+  long double a1 = 0, a2 = 0, b1 = 0, b2 = 0, c1 = 0, c2 = 0, d1 = 0, d2 = 0;
+  long double e1 = 0, e2 = 0;
+  int res1 = s21_sscanf(str, fstr, &a1, &b1, &c1, &d1, &e1);
+  int res2 = sscanf(str, fstr, &a2, &b2, &c2, &d2, &e2);
+  ck_assert_int_eq(res1, res2);
+  ck_assert_ldouble_eq(a1, a2);
+  ck_assert_ldouble_eq(b1, b2);
+  ck_assert_ldouble_eq(c1, c2);
+  ck_assert_ldouble_eq(d1, d2);
+  ck_assert_ldouble_eq(e1, e2);
+}
+END_TEST
+
+START_TEST(sscanf_float_many_digits) {
+  char str[820] = "0.";
+  double d1 = 0, d2 = 0;
+  long double l1 = 0, l2 = 0;
+  int n1 = 0, n2 = 0;
+  for (int i = 2; i < 810; ++i) str[i] = (char)('0' + (i * 7) % 10);
+  ck_assert_int_eq(s21_sscanf(str, "%lf%n", &d1, &n1),
+                   sscanf(str, "%lf%n", &d2, &n2));
+  ck_assert_int_eq(n1, n2);
+  ck_assert_double_eq(d1, d2);
+  ck_assert_int_eq(s21_sscanf(str, "%Lf", &l1), sscanf(str, "%Lf", &l2));
+  ck_assert_ldouble_eq(l1, l2);
+}
+END_TEST
+
+START_TEST(sscanf_float_hex) {
+  char fstr[] = "%lf %f %Lf %lf %lf%n";
+  char str[] = "0x1.8p3 -0X.8p-1 0x1.fffffffffffff8p0 0x1P+4 0xAbC.dE";
+  double a1 = 0, a2 = 0, d1 = 0, d2 = 0, e1 = 0, e2 = 0;
+  float b1 = 0, b2 = 0;
+  long double c1 = 0, c2 = 0;
+  int n1 = 0, n2 = 0;
+  int res1 = s21_sscanf(str, fstr, &a1, &b1, &c1, &d1, &e1, &n1);
+  int res2 = sscanf(str, fstr, &a2, &b2, &c2, &d2, &e2, &n2);
+  ck_assert_int_eq(res1, res2);
+  ck_assert_int_eq(n1, n2);
+  ck_assert_double_eq(a1, a2);
+  ck_assert_float_eq(b1, b2);
+  ck_assert_ldouble_eq(c1, c2);
+  ck_assert_double_eq(d1, d2);
+  ck_assert_double_eq(e1, e2);
+}
+END_TEST
+
+START_TEST(sscanf_float_hex_long_mantissa) {
+  char fstr[] = "%Lf %Le %Lf %Le %lf%n";
+  char str[] =
+      "0x6Abe8EFFaD8cFeaB0.Fp-5 -0xD432CCB1aFacaa552.B "
+      "0x1.fffffffffffffffF8000000001 0xFFFFFFFFFFFFFFFF.8 "
+      "0x1fffffffffffff.F0000000000001p-3";
+  long double a1 = 0, a2 = 0, b1 = 0, b2 = 0, c1 = 0, c2 = 0, d1 = 0, d2 = 0;
+  double e1 = 0, e2 = 0;
+  int n1 = 0, n2 = 0;
+  int res1 = s21_sscanf(str, fstr, &a1, &b1, &c1, &d1, &e1, &n1);
+  int res2 = sscanf(str, fstr, &a2, &b2, &c2, &d2, &e2, &n2);
+  ck_assert_int_eq(res1, res2);
+  ck_assert_int_eq(n1, n2);
+  ck_assert_ldouble_eq(a1, a2);
+  ck_assert_ldouble_eq(b1, b2);
+  ck_assert_ldouble_eq(c1, c2);
+  ck_assert_ldouble_eq(d1, d2);
+  ck_assert_double_eq(e1, e2);
+}
+END_TEST
+
+START_TEST(sscanf_float_width) {
+  char fstr[] = "%4lf%3lf%5f";
+  char str[] = "12e34567.891";
+  double a1 = 0, a2 = 0, b1 = 0, b2 = 0;
+  float c1 = 0, c2 = 0;
+  int res1 = s21_sscanf(str, fstr, &a1, &b1, &c1);
+  int res2 = sscanf(str, fstr, &a2, &b2, &c2);
+  ck_assert_int_eq(res1, res2);
+  ck_assert_double_eq(a1, a2);
+  ck_assert_double_eq(b1, b2);
+  ck_assert_float_eq(c1, c2);
+}
+END_TEST
+
+START_TEST(sscanf_int_long_digits) {
+  char fstr[] = "%lld %llu %llx %llo %lli %lli";
+  char str[] =
+      "-000000000000000000009223372036854775808 18446744073709551615 "
+      "00000000DeadBeefCafeF00d 1777777777777777777777 0x7fffffffffffffff "
+      "-0777777777777777777777";
+  long long a1 = 0, a2 = 0, e1 = 0, e2 = 0, f1 = 0, f2 = 0;
+  unsigned long long b1 = 0, b2 = 0, c1 = 0, c2 = 0, d1 = 0, d2 = 0;
+  int res1 = s21_sscanf(str, fstr, &a1, &b1, &c1, &d1, &e1, &f1);
+  int res2 = sscanf(str, fstr, &a2, &b2, &c2, &d2, &e2, &f2);
+  ck_assert_int_eq(res1, res2);
+  ck_assert_int_eq(a1, a2);
+  ck_assert_uint_eq(b1, b2);
+  ck_assert_uint_eq(c1, c2);
+  ck_assert_uint_eq(d1, d2);
+  ck_assert_int_eq(e1, e2);
+  ck_assert_int_eq(f1, f2);
+}
+END_TEST
+
+START_TEST(sscanf_int_overflow) {
+  char fstr[] = "%lld %lld %llu %llx %lli %llo";
+  char str[] =
+      "92233720368547758070 -92233720368547758090 184467440737095516150 "
+      "123456789abcdef01 -0x80000000000000001 2000000000000000000000";
+  long long a1 = 0, a2 = 0, b1 = 0, b2 = 0, e1 = 0, e2 = 0;
+  unsigned long long c1 = 0, c2 = 0, d1 = 0, d2 = 0, f1 = 0, f2 = 0;
+  int res1 = s21_sscanf(str, fstr, &a1, &b1, &c1, &d1, &e1, &f1);
+  int res2 = sscanf(str, fstr, &a2, &b2, &c2, &d2, &e2, &f2);
+  ck_assert_int_eq(res1, res2);
+  ck_assert_int_eq(a1, a2);
+  ck_assert_int_eq(b1, b2);
+  ck_assert_uint_eq(c1, c2);
+  ck_assert_uint_eq(d1, d2);
+  ck_assert_int_eq(e1, e2);
+  ck_assert_uint_eq(f1, f2);
+}
+END_TEST
+
+START_TEST(sscanf_int_width_blocks) {
+  char fstr[] = "%9d%7x%10llu%3o%n";
+  char str[] = "1234567890abcdef12345678901234567";
+  int a1 = 0, a2 = 0, n1 = 0, n2 = 0;
+  unsigned b1 = 0, b2 = 0, d1 = 0, d2 = 0;
+  unsigned long long c1 = 0, c2 = 0;
+  int res1 = s21_sscanf(str, fstr, &a1, &b1, &c1, &d1, &n1);
+  int res2 = sscanf(str, fstr, &a2, &b2, &c2, &d2, &n2);
+  ck_assert_int_eq(res1, res2);
+  ck_assert_int_eq(a1, a2);
+  ck_assert_uint_eq(b1, b2);
+  ck_assert_uint_eq(c1, c2);
+  ck_assert_uint_eq(d1, d2);
+  ck_assert_int_eq(n1, n2);
+}
+END_TEST
+
+START_TEST(sscanf_batch_columns) {
+  const char input[] =
+      "1,2.5,alpha\n"
+      "-20,  1e3,beta\n"
+      "300,0x1p-2,gamma\n";
+  int ids[3] = {0};
+  double values[3] = {0};
+  char names[3][8] = {{0}};
+  int status[3] = {0};
+  scan_column_type columns[] = {
+      {ids, 0}, {values, 0}, {names, sizeof(names[0])}};
+  const char *end = s21_NULL;
+  int rows = s21_sscanf_batch(input, "%d,%lf,%7s", columns, status, 3, &end);
+  ck_assert_int_eq(rows, 3);
+  ck_assert_ptr_eq(end, input + sizeof(input) - 1);
+  for (int i = 0; i < 3; i++) {
+    int id = 0;
+    double value = 0;
+    char name[8] = {0};
+    const char *line = input;
+    for (int j = 0; j < i; j++) line = s21_strchr(line, '\n') + 1;
+    ck_assert_int_eq(status[i], sscanf(line, "%d,%lf,%7s", &id, &value, name));
+    ck_assert_int_eq(ids[i], id);
+    ck_assert_double_eq(values[i], value);
+    ck_assert_str_eq(names[i], name);
+  }
+}
+END_TEST
+
+START_TEST(sscanf_batch_status) {
+  const char input[] = "7 x 12\n\n8 y\nz 9 1\n5 w 6";
+  short first[5] = {0};
+  char letters[5] = {0};
+  long last[5] = {0};
+  int lengths[5] = {0};
+  int status[5] = {0};
+  scan_column_type columns[] = {
+      {first, 0}, {letters, 0}, {last, 0}, {lengths, 0}};
+  int rows = s21_sscanf_batch(input, "%hd %c%*c%ld%n", columns, status, 4,
+                              s21_NULL);
+  ck_assert_int_eq(rows, 4);
+  ck_assert_int_eq(status[0], 3);
+  ck_assert_int_eq(status[1], -1);
+  ck_assert_int_eq(status[2], 2);
+  ck_assert_int_eq(status[3], 0);
+  ck_assert_int_eq(status[4], 0);
+  ck_assert_int_eq(first[0], 7);
+  ck_assert_int_eq(letters[0], 'x');
+  ck_assert_int_eq(last[0], 12);
+  ck_assert_int_eq(lengths[0], 6);
+  ck_assert_int_eq(first[2], 8);
+  ck_assert_int_eq(letters[2], 'y');
+  ck_assert_int_eq(last[2], 0);
+  ck_assert_int_eq(s21_sscanf_batch(input, "%d", columns, status, 0, s21_NULL),
+                   0);
+}
+END_TEST
+
+START_TEST(sscanf_scan_set) {
+  const char *formats[] = {"%[a-z]%d",   "%3[0-9]%s",  "%[^,],%[^\n]",
+                           "%[]a]%s",    "%[^]x]%s",   "%*[ a-c]%s",
+                           "%[z-a-]%s",  "%[^ ] %[A-Z]"};
+  const char *inputs[] = {"abc123", "12345 x", "key,the value",
+                          "]a]b c", "ab]cd",   "  abba cab",
+                          "-az-zq", "one TWO three"};
+  for (int i = 0; i < 8; i++) {
+    char a1[32] = {0}, a2[32] = {0}, b1[32] = {0}, b2[32] = {0};
+    int res1 = s21_sscanf(inputs[i], formats[i], a1, b1);
+    int res2 = sscanf(inputs[i], formats[i], a2, b2);
+    ck_assert_int_eq(res1, res2);
+    ck_assert_str_eq(a1, a2);
+    ck_assert_str_eq(b1, b2);
+  }
+  char a[8] = "keep";
+  const char *format = "%[0-9";
+  ck_assert_int_eq(s21_sscanf("123", format, a), 0);
+  ck_assert_str_eq(a, "keep");
+  ck_assert_int_eq(s21_sscanf(",x", "%[^,]", a), 0);
+}
+END_TEST
+
+START_TEST(sscanf_views) {
+  const char input[] = "  GET /index.html HTTP/1.1";
+  strview_type method = {0}, path = {0}, version = {0}, tail = {0};
+  int n = 0;
+  const char *format = "%vs %v[^ ] %4vc%n%vs";
+  ck_assert_int_eq(
+      s21_sscanf(input, format, &method, &path, &version, &n, &tail), 4);
+  ck_assert_ptr_eq(method.data, input + 2);
+  ck_assert_uint_eq(method.length, 3);
+  ck_assert_ptr_eq(path.data, input + 6);
+  ck_assert_uint_eq(path.length, 11);
+  ck_assert_ptr_eq(version.data, input + 18);
+  ck_assert_uint_eq(version.length, 4);
+  ck_assert_int_eq(n, 22);
+  ck_assert_int_eq(s21_strview_cmp(tail, s21_strview("/1.1")), 0);
+  scan_plan_type plan;
+  ck_assert_int_eq(s21_compile_scan_format(&plan, "%*vs %v[a-z.]"), 0);
+  ck_assert_int_eq(s21_sscanf_plan("x  host.name:80", &plan, &path), 1);
+  ck_assert_int_eq(s21_strview_cmp(path, s21_strview("host.name")), 0);
+}
+END_TEST
+
+START_TEST(sscanf_batch_views) {
+  const char input[] = "alpha,1 one\nbeta,22 two\n,3 x";
+  strview_type keys[3] = {{0}};
+  char words[3][8] = {{0}};
+  int values[3] = {0};
+  int status[3] = {0};
+  scan_column_type columns[] = {
+      {keys, 0}, {values, 0}, {words, sizeof(words[0])}};
+  const char *format = "%v[^,],%d %[a-z]";
+  ck_assert_int_eq(s21_sscanf_batch(input, format, columns, status, 3,
+                                    s21_NULL),
+                   3);
+  ck_assert_int_eq(status[0], 3);
+  ck_assert_int_eq(status[1], 3);
+  ck_assert_int_eq(status[2], 0);
+  ck_assert_int_eq(s21_strview_cmp(keys[0], s21_strview("alpha")), 0);
+  ck_assert_int_eq(s21_strview_cmp(keys[1], s21_strview("beta")), 0);
+  ck_assert_ptr_eq(keys[1].data, input + 12);
+  ck_assert_int_eq(values[1], 22);
+  ck_assert_str_eq(words[0], "one");
+  ck_assert_str_eq(words[1], "two");
+}
+END_TEST
+
+static int vsscanf_wrapper(const char *str, const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  int result = s21_vsscanf(str, format, args);
+  va_end(args);
+  return result;
+}
+
+// hands out the string of its context three characters at a time
+static long trickle_read(void *context, char *span, s21_size_t size) {
+  const char **input = context;
+  s21_size_t count = 0;
+  while (count < size && count < 3 && **input) span[count++] = *(*input)++;
+  return (long)count;
+}
+
+START_TEST(sscanf_vsscanf) {
+  int a = 0;
+  char word[8] = {0};
+  ck_assert_int_eq(vsscanf_wrapper(" 42 abc", "%d %7s", &a, word), 2);
+  ck_assert_int_eq(a, 42);
+  ck_assert_str_eq(word, "abc");
+  ck_assert_int_eq(vsscanf_wrapper("", "%d", &a), -1);
+}
+END_TEST
+
+START_TEST(sscanf_scanner_feed) {
+  scanner_type scanner;
+  source_type fed = {s21_NULL, s21_NULL};
+  int a = 0, b = 0;
+  s21_scanner_init(&scanner, fed);
+  ck_assert_int_eq(s21_scanner_feed(&scanner, "12", 2), 0);
+  ck_assert_int_eq(s21_scan(&scanner, "%d %d", &a, &b), S21_SCAN_AGAIN);
+  ck_assert_int_eq(s21_scanner_feed(&scanner, "34 5", 4), 0);
+  ck_assert_int_eq(s21_scan(&scanner, "%d %d", &a, &b), S21_SCAN_AGAIN);
+  ck_assert_int_eq(s21_scanner_feed(&scanner, "6\n\n 7", 5), 0);
+  ck_assert_int_eq(s21_scan(&scanner, "%d %d", &a, &b), 2);
+  ck_assert_int_eq(a, 1234);
+  ck_assert_int_eq(b, 56);
+  ck_assert_int_eq(s21_scan(&scanner, "%d", &a), S21_SCAN_AGAIN);
+  s21_scanner_close(&scanner);
+  ck_assert_int_eq(s21_scan(&scanner, "%d", &a), 1);
+  ck_assert_int_eq(a, 7);
+  ck_assert_int_eq(s21_scan(&scanner, "%d", &a), -1);
+  s21_scanner_free(&scanner);
+  // the literal ends the line, the conversion waits for the next one
+  s21_scanner_init(&scanner, fed);
+  ck_assert_int_eq(s21_scanner_feed(&scanner, "1,\n", 3), 0);
+  ck_assert_int_eq(s21_scan(&scanner, "%d,%d", &a, &b), S21_SCAN_AGAIN);
+  ck_assert_int_eq(s21_scanner_feed(&scanner, "2\n", 2), 0);
+  ck_assert_int_eq(s21_scan(&scanner, "%d,%d", &a, &b), 2);
+  ck_assert_int_eq(a, 1);
+  ck_assert_int_eq(b, 2);
+  s21_scanner_free(&scanner);
+}
+END_TEST
+
+START_TEST(sscanf_scanner_source) {
+  char input[4096] = {0};
+  s21_size_t length = 0;
+  for (int i = 0; i < 200; i++) {
+    length += s21_sprintf(input + length, "%d,name%d %g\n", i * 7919, i,
+                          i / 8.0);
+  }
+  const char *position = input;
+  source_type source = {trickle_read, &position};
+  scanner_type scanner;
+  s21_scanner_init(&scanner, source);
+  scanner.chunk = 16;
+  int rows = 0, result = 0;
+  do {
+    int id = 0;
+    char name[16] = {0};
+    double value = 0;
+    result = s21_scan(&scanner, "%d,%15s %lf", &id, name, &value);
+    if (result == 3) {
+      char expected[16];
+      s21_sprintf(expected, "name%d", rows);
+      ck_assert_int_eq(id, rows * 7919);
+      ck_assert_str_eq(name, expected);
+      ck_assert_double_eq(value, rows / 8.0);
+      rows++;
+    }
+  } while (result == 3);
+  ck_assert_int_eq(result, -1);
+  ck_assert_int_eq(rows, 200);
+  ck_assert_int_le((int)scanner.capacity, 256);
+  s21_scanner_free(&scanner);
+}
+END_TEST
+
+START_TEST(sscanf_fscanf) {
+  FILE *stream = tmpfile();
+  ck_assert_ptr_nonnull(stream);
+  fputs("10 abc\n 20 def tail\n\n  30 x", stream);
+  const char *format = "%d %7s";
+  rewind(stream);
+  int a = 0;
+  char word[8] = {0};
+  ck_assert_int_eq(s21_fscanf(stream, format, &a, word), 2);
+  ck_assert_int_eq(a, 10);
+  ck_assert_str_eq(word, "abc");
+  ck_assert_int_eq(s21_fscanf(stream, format, &a, word), 2);
+  ck_assert_int_eq(a, 20);
+  ck_assert_str_eq(word, "def");
+  ck_assert_int_eq(s21_fscanf(stream, "%7s", word), 1);
+  ck_assert_str_eq(word, "tail");
+  ck_assert_int_eq(getc(stream), '\n');
+  ck_assert_int_eq(s21_fscanf(stream, format, &a, word), 2);
+  ck_assert_int_eq(a, 30);
+  ck_assert_str_eq(word, "x");
+  ck_assert_int_eq(s21_fscanf(stream, format, &a, word), -1);
+  int b = 0;
+  FILE *split = tmpfile();
+  ck_assert_ptr_nonnull(split);
+  fputs("1,\n2\n3,4\n", split);
+  rewind(split);
+  ck_assert_int_eq(s21_fscanf(split, "%d,%d", &a, &b), 2);
+  ck_assert_int_eq(a, 1);
+  ck_assert_int_eq(b, 2);
+  ck_assert_int_eq(s21_fscanf(split, "%d,%d", &a, &b), 2);
+  ck_assert_int_eq(a, 3);
+  ck_assert_int_eq(b, 4);
+  fclose(split);
+  rewind(stream);
+  scanner_type scanner;
+  s21_scanner_init(&scanner, s21_source_file(stream));
+  ck_assert_int_eq(s21_scan(&scanner, "%*d %*s %d", &a), 1);
+  ck_assert_int_eq(a, 20);
+  s21_scanner_free(&scanner);
+  fclose(stream);
+  s21_scanner_init(&scanner, s21_source_fd(-1));
+  ck_assert_int_eq(s21_scan(&scanner, "%d", &a), -1);
+  ck_assert_int_eq(scanner.error, 1);
+  s21_scanner_free(&scanner);
+}
+END_TEST
+
+START_TEST(sscanf_fscanf_pipe) {
+  const char input[] = "1 2 3\n0x1f 1e+x end";
+  int fds[2];
+  ck_assert_int_eq(pipe(fds), 0);
+  ck_assert_int_eq(write(fds[1], input, sizeof(input) - 1),
+                   (int)sizeof(input) - 1);
+  close(fds[1]);
+  FILE *stream = fdopen(fds[0], "r");
+  ck_assert_ptr_nonnull(stream);
+  int a = 0;
+  double d = 0;
+  char word[8] = {0};
+  for (int i = 1; i <= 3; i++) {
+    ck_assert_int_eq(s21_fscanf(stream, "%d", &a), 1);
+    ck_assert_int_eq(a, i);
+  }
+  ck_assert_int_eq(getc(stream), '\n');
+  ck_assert_int_eq(s21_fscanf(stream, "%i", &a), 1);
+  ck_assert_int_eq(a, 31);
+  // "1e+" is read as fscanf does and the 'x' that stops it is left
+  ck_assert_int_eq(s21_fscanf(stream, "%lf", &d), 1);
+  ck_assert_double_eq(d, 1);
+  ck_assert_int_eq(s21_fscanf(stream, "%7s", word), 1);
+  ck_assert_str_eq(word, "x");
+  ck_assert_int_eq(s21_fscanf(stream, "%7s", word), 1);
+  ck_assert_str_eq(word, "end");
+  ck_assert_int_eq(s21_fscanf(stream, "%d", &a), -1);
+  fclose(stream);
+}
+END_TEST
+
+START_TEST(sscanf_wide_utf8) {
+  wchar_t word[8];
+  wchar_t rest[8];
+  wchar_t letters[4] = {0};
+  char tail[8];
+  ck_assert_int_eq(s21_sscanf("\xd0\x9f\xd1\x80\xd0\xb8W ok", "%ls %ls", word,
+                              rest),
+                   2);
+  ck_assert_int_eq(word[0], 0x41F);
+  ck_assert_int_eq(word[1], 0x440);
+  ck_assert_int_eq(word[2], 0x438);
+  ck_assert_int_eq(word[3], L'W');
+  ck_assert_int_eq(word[4], L'\0');
+  ck_assert_int_eq(rest[0], L'o');
+  ck_assert_int_eq(rest[2], L'\0');
+  // the width counts bytes and stops before a cut character
+  ck_assert_int_eq(
+      s21_sscanf("\xd0\x9f\xd1\x80", "%3ls%s", word, tail), 2);
+  ck_assert_int_eq(word[0], 0x41F);
+  ck_assert_int_eq(word[1], L'\0');
+  ck_assert_str_eq(tail, "\xd1\x80");
+  ck_assert_int_eq(s21_sscanf("\xf0\x9f\x98\x80" "a", "%lc%lc", letters,
+                              letters + 1),
+                   2);
+  ck_assert_int_eq(letters[0], 0x1F600);
+  ck_assert_int_eq(letters[1], L'a');
+  // malformed bytes decode to U+FFFD one at a time
+  ck_assert_int_eq(s21_sscanf("\xc0\xaf" "a\xe2\x82", "%ls", word), 1);
+  ck_assert_int_eq(word[0], 0xFFFD);
+  ck_assert_int_eq(word[1], 0xFFFD);
+  ck_assert_int_eq(word[2], L'a');
+  ck_assert_int_eq(word[3], 0xFFFD);
+  ck_assert_int_eq(word[4], 0xFFFD);
+  ck_assert_int_eq(word[5], L'\0');
+}
+END_TEST
+
+// cases the differential fuzzer found against the C library
+START_TEST(sscanf_fuzz_regressions) {
+  char letters[4] = {0};
+  int value = 7;
+  double number = 0;
+  ck_assert_int_eq(s21_sscanf("abcd", "%3c", letters), 1);
+  ck_assert_str_eq(letters, "abc");
+  ck_assert_int_eq(s21_sscanf("", "%c", letters), -1);
+  ck_assert_int_eq(s21_sscanf("-", "%d", &value), sscanf("-", "%d", &value));
+  ck_assert_int_eq(s21_sscanf("+ 1", "%x", &value), 0);
+  ck_assert_int_eq(value, 7);
+  ck_assert_int_eq(s21_sscanf("-", "%lf", &number), 0);
+  ck_assert_int_eq(s21_sscanf("nan", "%lf", &number), 1);
+  ck_assert(isnan(number) && !signbit(number));
+  ck_assert_int_eq(s21_sscanf("-nan", "%lf", &number), 1);
+  ck_assert(isnan(number) && signbit(number));
+}
+END_TEST
+
 Suite *s21_sscanf_test(void) {
   Suite *s = suite_create("suite_sscanf");
   TCase *tc = tcase_create("sscanf_tc");
@@ -3753,6 +4350,31 @@ Suite *s21_sscanf_test(void) {
   tcase_add_test(tc, mixed_ptrs4);
   tcase_add_test(tc, mixed_ptrs5);
   tcase_add_test(tc, additional);
+  tcase_add_test(tc, sscanf_plan_reuse);
+  tcase_add_test(tc, sscanf_plan_literals);
+  tcase_add_test(tc, sscanf_plan_limits);
+  tcase_add_test(tc, sscanf_float_correct_rounding);
+  tcase_add_test(tc, sscanf_float_ties);
+  tcase_add_test(tc, sscanf_float_long_double);
+  tcase_add_test(tc, sscanf_float_many_digits);
+  tcase_add_test(tc, sscanf_float_hex);
+  tcase_add_test(tc, sscanf_float_hex_long_mantissa);
+  tcase_add_test(tc, sscanf_float_width);
+  tcase_add_test(tc, sscanf_int_long_digits);
+  tcase_add_test(tc, sscanf_int_overflow);
+  tcase_add_test(tc, sscanf_int_width_blocks);
+  tcase_add_test(tc, sscanf_batch_columns);
+  tcase_add_test(tc, sscanf_batch_status);
+  tcase_add_test(tc, sscanf_scan_set);
+  tcase_add_test(tc, sscanf_views);
+  tcase_add_test(tc, sscanf_batch_views);
+  tcase_add_test(tc, sscanf_vsscanf);
+  tcase_add_test(tc, sscanf_scanner_feed);
+  tcase_add_test(tc, sscanf_scanner_source);
+  tcase_add_test(tc, sscanf_fscanf);
+  tcase_add_test(tc, sscanf_fscanf_pipe);
+  tcase_add_test(tc, sscanf_wide_utf8);
+  tcase_add_test(tc, sscanf_fuzz_regressions);
 
   suite_add_tcase(s, tc);
 
@@ -0,0 +1,73 @@
+/**
+ * @file s21_stats.c
+ * @brief Implementation of the opt-in counters of the format functions.
+ *
+ * The per-thread blocks form a list that only grows: a thread pushes its block
+ * with one compare-and-swap the first time it counts, and the snapshot walks
+ * the list reading every counter with a relaxed load.
+ */
+#include "s21_stats.h"
+
+#ifdef S21_STATS
+_Thread_local stats_block_type *s21_stats_local = s21_NULL;
+
+static _Atomic(stats_block_type *) s21_stats_blocks = s21_NULL;
+
+/**
+ * @brief Allocates the block of the calling thread and links it into the list.
+ *
+ * @return The block, or s21_NULL if it could not be allocated, in which case
+ * the thread does not count.
+ */
+stats_block_type *s21_stats_register(void) {
+  stats_block_type *block = calloc(1, sizeof(stats_block_type));
+  if (block) {
+    block->next = atomic_load(&s21_stats_blocks);
+    while (!atomic_compare_exchange_weak(&s21_stats_blocks, &block->next,
+                                         block)) {
+    }
+    s21_stats_local = block;
+  }
+  return block;
+}
+#endif
+
+/**
+ * @brief Sums the counters of all threads.
+ *
+ * @param stats Pointer to the totals to fill.
+ * @return 1 if the library was built with S21_STATS, 0 if it does not count
+ * and the totals are zero.
+ */
+int s21_stats_snapshot(stats_type *stats) {
+  unsigned long long *totals = (unsigned long long *)stats;
+  int enabled = 0;
+  for (s21_size_t i = 0; i < S21_STATS_COUNTERS; i++) totals[i] = 0;
+#ifdef S21_STATS
+  enabled = 1;
+  for (stats_block_type *block = atomic_load(&s21_stats_blocks); block;
+       block = block->next) {
+    for (s21_size_t i = 0; i < S21_STATS_COUNTERS; i++) {
+      totals[i] +=
+          atomic_load_explicit(&block->counters[i], memory_order_relaxed);
+    }
+  }
+#endif
+  return enabled;
+}
+/**
+ * @brief Sets the counters of all threads to zero.
+ *
+ * @note A counter that its thread is updating at that moment may keep its old
+ * value; the reset is not atomic across threads.
+ */
+void s21_stats_reset(void) {
+#ifdef S21_STATS
+  for (stats_block_type *block = atomic_load(&s21_stats_blocks); block;
+       block = block->next) {
+    for (s21_size_t i = 0; i < S21_STATS_COUNTERS; i++) {
+      atomic_store_explicit(&block->counters[i], 0, memory_order_relaxed);
+    }
+  }
+#endif
+}
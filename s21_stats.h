@@ -0,0 +1,99 @@
+/**
+ * @file s21_stats.h
+ * @brief Header file defining the opt-in counters of the format functions.
+ *
+ * A build with -DS21_STATS (make STATS=1) counts what s21_sprintf and
+ * s21_sscanf spend their time on: conversions per specifier, widths, output
+ * bytes, heap allocations, slow float paths and parse failures. Every thread
+ * counts into its own block with plain loads and stores, so counting costs no
+ * locked instruction; s21_stats_snapshot sums the blocks of all threads.
+ * Without S21_STATS the counting macros expand to nothing and the snapshot is
+ * all zeros.
+ *
+ * Structures:
+ * - stats_type: The counters, as returned by s21_stats_snapshot.
+ *
+ * @note Calls of s21_sprintf routed to a typed emitter count as calls and
+ * bytes only, they have no specifier to count.
+ * @note The blocks of finished threads are kept, so their counts stay in the
+ * totals; a block is one allocation per thread that ever counted.
+ */
+#ifndef SRC_S21_STATS_H_
+#define SRC_S21_STATS_H_
+
+#include <stddef.h>
+
+#include "s21_string.h"
+
+#define S21_STATS_SPECIFIERS 32        // specifier_type values of s21_sprintf
+#define S21_STATS_SCAN_SPECIFIERS 128  // conversion characters of s21_sscanf
+#define S21_STATS_WIDTHS 4             // none, 1 to 8, 9 to 64, above 64
+
+typedef struct stats {
+  unsigned long long sprintf_calls;  // formatting calls, a batch counts once
+  unsigned long long sprintf_specifiers[S21_STATS_SPECIFIERS];  // conversions
+  unsigned long long sprintf_widths[S21_STATS_WIDTHS];  // see s21_stats_width
+  unsigned long long bytes_emitted;  // characters formatted, truncated ones too
+  unsigned long long allocations;    // scratch, sink and strbuf heap blocks
+  unsigned long long sscanf_calls;   // scanning calls, a batch record each
+  unsigned long long sscanf_specifiers[S21_STATS_SCAN_SPECIFIERS];
+  unsigned long long float_slow_paths;  // floats read by the big decimal
+  unsigned long long parse_failures;    // scans stopped by a mismatch
+} stats_type;
+
+#define S21_STATS_COUNTERS (sizeof(stats_type) / sizeof(unsigned long long))
+
+int s21_stats_snapshot(stats_type *stats);
+void s21_stats_reset(void);
+
+#ifdef S21_STATS
+#include <stdatomic.h>
+
+typedef struct stats_block {
+  _Atomic unsigned long long counters[S21_STATS_COUNTERS];
+  struct stats_block *next;  // the block of another thread
+} stats_block_type;
+
+extern _Thread_local stats_block_type *s21_stats_local;
+
+stats_block_type *s21_stats_register(void);
+
+/**
+ * @brief Adds to a counter of the calling thread.
+ *
+ * @param slot Index of the counter, stats_type seen as an array.
+ * @param amount The amount to add.
+ */
+static inline void s21_stats_add(s21_size_t slot, unsigned long long amount) {
+  stats_block_type *block =
+      s21_stats_local ? s21_stats_local : s21_stats_register();
+  if (block) {
+    // only this thread writes the block: no read-modify-write is needed
+    atomic_store_explicit(
+        &block->counters[slot],
+        atomic_load_explicit(&block->counters[slot], memory_order_relaxed) +
+            amount,
+        memory_order_relaxed);
+  }
+}
+/**
+ * @brief Returns the sprintf_widths bucket of a minimum width.
+ *
+ * @param width The minimum width, -1 or 0 when there is none.
+ * @return 0 to S21_STATS_WIDTHS - 1.
+ */
+static inline s21_size_t s21_stats_width(int width) {
+  return width <= 0 ? 0 : width <= 8 ? 1 : width <= 64 ? 2 : 3;
+}
+
+#define S21_STATS_SLOT(field) \
+  (offsetof(stats_type, field) / sizeof(unsigned long long))
+#define S21_STAT_ADD(field, amount) s21_stats_add(S21_STATS_SLOT(field), amount)
+#define S21_STAT_COUNT(field, index, size) \
+  s21_stats_add(S21_STATS_SLOT(field) + (s21_size_t)(index) % (size), 1)
+#else
+#define S21_STAT_ADD(field, amount) ((void)0)
+#define S21_STAT_COUNT(field, index, size) ((void)0)
+#endif
+
+#endif  // SRC_S21_STATS_H_
@@ -0,0 +1,253 @@
+/**
+ * @file s21_strbuf.c
+ * @brief Implementation of the string builder.
+ *
+ * A builder keeps its text in the S21_STRBUF_SMALL bytes of the structure
+ * until it outgrows them, then in one heap block that at least doubles every
+ * time it is extended. The transformations work on the text where it is: trim
+ * moves the kept span to the front, the case maps flip it a block at a time
+ * and insert opens a gap with one s21_memmove, so a chain of them allocates
+ * only when the text grows past the capacity, and never when the capacity was
+ * reserved up front.
+ *
+ * Function Overview:
+ * - s21_strbuf_init, s21_strbuf_clear, s21_strbuf_free, s21_strbuf_detach:
+ * Life cycle.
+ * - s21_strbuf_reserve, s21_strbuf_grow: Exact and geometric growth.
+ * - s21_strbuf_append, s21_strbuf_insert, s21_strbuf_printf,
+ * s21_strbuf_vprintf: Add text.
+ * - s21_strbuf_trim, s21_strbuf_to_upper, s21_strbuf_to_lower: Transform the
+ * text in place.
+ *
+ * @note The text may be added from the builder itself, such as a copy of its
+ * own prefix; the span is located again after a reallocation.
+ */
+#include "s21_stats.h"
+#include "s21_string.h"
+
+/**
+ * @brief Makes an empty builder that holds its text in the structure.
+ *
+ * @param buf Pointer to the builder.
+ */
+void s21_strbuf_init(strbuf_type *buf) {
+  buf->heap = s21_NULL;
+  buf->length = 0;
+  buf->capacity = S21_STRBUF_SMALL;
+  buf->small[0] = '\0';
+}
+/**
+ * @brief Empties a builder and keeps its capacity.
+ *
+ * @param buf Pointer to the builder.
+ */
+void s21_strbuf_clear(strbuf_type *buf) {
+  buf->length = 0;
+  s21_strbuf_data(buf)[0] = '\0';
+}
+/**
+ * @brief Releases the heap block of a builder and empties it.
+ *
+ * @param buf Pointer to the builder, ready for use again.
+ */
+void s21_strbuf_free(strbuf_type *buf) {
+  free(buf->heap);
+  s21_strbuf_init(buf);
+}
+/**
+ * @brief Returns the text of a builder.
+ *
+ * @param buf Pointer to the builder.
+ * @return char* The null-terminated text, valid until the builder grows or is
+ * freed.
+ */
+char *s21_strbuf_data(strbuf_type *buf) {
+  return buf->heap ? buf->heap : buf->small;
+}
+/**
+ * @brief Hands the text of a builder over to the caller and empties it.
+ *
+ * @param buf Pointer to the builder.
+ * @return char* The null-terminated text, to be released with free; a text
+ * held in the structure is copied to a new allocation. NULL if that
+ * allocation fails, the builder is then left as it was.
+ */
+char *s21_strbuf_detach(strbuf_type *buf) {
+  char *result = buf->heap;
+  if (!result) {
+    result = malloc(buf->length + 1);
+    if (result) {
+      S21_STAT_ADD(allocations, 1);
+      s21_memcpy(result, buf->small, buf->length + 1);
+    }
+  }
+  if (result) s21_strbuf_init(buf);
+  return result;
+}
+/**
+ * @brief Makes room for a text of a given length.
+ *
+ * @param buf Pointer to the builder.
+ * @param length Number of characters the builder must hold without growing.
+ * @return int 0 on success, -1 if the allocation fails, the builder is then
+ * left as it was.
+ */
+int s21_strbuf_reserve(strbuf_type *buf, s21_size_t length) {
+  return s21_strbuf_grow(buf, length, length + 1);
+}
+/**
+ * @brief Grows the capacity of a builder geometrically for a text that does
+ * not fit.
+ *
+ * @param buf Pointer to the builder.
+ * @param length Number of characters the builder must hold.
+ * @param capacity The capacity to allocate when doubling the current one
+ * gives less, at least length + 1; insertions ask for half the added length
+ * more so that the next one fits as well.
+ * @return int 0 on success, -1 if the allocation fails, the builder is then
+ * left as it was.
+ */
+int s21_strbuf_grow(strbuf_type *buf, s21_size_t length, s21_size_t capacity) {
+  int status = 0;
+  if (length >= buf->capacity) {
+    if (capacity < buf->capacity * 2) capacity = buf->capacity * 2;
+    char *data = capacity > length ? realloc(buf->heap, capacity) : s21_NULL;
+    if (!data) {
+      status = -1;
+    } else {
+      S21_STAT_ADD(allocations, 1);
+      if (!buf->heap) s21_memcpy(data, buf->small, buf->length + 1);
+      buf->heap = data;
+      buf->capacity = capacity;
+    }
+  }
+  return status;
+}
+/**
+ * @brief Appends characters to the text of a builder.
+ *
+ * @param buf Pointer to the builder.
+ * @param str Pointer to the characters, may be inside the builder.
+ * @param len Number of characters to append.
+ * @return int 0 on success, -1 if the builder could not grow.
+ */
+int s21_strbuf_append(strbuf_type *buf, const char *str, s21_size_t len) {
+  return s21_strbuf_insert(buf, buf->length, str, len);
+}
+/**
+ * @brief Inserts characters into the text of a builder.
+ *
+ * @param buf Pointer to the builder.
+ * @param index Position of the first inserted character, at most the length.
+ * @param str Pointer to the characters, may be inside the builder.
+ * @param len Number of characters to insert.
+ * @return int 0 on success, -1 if index is out of bounds or the builder could
+ * not grow; the text is then left as it was.
+ */
+int s21_strbuf_insert(strbuf_type *buf, s21_size_t index, const char *str,
+                      s21_size_t len) {
+  char *data = s21_strbuf_data(buf);
+  int aliased = str >= data && str < data + buf->length;
+  s21_size_t offset = aliased ? (s21_size_t)(str - data) : 0;
+  int status = (index > buf->length || buf->length + len < len) ? -1 : 0;
+  if (!status) {
+    status = s21_strbuf_grow(buf, buf->length + len,
+                             buf->length + len + len / 2 + 1);
+  }
+  if (!status) {
+    data = s21_strbuf_data(buf);
+    s21_memmove(data + index + len, data + index, buf->length - index + 1);
+    if (aliased) {
+      // the part of the span after index moved with the tail
+      s21_size_t before = offset < index ? index - offset : 0;
+      if (before > len) before = len;
+      s21_memmove(data + index, data + offset, before);
+      s21_memmove(data + index + before, data + offset + before + len,
+                  len - before);
+    } else {
+      s21_memcpy(data + index, str, len);
+    }
+    buf->length += len;
+  }
+  return status;
+}
+/**
+ * @brief Formats a string and appends the result to a builder.
+ *
+ * @param buf Pointer to the builder.
+ * @param format Pointer to the format string.
+ * @param ... Variable arguments to be formatted according to the format string
+ * @return int The number of characters appended, or -1 on error
+ */
+int s21_strbuf_printf(strbuf_type *buf, const char *format, ...) {
+  int n = 0;
+  va_list var_arg;
+  va_start(var_arg, format);
+  n = s21_strbuf_vprintf(buf, format, var_arg);
+  va_end(var_arg);
+  return n;
+}
+/**
+ * @brief Formats a va_list and appends the result to a builder.
+ *
+ * The output goes straight into the free capacity; only an output that does
+ * not fit is formatted a second time, after one reservation of its length.
+ *
+ * @param buf Pointer to the builder.
+ * @param format Pointer to the format string.
+ * @param var_arg Variable argument list to be formatted.
+ * @return int The number of characters appended, or -1 on error; the text is
+ * then left as it was.
+ */
+int s21_strbuf_vprintf(strbuf_type *buf, const char *format,
+                       va_list var_arg) {
+  va_list args;
+  va_copy(args, var_arg);
+  s21_size_t room = buf->capacity - buf->length;
+  int n = s21_vsnprintf(s21_strbuf_data(buf) + buf->length, room, format,
+                        var_arg);
+  if (n >= 0 && (s21_size_t)n >= room) {
+    if (s21_strbuf_grow(buf, buf->length + n, buf->length + n + n / 2 + 1)) {
+      n = -1;
+    } else {
+      n = s21_vsnprintf(s21_strbuf_data(buf) + buf->length, n + 1, format,
+                        args);
+    }
+  }
+  va_end(args);
+  if (n >= 0) buf->length += n;
+  s21_strbuf_data(buf)[buf->length] = '\0';
+  return n;
+}
+/**
+ * @brief Trims leading and trailing characters off the text of a builder in
+ * place.
+ *
+ * @param buf Pointer to the builder.
+ * @param trim_chars Pointer to the null-terminated string containing the
+ * characters to be trimmed, NULL trims everything like s21_trim_view.
+ */
+void s21_strbuf_trim(strbuf_type *buf, const char *trim_chars) {
+  char *data = s21_strbuf_data(buf);
+  strview_type view =
+      s21_trim_view(s21_strview_n(data, buf->length), trim_chars);
+  s21_memmove(data, view.data, view.length);
+  data[view.length] = '\0';
+  buf->length = view.length;
+}
+/**
+ * @brief Converts the lowercase letters of a builder to uppercase in place.
+ *
+ * @param buf Pointer to the builder.
+ */
+void s21_strbuf_to_upper(strbuf_type *buf) {
+  s21_case_flip(s21_strbuf_data(buf), s21_strbuf_data(buf), buf->length, 'a');
+}
+/**
+ * @brief Converts the uppercase letters of a builder to lowercase in place.
+ *
+ * @param buf Pointer to the builder.
+ */
+void s21_strbuf_to_lower(strbuf_type *buf) {
+  s21_case_flip(s21_strbuf_data(buf), s21_strbuf_data(buf), buf->length, 'A');
+}
@@ -17,6 +17,10 @@
  * needed.
  */
 #include "s21_string.h"
+
+#include "s21_dispatch.h"
+#include "s21_search.h"
+#include "s21_simd.h"
 // Copy functions
 /**
  * @brief s21_memcpy Copies n bytes from memory area src to memory area dest
@@ -27,12 +31,20 @@
  * @param n Number of bytes to copy
  * @return void* Returns a pointer to dest */
 void *s21_memcpy(void *dest, const void *src, s21_size_t n) {
-  s21_size_t i = 0;
-  while (i < n) {
-    *((unsigned char *)dest + i) = *((unsigned char *)src + i);
-    i++;
-  }
-  return dest;
+  return s21_kernels()->memcpy(dest, src, n);
+}
+/**
+ * @brief Copies n bytes from memory area src to memory area dest, the areas
+ * may overlap
+ *
+ * @param dest Pointer to the destination array where the content is to be
+ * copied
+ * @param src Pointer to the source of data to be copied
+ * @param n Number of bytes to copy
+ * @return void* Returns a pointer to dest
+ */
+void *s21_memmove(void *dest, const void *src, s21_size_t n) {
+  return s21_kernels()->memmove(dest, src, n);
 }
 /**
  * @brief Fills the first n bytes of the memory area pointed to
@@ -44,13 +56,7 @@ void *s21_memcpy(void *dest, const void *src, s21_size_t n) {
  * @return void* Returns a pointer to the memory area str
  */
 void *s21_memset(void *str, int c, s21_size_t n) {
-  unsigned char *strCop = (unsigned char *)str;
-  s21_size_t i = 0;
-  while (i < n) {
-    strCop[i] = (unsigned char)c;
-    i++;
-  }
-  return strCop;
+  return s21_kernels()->memset(str, c, n);
 }
 /**
  * @brief Copies the string pointed to by src, including
@@ -104,16 +110,8 @@ char *s21_strncpy(char *dest, const char *src, s21_size_t n) {
  * @return void* Returns a pointer to the matching byte or NULL if the character
  * does not occur in the given memory area
  */
-// void *s21_memchr(const void *str, int c, s21_size_t n) {
 void *s21_memchr(const void *str, int c, s21_size_t n) {
-  void *result = s21_NULL;
-  for (s21_size_t i = 0; i < n; i++) {
-    if ((*((unsigned char *)str + i)) == (unsigned char)c) {
-      result = (char *)str + i;
-      i = n;
-    }
-  }
-  return result;
+  return s21_kernels()->memchr(str, c, n);
 }
 /**
  * @brief Locates the first occurrence of the character c in the string pointed
@@ -125,14 +123,19 @@ void *s21_memchr(const void *str, int c, s21_size_t n) {
  * the string, or NULL if the character is not found
  */
 char *s21_strchr(const char *str, int c) {
-  char *result = s21_NULL;
-  while (*str && *str != (char)c) {
-    str++;
-  }
-  if (*str == (char)c) {
-    result = (char *)str;
+  const char *block = str - (uintptr_t)str % S21_BLOCK_SIZE;
+  s21_block_type pattern = s21_block_splat((unsigned char)c);
+  s21_block_type zero = s21_block_splat(0);
+  s21_block_type data = s21_block_load(block);
+  unsigned long long mask = s21_mask_from(
+      s21_block_eq(data, pattern) | s21_block_eq(data, zero), str - block);
+  while (!mask) {
+    block += S21_BLOCK_SIZE;
+    data = s21_block_load(block);
+    mask = s21_block_eq(data, pattern) | s21_block_eq(data, zero);
   }
-  return result;
+  block += s21_mask_first(mask);
+  return *block == (char)c ? (char *)block : s21_NULL;
 }
 /**
  * @brief Locates the first occurrence in the string str1 of any of the bytes in
@@ -145,17 +148,10 @@ char *s21_strchr(const char *str, int c) {
  * bytes in str2, or NULL if no such byte is found
  */
 char *s21_strpbrk(const char *str1, const char *str2) {
-  s21_size_t n = s21_strlen(str2);
-  char *result = s21_NULL;
-  while (*str1 && !result) {
-    for (s21_size_t i = 0; i < n && !result; i++) {
-      if (*str1 == str2[i]) {
-        result = (char *)str1;
-      }
-    }
-    ++str1;
-  }
-  return result;
+  charset_type set;
+  s21_charset_init(&set, str2);
+  str1 += s21_charset_cspan(str1, &set);
+  return *str1 ? (char *)str1 : s21_NULL;
 }
 /**
  * @brief Locates the last occurrence of the character c in the string pointed
@@ -167,44 +163,115 @@ char *s21_strpbrk(const char *str1, const char *str2) {
  * the string, or NULL if the character is not found
  */
 char *s21_strrchr(const char *str, int c) {
+  const char *ptr = str + s21_strlen(str);
+  s21_block_type pattern = s21_block_splat((unsigned char)c);
+  unsigned long long mask = 0;
   char *result = s21_NULL;
-  int i = 0;
-  for (; *(str + i); i++) {
-    if (*((unsigned char *)str + i) == c) result = (char *)(str + i);
+  if ((char)c == 0) result = (char *)ptr;
+  while (!result && ptr - str >= S21_BLOCK_SIZE) {
+    ptr -= S21_BLOCK_SIZE;
+    mask = s21_block_eq(s21_block_load(ptr), pattern);
+    if (mask) result = (char *)ptr + s21_mask_last(mask);
+  }
+  while (!result && ptr > str) {
+    ptr--;
+    if (*ptr == (char)c) result = (char *)ptr;
   }
-  if (c == 0 && *(str + i) == 0) result = (char *)(str + i);
   return result;
 }
 /**
  * @brief Finds the first occurrence of the substring needle in the string
  * haystack
  *
+ * The haystack is measured only as far as the search has got, so a match near
+ * the start of a long string does not pay for its whole length.
+ *
  * @param haystack Pointer to the null-terminated string to be scanned
  * @param needle Pointer to the null-terminated substring to be searched for
  * @return char* Returns a pointer to the beginning of the located substring,
  *         or NULL if the substring is not found
  */
 char *s21_strstr(const char *haystack, const char *needle) {
-  char *result = s21_NULL;
-  s21_size_t haystack_len = s21_strlen(haystack);
+  haystack_type text = {(const unsigned char *)haystack, 0, 1};
   s21_size_t needle_len = s21_strlen(needle);
-  s21_size_t haystack_search = 0;
-  s21_size_t needle_search = 0;
-  s21_size_t match_counter = 0;
-  while (haystack_len >= needle_len &&
-         haystack_len - haystack_search >= needle_len - match_counter &&
-         match_counter != needle_len) {
-    if (haystack[haystack_search] == needle[needle_search]) {
-      ++match_counter;
-      ++needle_search;
-    } else {
-      needle_search = 0;
-      match_counter = (haystack[haystack_search] == needle[needle_search]);
-    }
-    ++haystack_search;
+  s21_size_t pos = 0;
+  char *result = (char *)haystack;
+  if (needle_len) {
+    pos = s21_search(&text, (const unsigned char *)needle, needle_len);
+    result = pos == S21_NOT_FOUND ? s21_NULL : (char *)haystack + pos;
   }
-  if (match_counter == needle_len) {
-    result = (char *)haystack + haystack_search - needle_len;
+  return result;
+}
+/**
+ * @brief Finds the first occurrence of the byte sequence needle in the memory
+ * area haystack
+ *
+ * @param haystack Pointer to the memory area to be scanned
+ * @param haystack_len Number of bytes in haystack
+ * @param needle Pointer to the byte sequence to be searched for
+ * @param needle_len Number of bytes in needle
+ * @return void* Returns a pointer to the beginning of the located sequence,
+ *         haystack for an empty needle, or NULL if the sequence is not found
+ */
+void *s21_memmem(const void *haystack, s21_size_t haystack_len,
+                 const void *needle, s21_size_t needle_len) {
+  haystack_type text = {haystack, haystack_len, 0};
+  s21_size_t pos = 0;
+  void *result = (void *)haystack;
+  if (needle_len) {
+    pos = s21_search(&text, needle, needle_len);
+    result = pos == S21_NOT_FOUND ? s21_NULL : (char *)haystack + pos;
+  }
+  return result;
+}
+// string views
+/**
+ * @brief Makes a view of a null-terminated string, measuring it once
+ *
+ * @param str Pointer to the null-terminated string, may be NULL
+ * @return strview_type Returns the view, empty for NULL
+ */
+strview_type s21_strview(const char *str) {
+  strview_type view = {str, str ? s21_strlen(str) : 0};
+  return view;
+}
+/**
+ * @brief Makes a view of bytes whose length is already known
+ *
+ * @param data Pointer to the first byte
+ * @param length Number of bytes
+ * @return strview_type Returns the view
+ */
+strview_type s21_strview_n(const char *data, s21_size_t length) {
+  strview_type view = {data, length};
+  return view;
+}
+/**
+ * @brief Finds the first occurrence of one view in another
+ *
+ * @param haystack The view to be scanned
+ * @param needle The view to be searched for
+ * @return const char* Returns a pointer to the beginning of the located
+ * sequence, haystack.data for an empty needle, or NULL if it is not found
+ */
+const char *s21_strview_find(strview_type haystack, strview_type needle) {
+  return s21_memmem(haystack.data, haystack.length, needle.data,
+                    needle.length);
+}
+/**
+ * @brief Compares two views byte by byte, as unsigned char
+ *
+ * @param view1 The first view
+ * @param view2 The second view
+ * @return int Returns a negative value, zero or a positive value if view1 is
+ * less than, equal to or greater than view2; a view sorts before the longer
+ * views it is a prefix of
+ */
+int s21_strview_cmp(strview_type view1, strview_type view2) {
+  s21_size_t common = view1.length < view2.length ? view1.length : view2.length;
+  int result = s21_memcmp(view1.data, view2.data, common);
+  if (!result && view1.length != view2.length) {
+    result = view1.length < view2.length ? -1 : 1;
   }
   return result;
 }
@@ -215,16 +282,10 @@ char *s21_strstr(const char *haystack, const char *needle) {
  * @param str Pointer to the null-terminated string to be converted
  * @return void* Returns a pointer to the newly allocated string with all
  * lowercase letters converted to uppercase, or NULL if the input string is NULL
+ * or the allocation fails
  */
 void *s21_to_upper(const char *str) {
-  char *result = s21_NULL;
-  s21_size_t len = str ? s21_strlen(str) : 0;
-  if (str) result = (char *)calloc((len + 1), sizeof(char));
-  if (result && len) {
-    for (s21_size_t i = 0; *(str + i); ++i)
-      result[i] = (str[i] > 96 && str[i] < 123) ? str[i] - 32 : str[i];
-  }
-  return result;
+  return s21_case_copy(str, str ? s21_strlen(str) : 0, 'a');
 }
 /**
  * @brief Converts all uppercase letters in the string to lowercase
@@ -232,17 +293,119 @@ void *s21_to_upper(const char *str) {
  * @param str Pointer to the null-terminated string to be converted
  * @return void* Returns a pointer to the newly allocated string with all
  * uppercase letters converted to lowercase, or NULL if the input string is NULL
+ * or the allocation fails
  */
 void *s21_to_lower(const char *str) {
+  return s21_case_copy(str, str ? s21_strlen(str) : 0, 'A');
+}
+/**
+ * @brief Converts n bytes of src to uppercase into a caller buffer
+ *
+ * @param dest Pointer to n writable bytes, may be src itself
+ * @param src Pointer to the bytes to be converted, a '\0' is not special
+ * @param n Number of bytes to convert
+ * @return char* Returns dest; nothing is appended after the n bytes
+ */
+char *s21_to_upper_into(char *dest, const char *src, s21_size_t n) {
+  s21_case_flip(dest, src, n, 'a');
+  return dest;
+}
+/**
+ * @brief Converts n bytes of src to lowercase into a caller buffer
+ *
+ * @param dest Pointer to n writable bytes, may be src itself
+ * @param src Pointer to the bytes to be converted, a '\0' is not special
+ * @param n Number of bytes to convert
+ * @return char* Returns dest; nothing is appended after the n bytes
+ */
+char *s21_to_lower_into(char *dest, const char *src, s21_size_t n) {
+  s21_case_flip(dest, src, n, 'A');
+  return dest;
+}
+/**
+ * @brief Converts all lowercase letters of a string to uppercase in place
+ *
+ * @param str Pointer to the null-terminated string to be converted
+ * @return char* Returns str
+ */
+char *s21_to_upper_inplace(char *str) {
+  if (str) s21_case_flip(str, str, s21_strlen(str), 'a');
+  return str;
+}
+/**
+ * @brief Converts all uppercase letters of a string to lowercase in place
+ *
+ * @param str Pointer to the null-terminated string to be converted
+ * @return char* Returns str
+ */
+char *s21_to_lower_inplace(char *str) {
+  if (str) s21_case_flip(str, str, s21_strlen(str), 'A');
+  return str;
+}
+/**
+ * @brief Converts the lowercase letters of a string of known length to
+ * uppercase into a new allocation
+ *
+ * @param str Pointer to the bytes to be converted
+ * @param len Number of bytes in str
+ * @return void* Returns the new null-terminated string, or NULL if str is NULL
+ * or the allocation fails
+ */
+void *s21_to_upper_n(const char *str, s21_size_t len) {
+  return s21_case_copy(str, len, 'a');
+}
+/**
+ * @brief Converts the uppercase letters of a string of known length to
+ * lowercase into a new allocation
+ *
+ * @param str Pointer to the bytes to be converted
+ * @param len Number of bytes in str
+ * @return void* Returns the new null-terminated string, or NULL if str is NULL
+ * or the allocation fails
+ */
+void *s21_to_lower_n(const char *str, s21_size_t len) {
+  return s21_case_copy(str, len, 'A');
+}
+/**
+ * @brief Copies a string into a new allocation, flipping the case of one set
+ * of letters
+ *
+ * @param str Pointer to the bytes to be converted
+ * @param len Number of bytes in str
+ * @param first 'a' to convert to uppercase, 'A' to convert to lowercase
+ * @return char* Returns the new string, or NULL if str is NULL or the
+ * allocation fails
+ */
+char *s21_case_copy(const char *str, s21_size_t len, unsigned char first) {
   char *result = s21_NULL;
-  s21_size_t len = str ? s21_strlen(str) : 0;
-  if (str) result = (char *)calloc((len + 1), sizeof(char));
-  if (result && len) {
-    for (s21_size_t i = 0; *(str + i); ++i)
-      result[i] = (str[i] > 64 && str[i] < 91) ? str[i] + 32 : str[i];
+  if (str) result = (char *)malloc(len + 1);
+  if (result) {
+    s21_case_flip(result, str, len, first);
+    result[len] = '\0';
   }
   return result;
 }
+/**
+ * @brief Toggles the case of the letters from first to first + 25, a block at
+ * a time
+ *
+ * @param dest Pointer to n writable bytes, may be src itself
+ * @param src Pointer to the bytes to be converted
+ * @param n Number of bytes to convert
+ * @param first 'a' to convert to uppercase, 'A' to convert to lowercase
+ */
+void s21_case_flip(char *dest, const char *src, s21_size_t n,
+                   unsigned char first) {
+  s21_size_t i = 0;
+  for (; i + S21_BLOCK_SIZE <= n; i += S21_BLOCK_SIZE) {
+    s21_block_store(dest + i,
+                    s21_block_flip_case(s21_block_load(src + i), first));
+  }
+  for (; i < n; i++) {
+    unsigned char c = (unsigned char)src[i];
+    dest[i] = (char)((unsigned char)(c - first) < 26 ? c ^ 0x20 : c);
+  }
+}
 /**
  * @brief Inserts one string into another at a specified index
  *
@@ -255,29 +418,33 @@ void *s21_to_lower(const char *str) {
  * bounds
  */
 void *s21_insert(const char *src, const char *str, s21_size_t start_index) {
-  s21_size_t len_src = 0, len_str = 0;
-  if (src != s21_NULL)
-    len_src = s21_strlen(src);
-  else
-    len_src = 0;
-  if (str != s21_NULL)
-    len_str = s21_strlen(str);
-  else
-    len_str = 0;
-  s21_size_t len = len_src + len_str;
-  if (start_index > len_src) return s21_NULL;
-  char *res = (char *)calloc(len + 1, sizeof(char));
+  return s21_insert_n(src, src ? s21_strlen(src) : 0, str,
+                      str ? s21_strlen(str) : 0, start_index);
+}
+/**
+ * @brief Inserts one string into another at a specified index, both lengths
+ * known to the caller
+ *
+ * @param src Pointer to the string where the insertion will occur
+ * @param src_len Number of bytes in src
+ * @param str Pointer to the string to be inserted
+ * @param str_len Number of bytes in str
+ * @param start_index Index in `src` where `str` will be inserted
+ * @return void* Returns a pointer to the newly allocated null-terminated
+ * string resulting from the insertion, or NULL if memory allocation fails or
+ * start_index is out of bounds
+ */
+void *s21_insert_n(const char *src, s21_size_t src_len, const char *str,
+                   s21_size_t str_len, s21_size_t start_index) {
+  char *res = s21_NULL;
+  if (start_index <= src_len) res = (char *)malloc(src_len + str_len + 1);
   if (res) {
-    for (s21_size_t i = 0; i < len; i++) {
-      if (i < start_index)
-        res[i] = src[i];
-      else if (i < start_index + len_str)
-        res[i] = str[i - start_index];
-      else
-        res[i] = src[i - len_str];
-    }
+    s21_memcpy(res, src, start_index);
+    s21_memcpy(res + start_index, str, str_len);
+    s21_memcpy(res + start_index + str_len, src + start_index,
+               src_len - start_index);
+    res[src_len + str_len] = '\0';
   }
-  res[len_src + len_str] = '\0';
   return (void *)res;
 }
 /**
@@ -294,16 +461,49 @@ void *s21_insert(const char *src, const char *str, s21_size_t start_index) {
  * NULL if memory allocation fails
  */
 void *s21_trim(const char *src, const char *trim_chars) {
+  return s21_trim_n(src, src ? s21_strlen(src) : 0, trim_chars);
+}
+/**
+ * @brief Trims leading and trailing characters specified in 'trim_chars' from
+ * a string of known length into a new allocation
+ *
+ * @param src Pointer to the string to be trimmed
+ * @param len Number of bytes in src
+ * @param trim_chars Pointer to the null-terminated string containing the
+ * characters to be trimmed
+ * @return void* Returns a pointer to the newly allocated trimmed string, or
+ * NULL if src is NULL or memory allocation fails
+ */
+void *s21_trim_n(const char *src, s21_size_t len, const char *trim_chars) {
   char *result = s21_NULL;
-  s21_size_t len = src ? s21_strlen(src) : 0;
-  if (src) result = (char *)calloc((len + 1), sizeof(char));
-  if (result && trim_chars) {
-    s21_size_t i = 0, j = 0;
-    for (; i < len && s21_strchr(trim_chars, src[i]); ++i)
-      ;
-    for (; i < len; ++j) result[j] = src[i++];
-    for (; j != 0 && s21_strchr(trim_chars, result[--j]) && j < len;)
-      result[j] = '\0';
+  strview_type view = s21_trim_view(s21_strview_n(src, len), trim_chars);
+  if (src) result = (char *)malloc(view.length + 1);
+  if (result) {
+    s21_memcpy(result, view.data, view.length);
+    result[view.length] = '\0';
+  }
+  return result;
+}
+/**
+ * @brief Trims leading and trailing characters specified in 'trim_chars' off
+ * a view without copying
+ *
+ * @param src The view to be trimmed
+ * @param trim_chars Pointer to the null-terminated string containing the
+ * characters to be trimmed, NULL trims everything
+ * @return strview_type Returns the part of src between the trimmed characters
+ */
+strview_type s21_trim_view(strview_type src, const char *trim_chars) {
+  strview_type result = {src.data, 0};
+  if (trim_chars) {
+    charset_type set;
+    s21_size_t start = 0, end = src.length;
+    const unsigned char *data = (const unsigned char *)src.data;
+    s21_charset_init(&set, trim_chars);
+    while (start < end && s21_charset_has(&set, data[start])) start++;
+    while (end > start && s21_charset_has(&set, data[end - 1])) end--;
+    result.data = src.data + start;
+    result.length = end - start;
   }
   return result;
 }
@@ -317,12 +517,7 @@ void *s21_trim(const char *src, const char *trim_chars) {
  * concatenation
  */
 char *s21_strcat(char *dest, const char *src) {
-  char *temp = dest + s21_strlen(dest);
-  for (; *src; src++) {
-    *temp = *src;
-    temp++;
-  }
-  *temp = '\0';
+  s21_strcat_n(dest, s21_strlen(dest), src, s21_strlen(src));
   return dest;
 }
 /**
@@ -336,38 +531,73 @@ char *s21_strcat(char *dest, const char *src) {
  * concatenation
  */
 char *s21_strncat(char *dest, const char *src, s21_size_t n) {
-  char *dest_inside = dest;
-  while (*dest_inside != '\0') dest_inside++;
-  while (n > 0 && *src != '\0') {
-    *dest_inside = *src;
-    dest_inside++;
-    src++;
-    n--;
-  }
-  *dest_inside = '\0';
+  s21_strcat_n(dest, s21_strlen(dest), src, s21_strnlen(src, n));
   return dest;
 }
+/**
+ * @brief Appends src_len bytes to a string of known length
+ *
+ * Building a string with repeated calls keeps the returned length, so 'dest'
+ * is never walked to its end again.
+ *
+ * @param dest Pointer to the destination string, room for dest_len + src_len
+ * + 1 bytes
+ * @param dest_len Number of bytes already in dest, the '\0' is not read
+ * @param src Pointer to the bytes to be appended
+ * @param src_len Number of bytes to append
+ * @return s21_size_t Returns the new length of dest, which is null-terminated
+ */
+s21_size_t s21_strcat_n(char *dest, s21_size_t dest_len, const char *src,
+                        s21_size_t src_len) {
+  s21_memcpy(dest + dest_len, src, src_len);
+  dest[dest_len + src_len] = '\0';
+  return dest_len + src_len;
+}
 /**
  * @brief Retrieves the error message string corresponding to the error number
  * 'errnum'
  *
  * @param errnum Integer representing the error number
  * @return char* Pointer to the error message string corresponding to 'errnum'
- *         If 'errnum' is out of range, returns a static string indicating
+ *         If 'errnum' is out of range, returns a per-thread string indicating
  * unknown error
  */
 char *s21_strerror(int errnum) {
+  static _Thread_local char s21_undef[S21_STRERROR_SIZE] = {'\0'};
   static char *strerr[] = s21_error;
-  static char s21_undef[ERRS_COUNTER] = {'\0'};
   char *res = s21_NULL;
   if (errnum < 0 || errnum >= ERRS_COUNTER) {
-    s21_sprintf(s21_undef, "Unknown error %d", errnum);
+    s21_strerror_r(errnum, s21_undef, S21_STRERROR_SIZE);
     res = s21_undef;
   } else {
     res = strerr[errnum];
   }
   return res;
 }
+/**
+ * @brief Writes the error message string corresponding to the error number
+ * 'errnum' into a caller buffer
+ *
+ * @param errnum Integer representing the error number
+ * @param buf Pointer to the buffer receiving the message, always terminated
+ * when 'buflen' is not 0
+ * @param buflen Size of 'buf' in bytes
+ * @return int 0 on success, EINVAL if 'errnum' is out of range (the buffer
+ * still receives "Unknown error N"), ERANGE if the message was truncated
+ */
+int s21_strerror_r(int errnum, char *buf, s21_size_t buflen) {
+  static const char *const strerr[] = s21_error;
+  int result = 0;
+  int len = 0;
+  if (errnum < 0 || errnum >= ERRS_COUNTER) {
+    len = s21_snprintf(buf, buflen, "Unknown error %d", errnum);
+    result = EINVAL;
+  } else {
+    len = s21_snprintf(buf, buflen, "%s", strerr[errnum]);
+  }
+  if ((s21_size_t)len >= buflen) result = ERANGE;
+  return result;
+}
 /**
  * @brief Extracts tokens from the string 'str' based on the delimiter 'delim'
  *
@@ -379,33 +609,33 @@ char *s21_strerror(int errnum) {
  */
 char *s21_strtok(char *str, const char *delim) {
   static char *nextToken = 0;
-  static char *toReturn = 0;
-  if (str != s21_NULL) nextToken = str;
-  if (nextToken != s21_NULL && *nextToken != 0) {
-    toReturn = nextToken;
-    int slider = 0;
-    int delimLen = s21_strlen(delim);
-    int wasFound = 0;
-    while (*(nextToken) != 0 && !wasFound) {
-      slider = 0;
-      while (slider < delimLen && !wasFound) {
-        if (delim[slider] == *nextToken) {
-          wasFound = 1;
-          *nextToken = 0;
-          nextToken++;
-        }
-        slider++;
-      }
-      if (!wasFound) {
-        nextToken++;
-      }
-    }
-    if (s21_strlen(toReturn) == 0) {
-      s21_strtok(s21_NULL, delim);
+  return s21_strtok_r(str, delim, &nextToken);
+}
+/**
+ * @brief Extracts tokens from the string 'str' based on the delimiter 'delim',
+ * keeping the position in caller-owned state
+ *
+ * @param str Pointer to the null-terminated string to be tokenized
+ *            If str is NULL, function continues from '*saveptr'
+ * @param delim Pointer to the null-terminated string of delimiter characters
+ * @param saveptr Pointer to the state of this tokenization, set on every call
+ * @return Pointer to the next token found in 'str', or NULL if no more
+ * tokens are found
+ */
+char *s21_strtok_r(char *str, const char *delim, char **saveptr) {
+  char *nextToken = str != s21_NULL ? str : *saveptr;
+  char *toReturn = s21_NULL;
+  if (nextToken != s21_NULL) {
+    charset_type set;
+    s21_charset_init(&set, delim);
+    nextToken += s21_charset_span(nextToken, &set);
+    if (*nextToken) {
+      toReturn = nextToken;
+      nextToken += s21_charset_cspan(nextToken, &set);
+      if (*nextToken) *nextToken++ = 0;
     }
-  } else {
-    toReturn = s21_NULL;
   }
+  *saveptr = nextToken;
   return toReturn;
 }
 // comparison functions
@@ -420,18 +650,34 @@ char *s21_strtok(char *str, const char *delim) {
  *             > 0 if 'str1' is greater than 'str2'
  */
 int s21_memcmp(const void *str1, const void *str2, s21_size_t n) {
+  const unsigned char *ptr1 = str1;
+  const unsigned char *ptr2 = str2;
+  const unsigned char *end = ptr1 + n;
+  unsigned long long mask = 0;
   int result = 0;
-  for (int i = 0; i < (int)n; i++) {
-    if (((unsigned char *)str1)[i] != ((unsigned char *)str2)[i]) {
-      result = ((unsigned char *)str1)[i] - ((unsigned char *)str2)[i];
-      break;
+  while (!mask && end - ptr1 >= S21_BLOCK_SIZE) {
+    mask = S21_MASK_FULL &
+           ~s21_block_eq(s21_block_load(ptr1), s21_block_load(ptr2));
+    if (!mask) {
+      ptr1 += S21_BLOCK_SIZE;
+      ptr2 += S21_BLOCK_SIZE;
     }
   }
+  if (mask) {
+    ptr1 += s21_mask_first(mask);
+    ptr2 += s21_mask_first(mask);
+    result = *ptr1 - *ptr2;
+  } else {
+    for (; ptr1 < end && !result; ptr1++, ptr2++) result = *ptr1 - *ptr2;
+  }
   return result;
 }
 /**
  * @brief Compares two strings 'str1' and 'str2'
  *
+ * Whole blocks are compared while neither pointer is close to the end of its
+ * page, so reading past the terminator never touches an unmapped page.
+ *
  * @param str1 Pointer to the first string
  * @param str2 Pointer to the second string
  * @return int 0 if 'str1' is equal to 'str2',
@@ -439,11 +685,28 @@ int s21_memcmp(const void *str1, const void *str2, s21_size_t n) {
  *             > 0 if 'str1' is greater than 'str2'
  */
 int s21_strcmp(const char *str1, const char *str2) {
-  while (*str1 && (*str1 == *str2)) {
-    str1++;
-    str2++;
+  const unsigned char *ptr1 = (const unsigned char *)str1;
+  const unsigned char *ptr2 = (const unsigned char *)str2;
+  s21_block_type zero = s21_block_splat(0);
+  s21_block_type data = zero;
+  unsigned long long mask = 0;
+  while (!mask) {
+    if (s21_block_in_page(ptr1) && s21_block_in_page(ptr2)) {
+      data = s21_block_load(ptr1);
+      mask = (S21_MASK_FULL & ~s21_block_eq(data, s21_block_load(ptr2))) |
+             s21_block_eq(data, zero);
+      if (!mask) {
+        ptr1 += S21_BLOCK_SIZE;
+        ptr2 += S21_BLOCK_SIZE;
+      }
+    } else if (*ptr1 && *ptr1 == *ptr2) {
+      ptr1++;
+      ptr2++;
+    } else {
+      mask = 1;
+    }
   }
-  return *(unsigned char *)str1 - *(unsigned char *)str2;
+  return ptr1[s21_mask_first(mask)] - ptr2[s21_mask_first(mask)];
 }
 /**
  * @brief Compares up to 'n' characters of two strings 'str1' and 'str2'
@@ -471,13 +734,39 @@ int s21_strncmp(const char *str1, const char *str2, s21_size_t n) {
 /**
  * @brief Calculates the length of the string 'str'
  *
+ * The scan starts from the aligned block that contains 'str', so no load ever
+ * crosses into a page the string does not occupy.
+ *
  * @param str Pointer to the string whose length is to be calculated
  * @return size_t Length of the string 'str'
  */
 s21_size_t s21_strlen(const char *str) {
-  s21_size_t chLen = 0;
-  while (str[chLen] != 0) chLen++;
-  return chLen;
+  return s21_kernels()->strlen(str);
+}
+/**
+ * @brief Calculates the length of the string 'str', but at most 'maxlen'
+ *
+ * @param str Pointer to the string whose length is to be calculated
+ * @param maxlen The largest length to report
+ * @return size_t Length of the string 'str' or 'maxlen' if it is longer
+ */
+s21_size_t s21_strnlen(const char *str, s21_size_t maxlen) {
+  const char *block = str - (uintptr_t)str % S21_BLOCK_SIZE;
+  s21_block_type zero = s21_block_splat(0);
+  unsigned long long mask = 0;
+  s21_size_t result = maxlen;
+  if (maxlen) {
+    mask = s21_mask_from(s21_block_eq(s21_block_load(block), zero),
+                         str - block);
+    while (!mask && (s21_size_t)(block + S21_BLOCK_SIZE - str) < maxlen) {
+      block += S21_BLOCK_SIZE;
+      mask = s21_block_eq(s21_block_load(block), zero);
+    }
+  }
+  if (mask && (s21_size_t)(block + s21_mask_first(mask) - str) < maxlen) {
+    result = block + s21_mask_first(mask) - str;
+  }
+  return result;
 }
 /**
  * @brief Calculates the length of the initial segment of 'str1' consisting of
@@ -489,19 +778,9 @@ s21_size_t s21_strlen(const char *str) {
  * characters from 'str2'
  */
 s21_size_t s21_strspn(const char *str1, const char *str2) {
-  s21_size_t len = 0;
-  int match = 1;
-  while (match && *(str1 + len)) {
-    match = 0;
-    for (s21_size_t i = 0; *(str2 + i); ++i) {
-      if (*(str1 + len) == *(str2 + i)) {
-        match = 1;
-        ++len;
-        break;
-      }
-    }
-  }
-  return len;
+  charset_type set;
+  s21_charset_init(&set, str2);
+  return s21_charset_span(str1, &set);
 }
 /**
  * @brief Calculates the length of the initial segment of 'str1' that contains
@@ -513,18 +792,7 @@ s21_size_t s21_strspn(const char *str1, const char *str2) {
  * characters from 'str2'
  */
 s21_size_t s21_strcspn(const char *str1, const char *str2) {
-  size_t chLen1 = s21_strlen(str1);
-  size_t chLen2 = s21_strlen(str2);
-  size_t toReturn = 0;
-  int wasFound = 0;
-  for (size_t i = 0; i < chLen1 && !wasFound; i++) {
-    for (size_t j = 0; j < chLen2 && !wasFound; j++) {
-      if (str1[i] == str2[j]) {
-        toReturn = i;
-        wasFound = 1;
-      }
-    }
-  }
-  if (!wasFound) toReturn = chLen1;
-  return toReturn;
-}
\ No newline at end of file
+  charset_type set;
+  s21_charset_init(&set, str2);
+  return s21_charset_cspan(str1, &set);
+}
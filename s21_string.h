@@ -9,20 +9,49 @@
  * with 's21_' to avoid naming conflicts with standard library functions.
  *
  * Included functionalities:
- * - copy functions: s21_memcpy, s21_memset, s21_strcpy,
+ * - copy functions: s21_memcpy, s21_memmove, s21_memset, s21_strcpy,
  * s21_strncpy
  * - concatenation and additional functions: , s21_strcat, s21_strncat,
- * s21_strerror, s21_strtok
+ * s21_strerror, s21_strerror_r, s21_strtok, s21_strtok_r
  * - search functions: s21_memchr, s21_strchr, s21_strpbrk, s21_strrchr,
- * s21_strstr
+ * s21_strstr, s21_memmem
  * - comparison functions: s21_memcmp, s21_strcmp, s21_strncmp
- * - transformation functions: s21_to_upper, s21_to_lower, s21_trim, s21_insert
- * - calculation functions: s21_strlen, s21_strspn, s21_strcspn
- * - format functions: s21_sprintf, s21_sscanf
+ * - transformation functions: s21_to_upper, s21_to_lower, s21_trim, s21_insert,
+ * the caller-buffer variants s21_to_upper_into, s21_to_lower_into and the
+ * in-place variants s21_to_upper_inplace, s21_to_lower_inplace
+ * - length-aware variants that never measure their inputs again: the
+ * strview_type view with s21_strview, s21_strview_n, s21_strview_find,
+ * s21_strview_cmp, s21_trim_view, and s21_insert_n, s21_trim_n, s21_strcat_n,
+ * s21_to_upper_n, s21_to_lower_n
+ * - calculation functions: s21_strlen, s21_strnlen, s21_strspn, s21_strcspn
+ * - character sets: s21_charset_init, s21_charset_add, s21_charset_invert,
+ * s21_charset_has, s21_charset_span, s21_charset_cspan
+ * - format functions: s21_sprintf, s21_snprintf, s21_vsnprintf, s21_sscanf,
+ * s21_vsscanf, checked by the compiler like printf where it can
+ * - format routes: with GCC or Clang, s21_sprintf with a constant format of a
+ * single common conversion ("%d", "%s", "%.3f", ...) or of "%s:%d" compiles to
+ * a call of the typed emitter s21_emit_signed, s21_emit_unsigned,
+ * s21_emit_char, s21_emit_string, s21_emit_pair, s21_emit_fixed or
+ * s21_emit_literal; define S21_NO_FORMAT_ROUTES to always interpret the format
+ * - output sinks: s21_sprintf_sink, s21_fprintf, s21_dprintf, s21_asprintf and
+ * the built-in sinks s21_sink_buffer, s21_sink_file, s21_sink_fd
+ * - string builder: strbuf_type with s21_strbuf_init, s21_strbuf_reserve,
+ * s21_strbuf_append, s21_strbuf_insert, s21_strbuf_printf, s21_strbuf_trim,
+ * s21_strbuf_to_upper, s21_strbuf_to_lower, s21_strbuf_detach and
+ * s21_strbuf_free; chained transforms run in place and allocate only when the
+ * text outgrows its capacity
+ * - input sources: the resumable scanner_type with s21_scanner_init,
+ * s21_scanner_feed, s21_scanner_close, s21_scanner_free, s21_scan, s21_vscan,
+ * s21_fscanf, s21_vfscanf and the built-in sources s21_source_file,
+ * s21_source_fd
+ * - conversion functions: s21_dtoa
+ * - kernel dispatch: s21_kernels_name, s21_kernels_select, the SIMD backend
+ * the copy, fill, length, byte and substring search kernels run on
  */
 #ifndef S21_STRING_H
 #define S21_STRING_H
 
+#include <errno.h>
 #include <float.h>
 #include <limits.h>
 #include <math.h>
@@ -33,8 +62,16 @@
 #define s21_NULL (void *)0
 typedef unsigned long long s21_size_t;
 
+#define S21_STRERROR_SIZE 32  // fits "Unknown error " and any int
+
+typedef struct strview {
+  const char *data;   // not null-terminated in general
+  s21_size_t length;  // bytes in the view
+} strview_type;
+
 // copy functions
 void *s21_memcpy(void *dest, const void *src, s21_size_t n);
+void *s21_memmove(void *dest, const void *src, s21_size_t n);
 void *s21_memset(void *str, int c, s21_size_t n);
 char *s21_strcpy(char *dest, const char *src);
 char *s21_strncpy(char *dest, const char *src, s21_size_t n);
@@ -44,27 +81,374 @@ char *s21_strchr(const char *str, int c);
 char *s21_strpbrk(const char *str1, const char *str2);
 char *s21_strrchr(const char *str, int c);
 char *s21_strstr(const char *haystack, const char *needle);
+void *s21_memmem(const void *haystack, s21_size_t haystack_len,
+                 const void *needle, s21_size_t needle_len);
+// string views
+strview_type s21_strview(const char *str);
+strview_type s21_strview_n(const char *data, s21_size_t length);
+const char *s21_strview_find(strview_type haystack, strview_type needle);
+int s21_strview_cmp(strview_type view1, strview_type view2);
 // transformation functions
 void *s21_to_upper(const char *str);
 void *s21_to_lower(const char *str);
+void *s21_to_upper_n(const char *str, s21_size_t len);
+void *s21_to_lower_n(const char *str, s21_size_t len);
+char *s21_to_upper_into(char *dest, const char *src, s21_size_t n);
+char *s21_to_lower_into(char *dest, const char *src, s21_size_t n);
+char *s21_to_upper_inplace(char *str);
+char *s21_to_lower_inplace(char *str);
+char *s21_case_copy(const char *str, s21_size_t len, unsigned char first);
+void s21_case_flip(char *dest, const char *src, s21_size_t n,
+                   unsigned char first);
 void *s21_insert(const char *src, const char *str, s21_size_t start_index);
+void *s21_insert_n(const char *src, s21_size_t src_len, const char *str,
+                   s21_size_t str_len, s21_size_t start_index);
 void *s21_trim(const char *src, const char *trim_chars);
+void *s21_trim_n(const char *src, s21_size_t len, const char *trim_chars);
+strview_type s21_trim_view(strview_type src, const char *trim_chars);
 // additional functions
 char *s21_strcat(char *dest, const char *src);
 char *s21_strncat(char *dest, const char *src, s21_size_t n);
+s21_size_t s21_strcat_n(char *dest, s21_size_t dest_len, const char *src,
+                        s21_size_t src_len);
 char *s21_strerror(int errnum);
+int s21_strerror_r(int errnum, char *buf, s21_size_t buflen);
 char *s21_strtok(char *str, const char *delim);
+char *s21_strtok_r(char *str, const char *delim, char **saveptr);
 // comparison functions
 int s21_memcmp(const void *str1, const void *str2, s21_size_t n);
 int s21_strcmp(const char *str1, const char *str2);
 int s21_strncmp(const char *str1, const char *str2, s21_size_t n);
 // calculation functions
 s21_size_t s21_strlen(const char *str);
+s21_size_t s21_strnlen(const char *str, s21_size_t maxlen);
 s21_size_t s21_strspn(const char *str1, const char *str2);
 s21_size_t s21_strcspn(const char *str1, const char *str2);
+// character sets
+#define S21_CHARSET_WORDS 4
+// " \t\n\v\f\r", the whitespace of isspace in the "C" locale
+#define S21_CHARSET_WHITESPACE  \
+  {                             \
+    { 0x100003E00ULL, 0, 0, 0 } \
+  }
+
+typedef struct charset {
+  unsigned long long bits[S21_CHARSET_WORDS];  // bit c is set for byte c
+} charset_type;
+
+void s21_charset_init(charset_type *set, const char *chars);
+void s21_charset_add(charset_type *set, unsigned char c);
+void s21_charset_invert(charset_type *set);
+int s21_charset_has(const charset_type *set, unsigned char c);
+s21_size_t s21_charset_span(const char *str, const charset_type *set);
+s21_size_t s21_charset_cspan(const char *str, const charset_type *set);
 // format functions
-int s21_sprintf(char *str, const char *format, ...);
+#if defined(__GNUC__)
+#define S21_PRINTF_FORMAT(string_index, first_index) \
+  __attribute__((format(printf, string_index, first_index)))
+#else
+#define S21_PRINTF_FORMAT(string_index, first_index)
+#endif
+
+int s21_sprintf(char *str, const char *format, ...) S21_PRINTF_FORMAT(2, 3);
+int s21_snprintf(char *str, s21_size_t size, const char *format, ...)
+    S21_PRINTF_FORMAT(3, 4);
+int s21_vsnprintf(char *str, s21_size_t size, const char *format,
+                  va_list var_arg) S21_PRINTF_FORMAT(3, 0);
 int s21_sscanf(const char *str, const char *format, ...);
+int s21_vsscanf(const char *str, const char *format, va_list var_arg);
+// output sinks
+typedef struct sink {
+  // consumes 'len' characters, returns 0 on success
+  int (*write)(void *context, const char *span, s21_size_t len);
+  int (*flush)(void *context);  // called once at the end, may be s21_NULL
+  void *context;
+} sink_type;
+
+typedef struct sink_buffer {
+  char *data;           // always null-terminated once something was written
+  s21_size_t length;    // characters stored
+  s21_size_t capacity;  // bytes available in data
+  int growable;         // 1 to grow data with realloc, 0 to truncate
+} sink_buffer_type;
+
+int s21_sprintf_sink(const sink_type *sink, const char *format, ...)
+    S21_PRINTF_FORMAT(2, 3);
+int s21_vsprintf_sink(const sink_type *sink, const char *format,
+                      va_list var_arg) S21_PRINTF_FORMAT(2, 0);
+int s21_fprintf(FILE *stream, const char *format, ...) S21_PRINTF_FORMAT(2, 3);
+int s21_vfprintf(FILE *stream, const char *format, va_list var_arg)
+    S21_PRINTF_FORMAT(2, 0);
+int s21_dprintf(int fd, const char *format, ...) S21_PRINTF_FORMAT(2, 3);
+int s21_vdprintf(int fd, const char *format, va_list var_arg)
+    S21_PRINTF_FORMAT(2, 0);
+int s21_asprintf(char **strp, const char *format, ...) S21_PRINTF_FORMAT(2, 3);
+int s21_vasprintf(char **strp, const char *format, va_list var_arg)
+    S21_PRINTF_FORMAT(2, 0);
+sink_type s21_sink_buffer(sink_buffer_type *buffer);
+sink_type s21_sink_file(FILE *stream);
+sink_type s21_sink_fd(int fd);
+// string builder
+#define S21_STRBUF_SMALL 64  // bytes of text held before the first allocation
+
+typedef struct strbuf {
+  char *heap;           // s21_NULL while the text fits into small
+  s21_size_t length;    // characters stored, always followed by a '\0'
+  s21_size_t capacity;  // bytes available in small or heap
+  char small[S21_STRBUF_SMALL];
+} strbuf_type;
+
+void s21_strbuf_init(strbuf_type *buf);
+void s21_strbuf_clear(strbuf_type *buf);
+void s21_strbuf_free(strbuf_type *buf);
+char *s21_strbuf_data(strbuf_type *buf);
+char *s21_strbuf_detach(strbuf_type *buf);
+int s21_strbuf_reserve(strbuf_type *buf, s21_size_t length);
+int s21_strbuf_grow(strbuf_type *buf, s21_size_t length, s21_size_t capacity);
+int s21_strbuf_append(strbuf_type *buf, const char *str, s21_size_t len);
+int s21_strbuf_insert(strbuf_type *buf, s21_size_t index, const char *str,
+                      s21_size_t len);
+int s21_strbuf_printf(strbuf_type *buf, const char *format, ...)
+    S21_PRINTF_FORMAT(2, 3);
+int s21_strbuf_vprintf(strbuf_type *buf, const char *format, va_list var_arg)
+    S21_PRINTF_FORMAT(2, 0);
+void s21_strbuf_trim(strbuf_type *buf, const char *trim_chars);
+void s21_strbuf_to_upper(strbuf_type *buf);
+void s21_strbuf_to_lower(strbuf_type *buf);
+// input sources
+#define S21_SCAN_AGAIN -2  // a fed scanner needs more input, call again
+
+typedef struct source {
+  // reads at most 'size' characters into 'span', returns the count, 0 at the
+  // end of the input or -1 on error
+  long (*read)(void *context, char *span, s21_size_t size);
+  void *context;
+} source_type;
+
+typedef struct scanner {
+  source_type source;   // read s21_NULL: fed with s21_scanner_feed
+  char *window;         // the input read and not consumed, null-terminated
+  s21_size_t start;     // first character not consumed yet
+  s21_size_t length;    // characters in window
+  s21_size_t capacity;  // bytes allocated for window
+  s21_size_t chunk;     // room made in window for every read of the source
+  int end;              // 1 once the input has ended
+  int error;            // 1 once the source or an allocation failed
+} scanner_type;
+
+void s21_scanner_init(scanner_type *scanner, source_type source);
+int s21_scanner_feed(scanner_type *scanner, const char *data, s21_size_t len);
+void s21_scanner_close(scanner_type *scanner);
+void s21_scanner_free(scanner_type *scanner);
+int s21_scan(scanner_type *scanner, const char *format, ...);
+int s21_vscan(scanner_type *scanner, const char *format, va_list var_arg);
+int s21_fscanf(FILE *stream, const char *format, ...);
+int s21_vfscanf(FILE *stream, const char *format, va_list var_arg);
+source_type s21_source_file(FILE *stream);
+source_type s21_source_fd(int fd);
+
+#define S21_DTOA_SIZE 32
+int s21_dtoa(char *str, double value);
+// kernel dispatch
+const char *s21_kernels_name(void);
+int s21_kernels_select(const char *name);
+// format routes
+typedef enum format_route {
+  S21_ROUTE_NONE,      // interpreted by s21_vsnprintf
+  S21_ROUTE_LITERAL,   // no conversion at all
+  S21_ROUTE_INT,       // "%d", "%i"
+  S21_ROUTE_LONG,      // "%ld", "%li"
+  S21_ROUTE_UNSIGNED,  // "%u"
+  S21_ROUTE_ULONG,     // "%lu"
+  S21_ROUTE_HEX,       // "%x"
+  S21_ROUTE_CHAR,      // "%c"
+  S21_ROUTE_STRING,    // "%s"
+  S21_ROUTE_PAIR,      // "%s:%d", "%s=%d", "%s %d"
+  S21_ROUTE_FIXED      // "%.0f" to "%.9f" are S21_ROUTE_FIXED + precision
+} format_route_type;
+
+typedef enum format_class {
+  S21_CLASS_NONE,  // any type no route takes
+  S21_CLASS_INT,   // int and the types promoted to it
+  S21_CLASS_LONG,
+  S21_CLASS_UNSIGNED,
+  S21_CLASS_ULONG,
+  S21_CLASS_STRING,  // char * and const char *
+  S21_CLASS_DOUBLE   // double and float
+} format_class_type;
+
+int s21_emit_literal(char *str, const char *literal);
+int s21_emit_signed(char *str, long value);
+int s21_emit_unsigned(char *str, unsigned long value, unsigned notation);
+int s21_emit_char(char *str, char symbol);
+int s21_emit_string(char *str, const char *string);
+int s21_emit_pair(char *str, const char *string, char separator, long value);
+int s21_emit_fixed(char *str, double value, int precision);
+
+#if defined(__GNUC__) && !defined(S21_NO_FORMAT_ROUTES)
+// a route folds to a constant only in its caller, so it is always inlined
+#define S21_ROUTE_INLINE static inline __attribute__((always_inline))
+#define S21_ARG_0(format, ...) format
+#define S21_ARG_1(format, first, ...) first
+#define S21_ARG_2(format, first, second, ...) second
+
+#define S21_FORMAT_CLASS(value)       \
+  _Generic((value),                   \
+      char: S21_CLASS_INT,            \
+      signed char: S21_CLASS_INT,     \
+      unsigned char: S21_CLASS_INT,   \
+      short: S21_CLASS_INT,           \
+      unsigned short: S21_CLASS_INT,  \
+      int: S21_CLASS_INT,             \
+      long: S21_CLASS_LONG,           \
+      unsigned: S21_CLASS_UNSIGNED,   \
+      unsigned long: S21_CLASS_ULONG, \
+      char *: S21_CLASS_STRING,       \
+      const char *: S21_CLASS_STRING, \
+      float: S21_CLASS_DOUBLE,        \
+      double: S21_CLASS_DOUBLE,       \
+      default: S21_CLASS_NONE)
+// every value is read by exactly one of the four, the others yield a zero
+#define S21_AS_SIGNED(value)   \
+  _Generic((value),            \
+      char: (value),           \
+      signed char: (value),    \
+      unsigned char: (value),  \
+      short: (value),          \
+      unsigned short: (value), \
+      int: (value),            \
+      long: (value),           \
+      default: 0L)
+#define S21_AS_UNSIGNED(value) \
+  _Generic((value), unsigned: (value), unsigned long: (value), default: 0UL)
+#define S21_AS_STRING(value) \
+  _Generic((value), char *: (value), const char *: (value), default: s21_NULL)
+#define S21_AS_DOUBLE(value) \
+  _Generic((value), float: (value), double: (value), default: 0.0)
+
+/**
+ * @brief Formats like s21_sprintf, through a typed emitter when the format is
+ * a constant the routes know and the arguments have the types it converts.
+ *
+ * The format is evaluated only when it is a compile-time constant, the
+ * arguments once, on whichever path is taken; on a routed call the arguments
+ * past the ones the format converts are not evaluated.
+ */
+#define s21_sprintf(str, ...)                                             \
+  ((__builtin_constant_p(S21_ARG_0(__VA_ARGS__, 0)) &&                    \
+    s21_format_routed(S21_ARG_0(__VA_ARGS__, 0),                          \
+                      S21_FORMAT_CLASS(S21_ARG_1(__VA_ARGS__, 0, 0)),     \
+                      S21_FORMAT_CLASS(S21_ARG_2(__VA_ARGS__, 0, 0))))    \
+       ? s21_sprintf_route((str), S21_ARG_0(__VA_ARGS__, 0),              \
+                           S21_AS_SIGNED(S21_ARG_1(__VA_ARGS__, 0, 0)),   \
+                           S21_AS_UNSIGNED(S21_ARG_1(__VA_ARGS__, 0, 0)), \
+                           S21_AS_STRING(S21_ARG_1(__VA_ARGS__, 0, 0)),   \
+                           S21_AS_DOUBLE(S21_ARG_1(__VA_ARGS__, 0, 0)),   \
+                           S21_AS_SIGNED(S21_ARG_2(__VA_ARGS__, 0, 0)))   \
+       : (s21_sprintf)(str, __VA_ARGS__))
+
+/**
+ * @brief Finds the route of a format string. Inlined with a constant format,
+ * every test folds away and the route is a constant.
+ *
+ * @param format The format string.
+ * @return A format_route_type value.
+ */
+S21_ROUTE_INLINE int s21_format_route(const char *format) {
+  int route = S21_ROUTE_NONE;
+  if (!__builtin_strchr(format, '%')) {
+    route = S21_ROUTE_LITERAL;
+  } else if (!__builtin_strcmp(format, "%d") ||
+             !__builtin_strcmp(format, "%i")) {
+    route = S21_ROUTE_INT;
+  } else if (!__builtin_strcmp(format, "%ld") ||
+             !__builtin_strcmp(format, "%li")) {
+    route = S21_ROUTE_LONG;
+  } else if (!__builtin_strcmp(format, "%u")) {
+    route = S21_ROUTE_UNSIGNED;
+  } else if (!__builtin_strcmp(format, "%lu")) {
+    route = S21_ROUTE_ULONG;
+  } else if (!__builtin_strcmp(format, "%x")) {
+    route = S21_ROUTE_HEX;
+  } else if (!__builtin_strcmp(format, "%c")) {
+    route = S21_ROUTE_CHAR;
+  } else if (!__builtin_strcmp(format, "%s")) {
+    route = S21_ROUTE_STRING;
+  } else if (!__builtin_strcmp(format, "%s:%d") ||
+             !__builtin_strcmp(format, "%s=%d") ||
+             !__builtin_strcmp(format, "%s %d")) {
+    route = S21_ROUTE_PAIR;
+  } else if (!__builtin_strcmp(format, "%f")) {
+    route = S21_ROUTE_FIXED + 6;
+  } else if (format[0] == '%' && format[1] == '.' && format[2] >= '0' &&
+             format[2] <= '9' && format[3] == 'f' && format[4] == '\0') {
+    route = S21_ROUTE_FIXED + format[2] - '0';
+  }
+  return route;
+}
+/**
+ * @brief Tells whether a call can take the route of its format.
+ *
+ * @param format The format string.
+ * @param first The format_class_type of the first argument.
+ * @param second The format_class_type of the second argument.
+ * @return 1 if the route converts arguments of these classes, otherwise 0.
+ */
+S21_ROUTE_INLINE int s21_format_routed(const char *format, int first,
+                                       int second) {
+  static const int classes[] = {
+      S21_CLASS_NONE,     S21_CLASS_NONE,     S21_CLASS_INT,
+      S21_CLASS_LONG,     S21_CLASS_UNSIGNED, S21_CLASS_ULONG,
+      S21_CLASS_UNSIGNED, S21_CLASS_INT,      S21_CLASS_STRING,
+      S21_CLASS_STRING};
+  int route = s21_format_route(format);
+  int routed = route == S21_ROUTE_LITERAL;
+  if (route >= S21_ROUTE_FIXED) {
+    routed = first == S21_CLASS_DOUBLE;
+  } else if (route > S21_ROUTE_LITERAL) {
+    routed = first == classes[route] &&
+             (route != S21_ROUTE_PAIR || second == S21_CLASS_INT);
+  }
+  return routed;
+}
+/**
+ * @brief Calls the emitter of the route of a format.
+ *
+ * @param str Pointer to the buffer where the formatted string will be stored.
+ * @param format The format string, routed by s21_format_routed.
+ * @param integer The first argument of the signed integer routes.
+ * @param natural The first argument of the unsigned integer routes.
+ * @param string The first argument of the string routes.
+ * @param real The first argument of the fixed-point routes.
+ * @param second The second argument of the pair route.
+ * @return The number of characters written, excluding the null-terminator, or
+ * -1 on error.
+ */
+S21_ROUTE_INLINE int s21_sprintf_route(char *str, const char *format,
+                                       long integer, unsigned long natural,
+                                       const char *string, double real,
+                                       long second) {
+  int route = s21_format_route(format), n = 0;
+  if (route == S21_ROUTE_LITERAL) {
+    n = s21_emit_literal(str, format);
+  } else if (route == S21_ROUTE_INT || route == S21_ROUTE_LONG) {
+    n = s21_emit_signed(str, integer);
+  } else if (route == S21_ROUTE_UNSIGNED || route == S21_ROUTE_ULONG) {
+    n = s21_emit_unsigned(str, natural, 10);
+  } else if (route == S21_ROUTE_HEX) {
+    n = s21_emit_unsigned(str, natural, 16);
+  } else if (route == S21_ROUTE_CHAR) {
+    n = s21_emit_char(str, (char)integer);
+  } else if (route == S21_ROUTE_STRING) {
+    n = s21_emit_string(str, string);
+  } else if (route == S21_ROUTE_PAIR) {
+    n = s21_emit_pair(str, string, format[2], second);
+  } else {
+    n = s21_emit_fixed(str, real, route - S21_ROUTE_FIXED);
+  }
+  return n;
+}
+#endif  // __GNUC__ && !S21_NO_FORMAT_ROUTES
 
 #endif  // S21_STRING_H_
 
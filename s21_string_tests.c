@@ -15,6 +15,9 @@
  *   aiding in rapid identification and resolution of issues.
  *
  */
+#include "s21_bulk.h"
+#include "s21_dispatch.h"
+#include "s21_stats.h"
 #include "s21_string.h"
 #include "s21_tests.h"
 
@@ -564,6 +567,340 @@ START_TEST(s21_to_lower_tests) {
 }
 END_TEST
 
+START_TEST(s21_case_into_tests) {
+  char src[300];
+  char dest[300];
+  char expected[300];
+  for (int i = 0; i < 256; i++) src[i] = (char)(255 - i);
+  for (int i = 256; i < 300; i++) src[i] = (char)('A' + i % 58);
+  for (s21_size_t start = 0; start < 40; start++) {
+    for (s21_size_t n = 0; start + n <= 300; n += 7) {
+      for (int upper = 0; upper < 2; upper++) {
+        char first = upper ? 'a' : 'A';
+        for (s21_size_t i = 0; i < n; i++) {
+          char c = src[start + i];
+          expected[i] = (char)(c >= first && c <= first + 25 ? c ^ 0x20 : c);
+        }
+        s21_memset(dest, '#', sizeof(dest));
+        char *res = upper ? s21_to_upper_into(dest, src + start, n)
+                          : s21_to_lower_into(dest, src + start, n);
+        ck_assert_ptr_eq(res, dest);
+        ck_assert_int_eq(s21_memcmp(dest, expected, n), 0);
+        if (n < sizeof(dest)) ck_assert_int_eq(dest[n], '#');
+      }
+    }
+  }
+}
+END_TEST
+
+START_TEST(s21_case_inplace_tests) {
+  char str[] = "Content-Type: TEXT/html, x-Request-ID: 42";
+  ck_assert_ptr_eq(s21_to_lower_inplace(str), str);
+  ck_assert_str_eq(str, "content-type: text/html, x-request-id: 42");
+  ck_assert_ptr_eq(s21_to_upper_inplace(str), str);
+  ck_assert_str_eq(str, "CONTENT-TYPE: TEXT/HTML, X-REQUEST-ID: 42");
+  ck_assert_ptr_null(s21_to_upper_inplace(s21_NULL));
+  ck_assert_ptr_null(s21_to_lower_inplace(s21_NULL));
+  char *empty = s21_to_upper("");
+  ck_assert_str_eq(empty, "");
+  free(empty);
+}
+END_TEST
+
+START_TEST(s21_strview_tests) {
+  const char text[] = "  key: Value\0tail  ";
+  strview_type whole = s21_strview_n(text, sizeof(text) - 1);
+  strview_type trimmed = s21_trim_view(whole, " ");
+  ck_assert_ptr_eq(trimmed.data, text + 2);
+  ck_assert_uint_eq(trimmed.length, sizeof(text) - 5);
+  ck_assert_ptr_eq(s21_strview_find(whole, s21_strview("tail")), text + 13);
+  ck_assert_ptr_null(s21_strview_find(trimmed, s21_strview("tails")));
+  ck_assert_ptr_eq(s21_strview_find(whole, s21_strview("")), text);
+  ck_assert_uint_eq(s21_strview(text).length, 12);
+  ck_assert_uint_eq(s21_strview(s21_NULL).length, 0);
+  ck_assert_uint_eq(s21_trim_view(whole, s21_NULL).length, 0);
+  ck_assert_int_eq(s21_strview_cmp(s21_strview("abc"), s21_strview("abc")), 0);
+  ck_assert_int_lt(s21_strview_cmp(s21_strview("ab"), s21_strview("abc")), 0);
+  ck_assert_int_gt(s21_strview_cmp(s21_strview("abd"), s21_strview("abc")), 0);
+  ck_assert_int_gt(s21_strview_cmp(s21_strview_n("a\xff", 2),
+                                   s21_strview_n("a\x01", 2)),
+                   0);
+}
+END_TEST
+
+START_TEST(s21_length_aware_tests) {
+  char buf[32] = "id";
+  s21_size_t len = 2;
+  len = s21_strcat_n(buf, len, "=42", 3);
+  len = s21_strcat_n(buf, len, ";name=xyz", 7);
+  ck_assert_uint_eq(len, 12);
+  ck_assert_str_eq(buf, "id=42;name=x");
+  char *inserted = s21_insert_n("key=value", 3, "-id", 3, 3);
+  ck_assert_str_eq(inserted, "key-id");
+  free(inserted);
+  ck_assert_ptr_null(s21_insert_n("key", 3, "x", 1, 4));
+  char *trimmed = s21_trim_n("xxabcxxyy", 7, "x");
+  ck_assert_str_eq(trimmed, "abc");
+  free(trimmed);
+  char *upper = s21_to_upper_n("content-type", 7);
+  ck_assert_str_eq(upper, "CONTENT");
+  free(upper);
+  char *lower = s21_to_lower_n("X-REQUEST-ID", 9);
+  ck_assert_str_eq(lower, "x-request");
+  free(lower);
+  ck_assert_ptr_null(s21_to_lower_n(s21_NULL, 0));
+}
+END_TEST
+
+START_TEST(s21_kernels_dispatch_tests) {
+  const char *names[] = {"swar", "sse2", "avx2", "neon"};
+  char src[200];
+  char dest[200];
+  for (int i = 0; i < 200; i++) src[i] = (char)('a' + i % 23);
+  src[199] = '\0';
+  ck_assert_int_eq(s21_kernels_select("mmx"), 1);
+  ck_assert_int_eq(s21_kernels_select("swar"), 0);
+  ck_assert_str_eq(s21_kernels_name(), "swar");
+  for (int k = 0; k < 4; k++) {
+    if (s21_kernels_select(names[k])) continue;
+    ck_assert_str_eq(s21_kernels_name(), names[k]);
+    for (s21_size_t n = 0; n < 100; n++) {
+      memset(dest, '#', sizeof(dest));
+      ck_assert_ptr_eq(s21_memcpy(dest + 1, src + n % 7, n), dest + 1);
+      ck_assert_int_eq(memcmp(dest + 1, src + n % 7, n), 0);
+      ck_assert_int_eq(dest[n + 1], '#');
+      ck_assert_ptr_eq(s21_memset(dest + 3, 'z', n), dest + 3);
+      ck_assert_int_eq(dest[n + 3], '#');
+      for (s21_size_t i = 0; i < n; i++) ck_assert_int_eq(dest[i + 3], 'z');
+      ck_assert_uint_eq(s21_strlen(src + n), strlen(src + n));
+      ck_assert_ptr_eq(s21_memchr(src, 'a' + n % 23, n),
+                       memchr(src, 'a' + n % 23, n));
+      ck_assert_ptr_eq(s21_strstr(src, src + n + 50),
+                       strstr(src, src + n + 50));
+    }
+  }
+  ck_assert_int_eq(s21_kernels_select(s21_NULL), 0);
+}
+END_TEST
+
+START_TEST(s21_memmove_tests) {
+  const char *names[] = {"swar", "sse2", "avx2", "neon"};
+  static unsigned char buf[400];
+  static unsigned char expected[400];
+  for (int k = 0; k < 4; k++) {
+    if (s21_kernels_select(names[k])) continue;
+    for (s21_size_t n = 0; n < 200; n += (n < 70 ? 1 : 13)) {
+      for (int shift = -40; shift <= 40; shift += 3) {
+        for (int i = 0; i < 400; i++) buf[i] = (unsigned char)(i * 7 + 1);
+        memcpy(expected, buf, sizeof(buf));
+        memmove(expected + 100 + shift, expected + 100, n);
+        ck_assert_ptr_eq(s21_memmove(buf + 100 + shift, buf + 100, n),
+                         buf + 100 + shift);
+        ck_assert_int_eq(memcmp(buf, expected, sizeof(buf)), 0);
+      }
+    }
+  }
+  ck_assert_int_eq(s21_kernels_select(s21_NULL), 0);
+}
+END_TEST
+
+START_TEST(s21_memcpy_large_tests) {
+  const s21_size_t size = S21_STREAM_THRESHOLD + 4099;
+  unsigned char *src = malloc(size + 64);
+  unsigned char *dest = malloc(size + 64);
+  ck_assert_ptr_nonnull(src);
+  ck_assert_ptr_nonnull(dest);
+  for (s21_size_t i = 0; i < size + 64; i++) src[i] = (unsigned char)(i % 251);
+  ck_assert_ptr_eq(s21_memcpy(dest + 3, src + 5, size), dest + 3);
+  ck_assert_int_eq(memcmp(dest + 3, src + 5, size), 0);
+  ck_assert_ptr_eq(s21_memset(dest + 1, 0xAB, size), dest + 1);
+  for (s21_size_t i = 1; i <= size; i += 997) ck_assert_int_eq(dest[i], 0xAB);
+  ck_assert_int_eq(dest[size], 0xAB);
+  s21_memmove(src + 17, src, size);
+  for (s21_size_t i = 0; i < size; i += 991) {
+    ck_assert_int_eq(src[i + 17], (unsigned char)(i % 251));
+  }
+  s21_memmove(src, src + 17, size);
+  ck_assert_int_eq(src[size - 1], (unsigned char)((size - 1) % 251));
+  free(src);
+  free(dest);
+}
+END_TEST
+
+START_TEST(s21_stats_tests) {
+  char buffer[64];
+  int a = 0, b = 0;
+  stats_type stats;
+  unsigned long long conversions = 0;
+  s21_stats_reset();
+  ck_assert_int_eq(s21_sprintf(buffer, "%d %20s", 42, "x"), 23);
+  ck_assert_int_eq(s21_sscanf("1 z", "%d %d", &a, &b), 1);
+  int enabled = s21_stats_snapshot(&stats);
+  for (int i = 0; i < S21_STATS_SPECIFIERS; i++) {
+    conversions += stats.sprintf_specifiers[i];
+  }
+  if (enabled) {
+    ck_assert_uint_eq(stats.sprintf_calls, 1);
+    ck_assert_uint_eq(stats.bytes_emitted, 23);
+    ck_assert_uint_eq(conversions, 2);
+    ck_assert_uint_eq(stats.sprintf_widths[0], 1);
+    ck_assert_uint_eq(stats.sprintf_widths[2], 1);
+    ck_assert_uint_eq(stats.sscanf_calls, 1);
+    ck_assert_uint_eq(stats.sscanf_specifiers['d'], 2);
+    ck_assert_uint_eq(stats.parse_failures, 1);
+  } else {
+    ck_assert_uint_eq(stats.sprintf_calls, 0);
+    ck_assert_uint_eq(conversions, 0);
+    ck_assert_uint_eq(stats.sscanf_calls, 0);
+  }
+}
+END_TEST
+
+typedef struct bulk_totals {
+  _Atomic long long sum;
+  _Atomic long lines;
+  s21_size_t chunks;    // chunks delivered
+  s21_size_t expected;  // index of the next ordered delivery
+  long delivered_lines;
+  int out_of_order;
+} bulk_totals_type;
+
+static void bulk_sum_line(void *context, strview_type line, s21_size_t index) {
+  bulk_totals_type *totals = context;
+  int value = 0;
+  (void)index;
+  if (s21_sscanf(line.data, "%d", &value) == 1) totals->sum += value;
+  totals->lines++;
+}
+
+static void *bulk_count_lines(void *context, strview_type chunk,
+                              s21_size_t index) {
+  const char *end = chunk.data + chunk.length;
+  long lines = 0;
+  (void)context;
+  (void)index;
+  for (const char *line = chunk.data; line < end; lines++) {
+    const char *newline = s21_memchr(line, '\n', end - line);
+    line = newline ? newline + 1 : end;
+  }
+  return (void *)(intptr_t)lines;
+}
+
+static void bulk_collect(void *context, s21_size_t index, void *result) {
+  bulk_totals_type *totals = context;
+  if (index != totals->expected) totals->out_of_order = 1;
+  totals->expected = index + 1;
+  totals->delivered_lines += (long)(intptr_t)result;
+  totals->chunks++;
+}
+
+START_TEST(s21_bulk_buffer_tests) {
+  static char text[40000];
+  s21_size_t length = 0;
+  for (int i = 1; i <= 5000; i++) {
+    length += s21_sprintf(text + length, "%d\n", i);
+  }
+  bulk_totals_type totals = {0};
+  bulk_job_type job = {s21_NULL, bulk_sum_line, s21_NULL, &totals, 4, 1000, 0};
+  ck_assert_int_eq(s21_bulk_buffer(text, length, &job), 0);
+  ck_assert_int_eq(totals.lines, 5000);
+  ck_assert_int_eq(totals.sum, 5000LL * 5001 / 2);
+  bulk_job_type ordered = {bulk_count_lines, s21_NULL, bulk_collect, &totals,
+                           8,                999,      1};
+  ck_assert_int_eq(s21_bulk_buffer(text, length, &ordered), 0);
+  ck_assert_int_eq(totals.delivered_lines, 5000);
+  ck_assert_int_gt((int)totals.chunks, 20);
+  ck_assert_int_eq(totals.out_of_order, 0);
+  totals.chunks = 0;
+  ck_assert_int_eq(s21_bulk_buffer(text, 0, &ordered), 0);
+  ck_assert_int_eq((int)totals.chunks, 0);
+}
+END_TEST
+
+START_TEST(s21_bulk_file_tests) {
+  const char *path = "s21_bulk_test.txt";
+  FILE *stream = fopen(path, "w");
+  ck_assert_ptr_nonnull(stream);
+  for (int i = 0; i < 3000; i++) fprintf(stream, "line %d\n", i);
+  fputs("last", stream);
+  fclose(stream);
+  bulk_totals_type totals = {0};
+  bulk_job_type job = {bulk_count_lines, s21_NULL, bulk_collect, &totals,
+                       0,                4096,     0};
+  ck_assert_int_eq(s21_bulk_file(path, &job), 0);
+  ck_assert_int_eq(totals.delivered_lines, 3001);
+  // 4096 bytes without a final '\n', a whole page on most systems
+  stream = fopen(path, "w");
+  ck_assert_ptr_nonnull(stream);
+  for (int i = 0; i < 511; i++) fputs("1234567\n", stream);
+  fputs("12345678", stream);
+  fclose(stream);
+  totals.delivered_lines = 0;
+  job.ordered = 1;
+  job.chunk = s21_NULL;
+  job.line = bulk_sum_line;
+  totals.lines = 0;
+  totals.sum = 0;
+  ck_assert_int_eq(s21_bulk_file(path, &job), 0);
+  ck_assert_int_eq(totals.lines, 512);
+  ck_assert_int_eq(totals.sum, 511LL * 1234567 + 12345678);
+  remove(path);
+  ck_assert_int_eq(s21_bulk_file(path, &job), -1);
+}
+END_TEST
+
+START_TEST(s21_strbuf_tests) {
+  strbuf_type buf;
+  s21_strbuf_init(&buf);
+  ck_assert_str_eq(s21_strbuf_data(&buf), "");
+  // trim, lowercase and insert all run inside the structure
+  ck_assert_int_eq(s21_strbuf_append(&buf, "  Hello, WORLD  ", 16), 0);
+  s21_strbuf_trim(&buf, " ");
+  s21_strbuf_to_lower(&buf);
+  ck_assert_int_eq(s21_strbuf_insert(&buf, 6, " big", 4), 0);
+  ck_assert_str_eq(s21_strbuf_data(&buf), "hello, big world");
+  ck_assert_uint_eq(buf.length, 16);
+  ck_assert_ptr_null(buf.heap);
+  s21_strbuf_to_upper(&buf);
+  ck_assert_str_eq(s21_strbuf_data(&buf), "HELLO, BIG WORLD");
+  ck_assert_int_eq(s21_strbuf_insert(&buf, 17, "x", 1), -1);
+  ck_assert_str_eq(s21_strbuf_data(&buf), "HELLO, BIG WORLD");
+  // the text may come from the builder itself
+  ck_assert_int_eq(s21_strbuf_insert(&buf, 5, s21_strbuf_data(&buf) + 3, 6), 0);
+  ck_assert_str_eq(s21_strbuf_data(&buf), "HELLOLO, BI, BIG WORLD");
+  s21_strbuf_clear(&buf);
+  ck_assert_int_eq(s21_strbuf_printf(&buf, "%d-%s", 42, "x"), 4);
+  ck_assert_str_eq(s21_strbuf_data(&buf), "42-x");
+  // growing past the structure moves the text to the heap, doubling
+  for (int i = 0; i < 40; i++) {
+    ck_assert_int_eq(s21_strbuf_append(&buf, s21_strbuf_data(&buf), 2), 0);
+  }
+  ck_assert_uint_eq(buf.length, 84);
+  ck_assert_ptr_nonnull(buf.heap);
+  ck_assert_uint_eq(buf.capacity, 2 * S21_STRBUF_SMALL);
+  ck_assert_int_eq(s21_strncmp(s21_strbuf_data(&buf), "42-x42424242", 12), 0);
+  ck_assert_int_eq(s21_strbuf_printf(&buf, "%0100d", 7), 100);
+  ck_assert_uint_eq(buf.length, 184);
+  ck_assert_str_eq(s21_strbuf_data(&buf) + 183, "7");
+  ck_assert_int_eq(s21_strbuf_reserve(&buf, 1000), 0);
+  ck_assert_uint_eq(buf.capacity, 1001);
+  char *text = s21_strbuf_detach(&buf);
+  ck_assert_uint_eq(s21_strlen(text), 184);
+  free(text);
+  ck_assert_ptr_null(buf.heap);
+  ck_assert_uint_eq(buf.length, 0);
+  // a text held in the structure is copied once to be detached
+  s21_strbuf_printf(&buf, "  %s  ", "Value");
+  s21_strbuf_trim(&buf, s21_NULL);
+  ck_assert_str_eq(s21_strbuf_data(&buf), "");
+  s21_strbuf_append(&buf, "x", 1);
+  text = s21_strbuf_detach(&buf);
+  ck_assert_str_eq(text, "x");
+  free(text);
+  s21_strbuf_free(&buf);
+}
+END_TEST
+
 // uwu
 START_TEST(s21_insert_tests) {
   char *str1 = "4";
@@ -662,6 +999,230 @@ START_TEST(s21_trim_tests) {
 }
 END_TEST
 
+START_TEST(s21_block_search_tests) {
+  char buf[160] = {0};
+  for (int offset = 0; offset < 40; offset++) {
+    for (int len = 0; len < 100; len++) {
+      char *str = buf + offset;
+      for (int i = 0; i < len; i++) str[i] = (char)('a' + (i * 7) % 26);
+      str[len] = '\0';
+      ck_assert_uint_eq(s21_strlen(str), strlen(str));
+      for (int c = 0; c < 128; c += 3) {
+        ck_assert_ptr_eq(s21_strchr(str, c), strchr(str, c));
+        ck_assert_ptr_eq(s21_strrchr(str, c), strrchr(str, c));
+        ck_assert_ptr_eq(s21_memchr(str, c, len), memchr(str, c, len));
+      }
+      ck_assert_ptr_eq(s21_memchr(str, 0, len + 1), memchr(str, 0, len + 1));
+    }
+  }
+  buf[100] = (char)0xE9;
+  ck_assert_ptr_eq(s21_strchr(buf, 0xE9), strchr(buf, 0xE9));
+  ck_assert_ptr_eq(s21_strrchr(buf, 0xE9), strrchr(buf, 0xE9));
+  ck_assert_ptr_eq(s21_memchr(buf, 0xE9, 160), memchr(buf, 0xE9, 160));
+}
+END_TEST
+
+START_TEST(s21_block_compare_tests) {
+  char str1[160] = {0};
+  char str2[160] = {0};
+  for (int len = 1; len < 100; len++) {
+    for (int i = 0; i < len; i++) str1[i] = (char)('A' + i % 50);
+    str1[len] = '\0';
+    char *copy = str2 + len % 16;
+    memcpy(copy, str1, len + 1);
+    ck_assert_int_eq(s21_strcmp(str1, copy), 0);
+    ck_assert_int_eq(s21_memcmp(str1, copy, len), 0);
+    for (int i = 0; i < len; i++) {
+      copy[i] = (char)(i % 2 ? 0xF0 : 0x01);
+      ck_assert_int_eq(s21_strcmp(str1, copy) > 0, strcmp(str1, copy) > 0);
+      ck_assert_int_eq(s21_strcmp(str1, copy) < 0, strcmp(str1, copy) < 0);
+      ck_assert_int_eq(s21_memcmp(str1, copy, len) > 0,
+                       memcmp(str1, copy, len) > 0);
+      ck_assert_int_eq(s21_memcmp(str1, copy, len) < 0,
+                       memcmp(str1, copy, len) < 0);
+      copy[i] = str1[i];
+    }
+    copy[len] = 'x';
+    copy[len + 1] = '\0';
+    ck_assert_int_lt(s21_strcmp(str1, copy), 0);
+    ck_assert_int_gt(s21_strcmp(copy, str1), 0);
+  }
+}
+END_TEST
+
+START_TEST(s21_block_page_end_tests) {
+  _Alignas(4096) static char page[2 * 4096];
+  for (int len = 0; len < 70; len++) {
+    char *str1 = page + 4096 - len - 1;
+    char *str2 = page + 2 * 4096 - len - 1;
+    memset(str1, 'q', len);
+    str1[len] = '\0';
+    memcpy(str2, str1, len + 1);
+    ck_assert_uint_eq(s21_strlen(str1), (s21_size_t)len);
+    ck_assert_ptr_eq(s21_strchr(str1, 0), str1 + len);
+    ck_assert_ptr_eq(s21_strrchr(str2, 'q'), len ? str2 + len - 1 : s21_NULL);
+    ck_assert_int_eq(s21_strcmp(str1, str2), 0);
+    // str2 + 2 is past the page for the shortest strings
+    if (len > 1) ck_assert_int_eq(s21_strcmp(str1 + 1, str2 + 2), 'q');
+  }
+}
+END_TEST
+
+START_TEST(s21_strstr_two_way_tests) {
+  const char *testcases[][2] = {
+      {"ababac", "abac"},
+      {"aaab", "aab"},
+      {"xxabcabcabd", "abcabd"},
+      {"header: value\r\nHost: example\r\n", "\r\nHost:"},
+      {"aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaab",
+       "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaab"},
+      {"abcabcabcabcabcabcabcabcabcabcabcabcabcabd",
+       "abcabcabcabcabcabcabcabcabcabcabcabd"},
+      {"zyxwvutsrqponmlkjihgfedcbazyxwvutsrqponmlkjihgfedcba",
+       "utsrqponmlkjihgfedcbazyxwvutsrqponm"},
+      {"abababababababababababababababababababab",
+       "babababababababababababababababababc"},
+      {"short", "much longer than the haystack itself"},
+  };
+  s21_size_t n = sizeof(testcases) / sizeof(testcases[0]);
+  for (s21_size_t i = 0; i < n; i++) {
+    ck_assert_ptr_eq(s21_strstr(testcases[i][0], testcases[i][1]),
+                     strstr(testcases[i][0], testcases[i][1]));
+  }
+}
+END_TEST
+
+START_TEST(s21_memmem_tests) {
+  const char data[] = "key\0value\0key=value\0\0end";
+  s21_size_t len = sizeof(data) - 1;
+  ck_assert_ptr_eq(s21_memmem(data, len, "key=", 4), data + 10);
+  ck_assert_ptr_eq(s21_memmem(data, len, "\0\0", 2), data + 19);
+  ck_assert_ptr_eq(s21_memmem(data, len, "end", 3), data + 21);
+  ck_assert_ptr_eq(s21_memmem(data, len - 1, "end", 3), s21_NULL);
+  ck_assert_ptr_eq(s21_memmem(data, len, "value\0key", 9), data + 4);
+  ck_assert_ptr_eq(s21_memmem(data, len, "", 0), data);
+  ck_assert_ptr_eq(s21_memmem(data, 0, "k", 1), s21_NULL);
+  char big[300];
+  memset(big, 'a', sizeof(big));
+  big[250] = 'b';
+  for (s21_size_t needle_len = 1; needle_len < 60; needle_len++) {
+    const char *needle = big + 251 - needle_len;
+    ck_assert_ptr_eq(s21_memmem(big, sizeof(big), needle, needle_len),
+                     big + 251 - needle_len);
+    ck_assert_ptr_eq(s21_memmem(big, 250, needle, needle_len), s21_NULL);
+  }
+}
+END_TEST
+
+START_TEST(s21_strnlen_tests) {
+  const char *str = "Hello world!";
+  ck_assert_uint_eq(s21_strnlen(str, 0), 0);
+  ck_assert_uint_eq(s21_strnlen(str, 5), 5);
+  ck_assert_uint_eq(s21_strnlen(str, 12), 12);
+  ck_assert_uint_eq(s21_strnlen(str, 100), 12);
+  ck_assert_uint_eq(s21_strnlen("", 100), 0);
+  char buf[100];
+  memset(buf, 'x', sizeof(buf));
+  for (s21_size_t max = 0; max <= sizeof(buf); max++) {
+    ck_assert_uint_eq(s21_strnlen(buf, max), max);
+  }
+}
+END_TEST
+
+START_TEST(s21_charset_tests) {
+  charset_type set;
+  s21_charset_init(&set, ",;\xE9");
+  ck_assert_int_eq(s21_charset_has(&set, ','), 1);
+  ck_assert_int_eq(s21_charset_has(&set, 0xE9), 1);
+  ck_assert_int_eq(s21_charset_has(&set, 'a'), 0);
+  ck_assert_int_eq(s21_charset_has(&set, 0), 0);
+  s21_charset_add(&set, 'a');
+  ck_assert_int_eq(s21_charset_has(&set, 'a'), 1);
+  ck_assert_uint_eq(s21_charset_span(",a;\xE9" "b,", &set), 4);
+  ck_assert_uint_eq(s21_charset_cspan("bcd\xE9,", &set), 3);
+  ck_assert_uint_eq(s21_charset_cspan("bcd", &set), 3);
+  s21_charset_init(&set, s21_NULL);
+  ck_assert_uint_eq(s21_charset_span("abc", &set), 0);
+  const charset_type whitespace = S21_CHARSET_WHITESPACE;
+  for (int c = 0; c < 256; c++) {
+    ck_assert_int_eq(s21_charset_has(&whitespace, (unsigned char)c),
+                     s21_strchr(" \t\n\v\f\r", c) != s21_NULL && c != 0);
+  }
+}
+END_TEST
+
+START_TEST(s21_charset_functions_tests) {
+  const char *testcases[][2] = {
+      {"\xE9\xE9" "abc\xE9", "\xE9"},
+      {"a,b;;c", ",;"},
+      {",,,", ","},
+      {"abc", ""},
+      {"", "abc"},
+      {"\x80x\xFF", "\xFF"},
+  };
+  s21_size_t n = sizeof(testcases) / sizeof(testcases[0]);
+  for (s21_size_t i = 0; i < n; i++) {
+    const char *str = testcases[i][0];
+    const char *chars = testcases[i][1];
+    ck_assert_uint_eq(s21_strspn(str, chars), strspn(str, chars));
+    ck_assert_uint_eq(s21_strcspn(str, chars), strcspn(str, chars));
+    ck_assert_ptr_eq(s21_strpbrk(str, chars), strpbrk(str, chars));
+    char s21_buf[16] = {0};
+    char buf[16] = {0};
+    strcpy(s21_buf, str);
+    strcpy(buf, str);
+    char *s21_token = s21_strtok(s21_buf, chars);
+    char *token = strtok(buf, chars);
+    while (token) {
+      ck_assert_ptr_nonnull(s21_token);
+      ck_assert_str_eq(s21_token, token);
+      s21_token = s21_strtok(s21_NULL, chars);
+      token = strtok(s21_NULL, chars);
+    }
+    ck_assert_ptr_null(s21_token);
+  }
+  char *trimmed = s21_trim("\xE9\xE9 text \xE9", "\xE9 ");
+  ck_assert_str_eq(trimmed, "text");
+  free(trimmed);
+}
+END_TEST
+
+START_TEST(s21_strtok_r_tests) {
+  char rows[] = "a=1;b=2;;c=3";
+  char *rows_state = s21_NULL;
+  char *pair_state = s21_NULL;
+  const char *expected[][2] = {{"a", "1"}, {"b", "2"}, {"c", "3"}};
+  int count = 0;
+  for (char *row = s21_strtok_r(rows, ";", &rows_state); row;
+       row = s21_strtok_r(s21_NULL, ";", &rows_state)) {
+    ck_assert_str_eq(s21_strtok_r(row, "=", &pair_state), expected[count][0]);
+    ck_assert_str_eq(s21_strtok_r(s21_NULL, "=", &pair_state),
+                     expected[count][1]);
+    ck_assert_ptr_null(s21_strtok_r(s21_NULL, "=", &pair_state));
+    count++;
+  }
+  ck_assert_int_eq(count, 3);
+  ck_assert_ptr_null(s21_strtok_r(s21_NULL, ";", &rows_state));
+  char delims[] = ";;;";
+  ck_assert_ptr_null(s21_strtok_r(delims, ";", &rows_state));
+}
+END_TEST
+
+START_TEST(s21_strerror_r_tests) {
+  char buf[S21_STRERROR_SIZE];
+  ck_assert_int_eq(s21_strerror_r(EINVAL, buf, sizeof(buf)), 0);
+  ck_assert_str_eq(buf, strerror(EINVAL));
+  ck_assert_int_eq(s21_strerror_r(-7, buf, sizeof(buf)), EINVAL);
+  ck_assert_str_eq(buf, "Unknown error -7");
+  ck_assert_int_eq(s21_strerror_r(INT_MIN, buf, sizeof(buf)), EINVAL);
+  ck_assert_str_eq(buf, "Unknown error -2147483648");
+  ck_assert_int_eq(s21_strerror_r(EPERM, buf, 4), ERANGE);
+  ck_assert_str_eq(buf, "Ope");
+  ck_assert_int_eq(s21_strerror_r(EPERM, s21_NULL, 0), ERANGE);
+  ck_assert_str_eq(s21_strerror(INT_MAX), "Unknown error 2147483647");
+}
+END_TEST
+
 Suite *s21_string_suite(void) {
   Suite *s = suite_create("s21_string.h tests");
 
@@ -674,6 +1235,10 @@ Suite *s21_string_suite(void) {
   tcase_add_test(tc_tests_search, test_s21_strpbrk_test1);
   tcase_add_test(tc_tests_search, test_s21_strstr_test1);
   tcase_add_test(tc_tests_search, test_s21_strchr_test1);
+  tcase_add_test(tc_tests_search, s21_block_search_tests);
+  tcase_add_test(tc_tests_search, s21_block_page_end_tests);
+  tcase_add_test(tc_tests_search, s21_strstr_two_way_tests);
+  tcase_add_test(tc_tests_search, s21_memmem_tests);
   suite_add_tcase(s, tc_tests_search);
 
   // tests of transformation functions C#
@@ -681,6 +1246,17 @@ Suite *s21_string_suite(void) {
   tc_tests_CS = tcase_create("C#_func");
   tcase_add_test(tc_tests_CS, s21_to_upper_tests);
   tcase_add_test(tc_tests_CS, s21_to_lower_tests);
+  tcase_add_test(tc_tests_CS, s21_case_into_tests);
+  tcase_add_test(tc_tests_CS, s21_case_inplace_tests);
+  tcase_add_test(tc_tests_CS, s21_strview_tests);
+  tcase_add_test(tc_tests_CS, s21_length_aware_tests);
+  tcase_add_test(tc_tests_CS, s21_kernels_dispatch_tests);
+  tcase_add_test(tc_tests_CS, s21_memmove_tests);
+  tcase_add_test(tc_tests_CS, s21_memcpy_large_tests);
+  tcase_add_test(tc_tests_CS, s21_stats_tests);
+  tcase_add_test(tc_tests_CS, s21_bulk_buffer_tests);
+  tcase_add_test(tc_tests_CS, s21_bulk_file_tests);
+  tcase_add_test(tc_tests_CS, s21_strbuf_tests);
   tcase_add_test(tc_tests_CS, s21_insert_tests);
   tcase_add_test(tc_tests_CS, s21_trim_tests);
   suite_add_tcase(s, tc_tests_CS);
@@ -699,6 +1275,8 @@ Suite *s21_string_suite(void) {
   tcase_add_test(tc_tests_help, strtok_1);
   tcase_add_test(tc_tests_help, strtok_2);
   tcase_add_test(tc_tests_help, strtok_3);
+  tcase_add_test(tc_tests_help, s21_strtok_r_tests);
+  tcase_add_test(tc_tests_help, s21_strerror_r_tests);
   suite_add_tcase(s, tc_tests_help);
 
   // tests of comparison functions
@@ -707,12 +1285,16 @@ Suite *s21_string_suite(void) {
   tcase_add_test(tc_tests_comp, s21_strcmp_tests);
   tcase_add_test(tc_tests_comp, s21_strncmp_tests);
   tcase_add_test(tc_tests_comp, s21_memcmp_tests);
+  tcase_add_test(tc_tests_comp, s21_block_compare_tests);
   suite_add_tcase(s, tc_tests_comp);
 
   // tests of calculation functions
   TCase *tc_tests_calc;
   tc_tests_calc = tcase_create("calculation_func");
   tcase_add_test(tc_tests_calc, s21_strlen_tests);
+  tcase_add_test(tc_tests_calc, s21_strnlen_tests);
+  tcase_add_test(tc_tests_calc, s21_charset_tests);
+  tcase_add_test(tc_tests_calc, s21_charset_functions_tests);
   tcase_add_test(tc_tests_calc, s21_strcspn_tests);
   tcase_add_test(tc_tests_calc, s21_strspn_tests);
   suite_add_tcase(s, tc_tests_calc);
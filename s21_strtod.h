@@ -0,0 +1,190 @@
+/**
+ * @file s21_strtod.h
+ * @brief Header file defining the correctly rounded decimal to binary
+ * conversion engine.
+ *
+ * This header file declares the types and functions the floating-point
+ * conversions of s21_sscanf use to turn text into a float, double or long
+ * double. The result is the representable value nearest to the exact value of
+ * the text, ties to even, for any number of digits.
+ *
+ * Structures:
+ * - float_format_type: Precision and exponent range of the target type, see
+ * S21_FLOAT_FORMAT, S21_DOUBLE_FORMAT and S21_LONG_DOUBLE_FORMAT.
+ * - float_scan_type: A scanned number, the first 19 significant digits as an
+ * integer and the position of the whole digit text.
+ * - float_decimal_type: All the significant digits of a number, used by the
+ * exact fallback.
+ *
+ * Included functionalities:
+ * - Scanning decimal and hexadecimal (0x1.8p3) input, eight digits at a time.
+ * - Eisel-Lemire: one 64x128-bit multiplication by a truncated power of five
+ * gives the result for float and double.
+ * - Big decimal fallback: exact shifts of the digits by powers of two, used
+ * when more than 19 digits leave the fast path undecided and for long double.
+ * - Integer digits in base 8, 10 or 16, validated and converted eight at a
+ * time, for the integer conversions of s21_sscanf.
+ *
+ * @note Precisions above 64 bits, such as a 128-bit long double, are rounded
+ * to 64 bits.
+ */
+#ifndef SRC_S21_STRTOD_H_
+#define SRC_S21_STRTOD_H_
+
+#include "s21_simd.h"
+#include "s21_string.h"
+
+#define S21_FLOAT_MAX_DIGITS 19  // decimal digits that fit the mantissa
+// 2^-16446 has about 11500 significant digits
+#define S21_DECIMAL_MAX_DIGITS 11600
+#define S21_DECIMAL_MAX_SHIFT 60
+#define S21_EXPONENT_LIMIT 100000  // larger exponents saturate
+#define S21_POW5_MIN_EXPONENT (-342)
+#define S21_POW5_MAX_EXPONENT 308
+
+// precision, min_exponent, max_exponent, the Eisel-Lemire round to even range
+#define S21_FLOAT_FORMAT { FLT_MANT_DIG, FLT_MIN_EXP, FLT_MAX_EXP, -17, 10 }
+#define S21_DOUBLE_FORMAT { DBL_MANT_DIG, DBL_MIN_EXP, DBL_MAX_EXP, -4, 23 }
+#define S21_LONG_DOUBLE_FORMAT \
+  { LDBL_MANT_DIG, LDBL_MIN_EXP, LDBL_MAX_EXP, -4, 23 }
+
+typedef struct float_format {
+  int precision;     // significand bits, the *_MANT_DIG of the type
+  int min_exponent;  // the *_MIN_EXP of the type
+  int max_exponent;  // the *_MAX_EXP of the type
+  int even_min;      // powers of ten where a product can be an exact tie
+  int even_max;
+} float_format_type;
+
+typedef struct float_scan {
+  const char *digits;           // the first character of the digit text
+  const char *end;              // past the digit text, before the exponent
+  unsigned long long mantissa;  // the first significant digits
+  long long exponent;           // value = mantissa * base^exponent
+  long long exponent_part;      // the number after 'e' or 'p'
+  int truncated;                // digits cut off, the tail bits for hex
+  int hex;                      // 1 for 0x input, the base is then 2
+} float_scan_type;
+
+typedef struct float_decimal {
+  int count;      // significant digits, without trailing zeros
+  int point;      // the value is 0.digits * 10^point
+  int truncated;  // 1 if nonzero digits were dropped past the buffer
+  unsigned char digits[S21_DECIMAL_MAX_DIGITS + S21_FLOAT_MAX_DIGITS];
+} float_decimal_type;
+
+// __Scanning__
+int s21_float_scan(const char **str, int width, float_scan_type *scan);
+int s21_float_scan_digits(const char **str, int width, float_scan_type *scan,
+                          int *count, int *dropped);
+void s21_float_add_hex_digit(float_scan_type *scan, int digit, int *dropped);
+long long s21_float_scan_exponent(const char **str, int width,
+                                  char exponent_char, int *length);
+int s21_float_digit(int c, int hex);
+// __Conversion__
+long double s21_float_convert(const float_scan_type *scan,
+                              const float_format_type *format);
+int s21_eisel_lemire(long long q, unsigned long long w,
+                     const float_format_type *format,
+                     unsigned long long *mantissa, int *exponent);
+void s21_float_product(long long q, unsigned long long w, int precision,
+                       unsigned long long *high, unsigned long long *low);
+void s21_mul_64x64(unsigned long long a, unsigned long long b,
+                   unsigned long long *high, unsigned long long *low);
+int s21_float_round_binary(unsigned long long value, long long exponent,
+                           int tail, const float_format_type *format,
+                           unsigned long long *mantissa, int *binary_exponent);
+long double s21_float_compose(unsigned long long mantissa, int exponent,
+                              const float_format_type *format);
+// __Big decimal fallback__
+int s21_float_big_decimal(const float_scan_type *scan,
+                          const float_format_type *format,
+                          unsigned long long *mantissa, int *exponent);
+void s21_decimal_load(float_decimal_type *decimal,
+                      const float_scan_type *scan);
+void s21_decimal_left_shift(float_decimal_type *decimal, int shift);
+void s21_decimal_right_shift(float_decimal_type *decimal, int shift);
+void s21_decimal_trim(float_decimal_type *decimal);
+int s21_decimal_shift_for(int point);
+unsigned long long s21_decimal_rounded(const float_decimal_type *decimal,
+                                       int *carry);
+// __Integers__
+unsigned long long s21_integer_scan(const char **str, int width, int base,
+                                    unsigned long long limit, int *count,
+                                    int *overflow);
+
+/**
+ * @brief Checks whether the eight bytes of a word are all decimal digits.
+ *
+ * @param word Eight characters, the first in the lowest bits.
+ * @return 1 if every byte is '0' to '9', otherwise 0.
+ */
+S21_INLINE int s21_swar_is_eight_digits(unsigned long long word) {
+  return !(((word & 0xF0F0F0F0F0F0F0F0ULL) |
+            (((word + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ^
+           0x3333333333333333ULL);
+}
+/**
+ * @brief Combines eight digit values into one number with three
+ * multiplications.
+ *
+ * @param word Eight digit values below 'base', the first in the lowest bits.
+ * @param base 8, 10 or 16.
+ * @return The value of the eight digits, below base^8.
+ */
+S21_INLINE unsigned s21_swar_combine(unsigned long long word, unsigned base) {
+  word = (word * base + (word >> 8)) & 0x00FF00FF00FF00FFULL;
+  word = (word * (base * base) + (word >> 16)) & 0x0000FFFF0000FFFFULL;
+  return (unsigned)((word * (base * base * base * base) + (word >> 32)) &
+                    0xFFFFFFFFULL);
+}
+/**
+ * @brief Converts eight decimal digits to their value with three
+ * multiplications.
+ *
+ * @param word Eight digit characters, the first in the lowest bits.
+ * @return The value, 0 to 99999999.
+ */
+S21_INLINE unsigned s21_swar_eight_digits(unsigned long long word) {
+  return s21_swar_combine(word - 0x3030303030303030ULL, 10);
+}
+/**
+ * @brief Marks the bytes of a word that are in a range of ASCII characters.
+ *
+ * @param word Eight characters below 0x80.
+ * @param low The first character of the range.
+ * @param high The last character of the range.
+ * @return 0x80 in every byte in the range, 0 in the others.
+ */
+S21_INLINE unsigned long long s21_swar_in_range(unsigned long long word,
+                                                unsigned char low,
+                                                unsigned char high) {
+  unsigned long long ones = 0x0101010101010101ULL;
+  return (word + (0x80 - low) * ones) & ~(word + (0x7F - high) * ones) &
+         (0x80 * ones);
+}
+/**
+ * @brief Validates and converts eight digits of a base at once.
+ *
+ * @param word Eight characters, the first in the lowest bits.
+ * @param base 8, 10 or 16; hexadecimal letters may be in either case.
+ * @param value Pointer to the value of the eight digits, set on success.
+ * @return 1 if every byte is a digit of the base, otherwise 0.
+ */
+S21_INLINE int s21_swar_eight_values(unsigned long long word, unsigned base,
+                                     unsigned *value) {
+  unsigned long long high = 0x8080808080808080ULL;
+  unsigned long long digits =
+      s21_swar_in_range(word, '0', base < 10 ? '0' + base - 1 : '9');
+  unsigned long long letters =
+      base == 16 ? s21_swar_in_range(word | 0x2020202020202020ULL, 'a', 'f')
+                 : 0;
+  int valid = !(word & high) && (digits | letters) == high;
+  if (valid) {
+    *value = s21_swar_combine(
+        (word & 0x0F0F0F0F0F0F0F0FULL) + (letters >> 7) * 9, base);
+  }
+  return valid;
+}
+
+#endif  // SRC_S21_STRTOD_H_
@@ -0,0 +1,202 @@
+/**
+ * @file s21_utf8.c
+ * @brief Implementation of the UTF-8 conversions of wide characters.
+ *
+ * The encoder writes into a caller buffer and stops before the first character
+ * that does not fit into the byte budget or the buffer, so the caller can
+ * stream a string of any length through a small staging area. While both
+ * leave room for a whole block, S21_UTF8_BLOCK characters are checked for
+ * ASCII at once and narrowed with a plain loop the compiler vectorizes.
+ *
+ * Function Overview:
+ * - s21_utf8_encode, s21_utf8_encode_string: Encode.
+ * - s21_utf8_decode, s21_utf8_decode_string: Decode, rejecting overlong forms,
+ * surrogates and values above U+10FFFF.
+ * - s21_utf8_boundary: Keeps a byte count from splitting a character.
+ *
+ * @note A block is read only when it does not cross a page, so reading past
+ * the end of a string never touches an unmapped page.
+ */
+#include "s21_utf8.h"
+
+#include "s21_simd.h"
+
+/**
+ * @brief Encodes one code point.
+ *
+ * @param code The code point.
+ * @param out The buffer for the sequence, at least S21_UTF8_MAX bytes.
+ * @return The length of the sequence, 0 for a surrogate or a value above
+ * U+10FFFF, which have no UTF-8 form.
+ */
+int s21_utf8_encode(unsigned long code, char *out) {
+  int size = 0;
+  if (code < 0x80) {
+    out[0] = (char)code;
+    size = 1;
+  } else if (code < 0x800) {
+    out[0] = (char)(0xC0 | code >> 6);
+    out[1] = (char)(0x80 | (code & 0x3F));
+    size = 2;
+  } else if (code >= 0xD800 && code <= 0xDFFF) {
+    size = 0;
+  } else if (code < 0x10000) {
+    out[0] = (char)(0xE0 | code >> 12);
+    out[1] = (char)(0x80 | (code >> 6 & 0x3F));
+    out[2] = (char)(0x80 | (code & 0x3F));
+    size = 3;
+  } else if (code <= 0x10FFFF) {
+    out[0] = (char)(0xF0 | code >> 18);
+    out[1] = (char)(0x80 | (code >> 12 & 0x3F));
+    out[2] = (char)(0x80 | (code >> 6 & 0x3F));
+    out[3] = (char)(0x80 | (code & 0x3F));
+    size = 4;
+  }
+  return size;
+}
+/**
+ * @brief Encodes the whole characters of a wide string that fit into a byte
+ * budget and a buffer.
+ *
+ * @param wstr Pointer to the position in the wide string, moved past the
+ * encoded characters.
+ * @param budget Pointer to the bytes the string may still take, decreased by
+ * the bytes written.
+ * @param out The buffer for the encoded bytes.
+ * @param room Size of out, at least S21_UTF8_MAX to make progress.
+ * @param error Pointer set to 1 when a character has no UTF-8 form.
+ * @return The number of bytes written, 0 once the string, the budget or the
+ * valid characters are exhausted.
+ */
+s21_size_t s21_utf8_encode_string(const wchar_t **wstr, s21_size_t *budget,
+                                  char *out, s21_size_t room, int *error) {
+  const wchar_t *position = *wstr;
+  s21_size_t length = 0, limit = (room < *budget) ? room : *budget;
+  int done = 0;
+  while (!done) {
+    if (limit - length >= S21_UTF8_BLOCK && s21_utf8_ascii_block(position)) {
+      for (int i = 0; i < S21_UTF8_BLOCK; i++) {
+        out[length + i] = (char)position[i];
+      }
+      length += S21_UTF8_BLOCK;
+      position += S21_UTF8_BLOCK;
+    } else if (*position == L'\0') {
+      done = 1;
+    } else {
+      char sequence[S21_UTF8_MAX];
+      int size = s21_utf8_encode((unsigned long)*position, sequence);
+      if (size == 0) {
+        *error = 1;
+        done = 1;
+      } else if ((s21_size_t)size > limit - length) {
+        done = 1;
+      } else {
+        s21_memcpy(out + length, sequence, size);
+        length += size;
+        position++;
+      }
+    }
+  }
+  *wstr = position;
+  *budget -= length;
+  return length;
+}
+/**
+ * @brief Decodes the character at the start of a span.
+ *
+ * @param str Pointer to the span.
+ * @param len Length of the span, at least 1.
+ * @param code Pointer to the decoded code point, S21_UTF8_REPLACEMENT for a
+ * malformed or truncated sequence.
+ * @return The number of bytes consumed, 1 for a malformed sequence.
+ */
+s21_size_t s21_utf8_decode(const char *str, s21_size_t len,
+                           unsigned long *code) {
+  static const unsigned long lowest[S21_UTF8_MAX + 1] = {0, 0, 0x80, 0x800,
+                                                         0x10000};
+  const unsigned char *bytes = (const unsigned char *)str;
+  s21_size_t size = 1, need = 0;
+  unsigned long value = S21_UTF8_REPLACEMENT;
+  if (bytes[0] < 0x80) {
+    value = bytes[0];
+  } else if (bytes[0] >= 0xC2 && bytes[0] <= 0xF4) {
+    need = (bytes[0] >= 0xF0) ? 4 : (bytes[0] >= 0xE0) ? 3 : 2;
+  }
+  if (need && need <= len) {
+    unsigned long decoded = bytes[0] & (0x7F >> need);
+    s21_size_t count = 1;
+    while (count < need && (bytes[count] & 0xC0) == 0x80) {
+      decoded = decoded << 6 | (bytes[count++] & 0x3F);
+    }
+    if (count == need && decoded >= lowest[need] && decoded <= 0x10FFFF &&
+        (decoded < 0xD800 || decoded > 0xDFFF)) {
+      value = decoded;
+      size = need;
+    }
+  }
+  *code = value;
+  return size;
+}
+/**
+ * @brief Decodes a span into wide characters.
+ *
+ * @param out The buffer for the characters, at least len elements; nothing
+ * is appended after them.
+ * @param str Pointer to the span.
+ * @param len Length of the span.
+ * @return The number of characters written.
+ */
+s21_size_t s21_utf8_decode_string(wchar_t *out, const char *str,
+                                  s21_size_t len) {
+  s21_size_t count = 0, offset = 0;
+  while (offset < len) {
+    unsigned long code = 0;
+    offset += s21_utf8_decode(str + offset, len - offset, &code);
+    out[count++] = (wchar_t)code;
+  }
+  return count;
+}
+/**
+ * @brief Finds the longest prefix of a span that does not end inside a
+ * character.
+ *
+ * @param str Pointer to the span.
+ * @param len Length of the span.
+ * @return len, or the offset of a last character that is cut off.
+ */
+s21_size_t s21_utf8_boundary(const char *str, s21_size_t len) {
+  const unsigned char *bytes = (const unsigned char *)str;
+  s21_size_t start = len;
+  while (start > 0 && len - start < S21_UTF8_MAX &&
+         (bytes[start - 1] & 0xC0) == 0x80) {
+    start--;
+  }
+  if (start > 0 && bytes[start - 1] >= 0xC2 && bytes[start - 1] <= 0xF4) {
+    unsigned char lead = bytes[start - 1];
+    s21_size_t need = (lead >= 0xF0) ? 4 : (lead >= 0xE0) ? 3 : 2;
+    if (need > len - start + 1) len = start - 1;
+  }
+  return len;
+}
+// __Blocks__
+/**
+ * @brief Checks whether the next S21_UTF8_BLOCK wide characters are ASCII.
+ *
+ * @param wstr Pointer to the characters.
+ * @return 1 if the block is inside the page of 'wstr' and all its characters
+ * are from 1 to 0x7F, otherwise 0.
+ */
+S21_NO_ASAN int s21_utf8_ascii_block(const wchar_t *wstr) {
+  int ascii = 0;
+  if ((uintptr_t)wstr % S21_PAGE_SIZE <=
+      S21_PAGE_SIZE - S21_UTF8_BLOCK * sizeof(wchar_t)) {
+    unsigned long bits = 0;
+    int zero = 0;
+    for (int i = 0; i < S21_UTF8_BLOCK; i++) {
+      bits |= (unsigned long)wstr[i];
+      zero |= wstr[i] == L'\0';
+    }
+    ascii = bits < 0x80 && !zero;
+  }
+  return ascii;
+}
@@ -0,0 +1,45 @@
+/**
+ * @file s21_utf8.h
+ * @brief Header file defining the UTF-8 conversions of wide characters.
+ *
+ * The %lc and %ls conversions of s21_sprintf encode wchar_t values as UTF-8
+ * and the ones of s21_sscanf decode UTF-8 input into wchar_t values, whatever
+ * the locale. A string is encoded in one pass, whole characters at a time, so
+ * a byte budget such as the precision of %ls never cuts a character; runs of
+ * ASCII characters are narrowed a block at a time.
+ *
+ * Included functionalities:
+ * - s21_utf8_encode, s21_utf8_encode_string: One code point or a string to
+ * UTF-8.
+ * - s21_utf8_decode, s21_utf8_decode_string: UTF-8 to code points; malformed
+ * sequences decode to S21_UTF8_REPLACEMENT one byte at a time.
+ * - s21_utf8_boundary: The longest prefix of a span that ends on a character
+ * boundary.
+ *
+ * @note A wchar_t narrower than 32 bits keeps only the low bits of the code
+ * points above its range.
+ */
+#ifndef SRC_S21_UTF8_H_
+#define SRC_S21_UTF8_H_
+
+#include <wchar.h>
+
+#include "s21_string.h"
+
+#define S21_UTF8_MAX 4                 // bytes of the longest sequence
+#define S21_UTF8_BLOCK 8               // wide characters narrowed at once
+#define S21_UTF8_REPLACEMENT 0xFFFDUL  // U+FFFD, stored for malformed input
+
+int s21_utf8_encode(unsigned long code, char *out);
+s21_size_t s21_utf8_encode_string(const wchar_t **wstr, s21_size_t *budget,
+                                  char *out, s21_size_t room, int *error);
+s21_size_t s21_utf8_decode(const char *str, s21_size_t len,
+                           unsigned long *code);
+s21_size_t s21_utf8_decode_string(wchar_t *out, const char *str,
+                                  s21_size_t len);
+s21_size_t s21_utf8_boundary(const char *str, s21_size_t len);
+
+// __Blocks__
+int s21_utf8_ascii_block(const wchar_t *wstr);
+
+#endif  // SRC_S21_UTF8_H_
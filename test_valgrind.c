@@ -216,6 +216,12 @@ void test_sprintf() {
   printf("Result of sprintf: %s\n", buf);
 }
 
+void test_snprintf() {
+  char buf[8];
+  int n = s21_snprintf(buf, sizeof(buf), "%s-%d", "truncated", 42);
+  printf("Result of snprintf: %s (%d)\n", buf, n);
+}
+
 void test_sscanf() {
   const char str[] = "Hello 123 4.56";
   int a, b;
@@ -249,6 +255,7 @@ int main() {
   test_strspn();
   test_strcspn();
   test_sprintf();
+  test_snprintf();
   test_sscanf();
 
   return 0;